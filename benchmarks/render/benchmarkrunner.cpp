@@ -0,0 +1,201 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "benchmarkrunner.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QtMath>
+
+#if defined(Q_OS_WIN)
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+#include "canvas.h"
+#include "Private/document.h"
+#include "Private/Tasks/taskscheduler.h"
+#include "Sound/soundcomposition.h"
+
+namespace {
+
+qreal nsToMs(const qint64 ns) {
+    return ns/1000000.;
+}
+
+qreal hitRate(const int hits, const int total) {
+    return total > 0 ? qreal(hits)/total : 0;
+}
+
+}
+
+QJsonObject BenchmarkPassResult::toJson() const {
+    QJsonObject result;
+    result["frames"] = fFrames;
+    result["renderedFrames"] = fRenderedFrames;
+    result["fps"] = fTotalNs > 0 ? fFrames*1e9/fTotalNs : 0.;
+
+    QJsonObject phases;
+    phases["queMs"] = nsToMs(fQueNs);
+    phases["processMs"] = nsToMs(fProcessNs);
+    phases["totalMs"] = nsToMs(fTotalNs);
+    result["phases"] = phases;
+
+    QJsonObject frameTimes;
+    frameTimes["minMs"] = nsToMs(fMinFrameNs);
+    frameTimes["maxMs"] = nsToMs(fMaxFrameNs);
+    frameTimes["avgMs"] = fRenderedFrames > 0 ?
+                nsToMs(fRenderedNs)/fRenderedFrames : 0.;
+    result["renderedFrameTimes"] = frameTimes;
+
+    QJsonObject cache;
+    cache["sceneFrameHits"] = fCachedFrames;
+    cache["sceneFrameHitRate"] = hitRate(fCachedFrames, fFrames);
+    cache["soundSecondHits"] = fCachedSoundSeconds;
+    cache["soundSecondHitRate"] = hitRate(fCachedSoundSeconds, fSoundSeconds);
+    result["cache"] = cache;
+    return result;
+}
+
+BenchmarkRunner::BenchmarkRunner(Document& document,
+                                 const BenchmarkSceneSettings& settings,
+                                 const qreal resolution, const int passes,
+                                 const bool clearCacheBetweenPasses) :
+    mDocument(document), mSettings(settings),
+    mResolution(resolution), mPasses(passes),
+    mClearCache(clearCacheBetweenPasses) {}
+
+QJsonObject BenchmarkRunner::run(const BenchmarkScene& benchmark) {
+    QJsonObject result;
+    result["scene"] = benchmark.fName;
+    result["description"] = benchmark.fDescription;
+
+    QElapsedTimer timer;
+    timer.start();
+    const auto scene = mDocument.createNewScene();
+    scene->setCanvasSize(mSettings.fWidth, mSettings.fHeight);
+    scene->setFps(mSettings.fFps);
+    scene->setFrameRange({0, mSettings.fFrameCount - 1});
+    benchmark.fBuild(*scene, mSettings);
+    scene->setResolution(mResolution);
+    result["buildMs"] = nsToMs(timer.nsecsElapsed());
+
+    scene->setOutputRendering(true);
+    mDocument.addVisibleScene(scene);
+    waitForAllTasks();
+
+    QJsonArray passes;
+    for(int i = 0; i < mPasses; i++) {
+        if(mClearCache) {
+            scene->getSceneFramesHandler().clear();
+            scene->getSoundComposition()->getCacheHandler().clear();
+        }
+        const auto pass = renderPass(*scene);
+        passes.append(pass.toJson());
+    }
+    result["passes"] = passes;
+
+    timer.restart();
+    mDocument.removeVisibleScene(scene);
+    mDocument.removeScene(scene->ref<Canvas>());
+    result["teardownMs"] = nsToMs(timer.nsecsElapsed());
+    result["peakRssKB"] = sPeakRssKB();
+    return result;
+}
+
+BenchmarkPassResult BenchmarkRunner::renderPass(Canvas& scene) {
+    BenchmarkPassResult result;
+    const auto sound = scene.getSoundComposition();
+    const auto& frames = scene.getSceneFramesHandler();
+    const auto& seconds = sound->getCacheHandler();
+    const int minFrame = scene.getMinFrame();
+    const int maxFrame = scene.getMaxFrame();
+    const qreal fps = scene.getFps();
+    int lastSecond = qFloor(minFrame/fps) - 1;
+
+    scene.setMinFrameUseRange(minFrame);
+    sound->setMinFrameUseRange(minFrame);
+    for(int frame = minFrame; frame <= maxFrame; frame++) {
+        result.fFrames++;
+        const int second = qFloor(frame/fps);
+        if(second != lastSecond) {
+            result.fSoundSeconds++;
+            if(seconds.atFrame(second)) result.fCachedSoundSeconds++;
+            lastSecond = second;
+        }
+        const bool cached = frames.atFrame(frame);
+        if(cached) result.fCachedFrames++;
+        else result.fRenderedFrames++;
+
+        QElapsedTimer timer;
+        timer.start();
+        scene.setMaxFrameUseRange(frame);
+        sound->setMaxFrameUseRange(frame);
+        sound->scheduleFrameRange({frame, frame});
+        if(scene.getCurrentFrame() == frame) {
+            if(!cached) scene.planUpdate(UpdateReason::userChange);
+        } else scene.anim_setAbsFrame(frame);
+        mDocument.actionFinished();
+        const qint64 queNs = timer.nsecsElapsed();
+        waitForAllTasks();
+        const qint64 frameNs = timer.nsecsElapsed();
+
+        result.fQueNs += queNs;
+        result.fProcessNs += frameNs - queNs;
+        result.fTotalNs += frameNs;
+        if(cached) continue;
+        result.fRenderedNs += frameNs;
+        if(result.fRenderedFrames == 1) {
+            result.fMinFrameNs = frameNs;
+            result.fMaxFrameNs = frameNs;
+        } else {
+            result.fMinFrameNs = qMin(result.fMinFrameNs, frameNs);
+            result.fMaxFrameNs = qMax(result.fMaxFrameNs, frameNs);
+        }
+    }
+    scene.clearUseRange();
+    sound->clearUseRange();
+    return result;
+}
+
+void BenchmarkRunner::waitForAllTasks() {
+    if(TaskScheduler::sAllTasksFinished()) return;
+    QEventLoop loop;
+    TaskScheduler::sSetAllTasksFinishedFunc([&loop]() { loop.quit(); });
+    loop.exec();
+    TaskScheduler::sClearAllFinishedFuncs();
+}
+
+qint64 BenchmarkRunner::sPeakRssKB() {
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                             sizeof(counters))) return -1;
+    return static_cast<qint64>(counters.PeakWorkingSetSize/1024);
+#else
+    rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage)) return -1;
+    #if defined(Q_OS_MAC)
+        return usage.ru_maxrss/1024; // bytes on Mac OS X
+    #else
+        return usage.ru_maxrss;
+    #endif
+#endif
+}
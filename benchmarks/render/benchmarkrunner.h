@@ -0,0 +1,72 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include <QJsonObject>
+
+#include "benchmarkscenes.h"
+
+class Document;
+
+struct BenchmarkPassResult {
+    int fFrames = 0;
+    //! @brief Frames already available in the scene frame cache
+    int fCachedFrames = 0;
+    //! @brief Frames that were not in the cache and had to be rendered
+    int fRenderedFrames = 0;
+    int fSoundSeconds = 0;
+    int fCachedSoundSeconds = 0;
+
+    //! @brief Main thread time spent setting up and queuing tasks
+    qint64 fQueNs = 0;
+    //! @brief Time spent waiting for the queued tasks to finish
+    qint64 fProcessNs = 0;
+    qint64 fTotalNs = 0;
+    //! @brief Total time of the frames that were not in the cache
+    qint64 fRenderedNs = 0;
+    qint64 fMinFrameNs = 0;
+    qint64 fMaxFrameNs = 0;
+
+    QJsonObject toJson() const;
+};
+
+class BenchmarkRunner {
+public:
+    BenchmarkRunner(Document& document,
+                    const BenchmarkSceneSettings& settings,
+                    const qreal resolution, const int passes,
+                    const bool clearCacheBetweenPasses);
+
+    //! @brief Builds the scene, renders all passes and removes the scene
+    QJsonObject run(const BenchmarkScene& benchmark);
+
+    //! @brief Peak resident set size of the process, -1 if unavailable
+    static qint64 sPeakRssKB();
+private:
+    BenchmarkPassResult renderPass(Canvas& scene);
+    void waitForAllTasks();
+
+    Document& mDocument;
+    const BenchmarkSceneSettings mSettings;
+    const qreal mResolution;
+    const int mPasses;
+    const bool mClearCache;
+};
+
+#endif // BENCHMARKRUNNER_H
@@ -0,0 +1,301 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "benchmarkscenes.h"
+
+#include <QFile>
+#include <QDataStream>
+#include <QImage>
+#include <QPainter>
+#include <QtMath>
+
+#include "canvas.h"
+#include "Boxes/smartvectorpath.h"
+#include "Boxes/containerbox.h"
+#include "Boxes/textbox.h"
+#include "Boxes/paintbox.h"
+#include "Animators/transformanimator.h"
+#include "Animators/qrealkey.h"
+#include "Animators/SmartPath/smartpathcollection.h"
+#include "Animators/paintsettingsanimator.h"
+#include "Animators/outlinesettingsanimator.h"
+#include "RasterEffects/blureffect.h"
+#include "RasterEffects/shadoweffect.h"
+#include "RasterEffects/motionblureffect.h"
+#include "Paint/animatedsurface.h"
+#include "Sound/eindependentsound.h"
+#include "Sound/esoundsettings.h"
+#include "skia/skqtconversions.h"
+#include "exceptions.h"
+
+namespace {
+
+// Deterministic so that every run renders exactly the same scenes
+quint32 nextRandom(quint32& state) {
+    state = state*1664525u + 1013904223u;
+    return state >> 8;
+}
+
+qreal randomReal(quint32& state, const qreal min, const qreal max) {
+    const qreal t = (nextRandom(state) & 0xFFFF)/qreal(0xFFFF);
+    return min + t*(max - min);
+}
+
+QColor randomColor(quint32& state) {
+    return QColor::fromHsv(nextRandom(state) % 360, 160, 230);
+}
+
+SkPath starPath(const int nPoints, const qreal outer, const qreal inner) {
+    SkPath path;
+    const int nVerts = 2*nPoints;
+    for(int i = 0; i < nVerts; i++) {
+        const qreal radius = i % 2 ? inner : outer;
+        const qreal angle = 2*M_PI*i/nVerts;
+        const SkPoint pt = SkPoint::Make(toSkScalar(radius*qCos(angle)),
+                                         toSkScalar(radius*qSin(angle)));
+        if(i == 0) path.moveTo(pt);
+        else path.lineTo(pt);
+    }
+    path.close();
+    return path;
+}
+
+void animateValue(QrealAnimator * const anim,
+                  const qreal from, const qreal to,
+                  const int frameCount) {
+    anim->anim_appendKey(enve::make_shared<QrealKey>(from, 0, anim));
+    anim->anim_appendKey(enve::make_shared<QrealKey>(to, frameCount - 1, anim));
+}
+
+void animateRotation(BoundingBox * const box, const qreal degrees,
+                     const int frameCount) {
+    const auto rot = box->getBoxTransformAnimator()->getRotAnimator();
+    animateValue(rot, 0, degrees, frameCount);
+}
+
+qsptr<SmartVectorPath> createStar(quint32& seed, const qreal size) {
+    const auto path = enve::make_shared<SmartVectorPath>();
+    const int nPoints = 3 + nextRandom(seed) % 6;
+    path->getPathAnimator()->createNewPath(starPath(nPoints, size, size*0.45));
+    path->getFillSettings()->setPaintType(FLATPAINT);
+    path->getFillSettings()->setCurrentColor(randomColor(seed));
+    path->getStrokeSettings()->setPaintType(FLATPAINT);
+    path->getStrokeSettings()->setCurrentColor(Qt::black);
+    path->getStrokeSettings()->setCurrentStrokeWidth(2);
+    return path;
+}
+
+// Benchmarks run on the CPU only, switch effects that default to the GPU
+void addCpuRasterEffect(BoundingBox * const box,
+                        const qsptr<RasterEffect>& effect) {
+    if(effect->instanceHwSupport() == HardwareSupport::gpuOnly)
+        effect->switchInstanceHwSupport();
+    box->addRasterEffect(effect);
+}
+
+void buildPaths(Canvas& scene, const BenchmarkSceneSettings& settings) {
+    quint32 seed = 1;
+    const int count = 2500*settings.fComplexity;
+    for(int i = 0; i < count; i++) {
+        const auto path = createStar(seed, randomReal(seed, 8, 40));
+        path->getBoxTransformAnimator()->setPosition(
+                    randomReal(seed, 0, settings.fWidth),
+                    randomReal(seed, 0, settings.fHeight));
+        animateRotation(path.get(), randomReal(seed, -360, 360),
+                        settings.fFrameCount);
+        scene.addContained(path);
+    }
+}
+
+void buildNesting(Canvas& scene, const BenchmarkSceneSettings& settings) {
+    quint32 seed = 2;
+    const int depth = 64*settings.fComplexity;
+    ContainerBox* parent = &scene;
+    for(int i = 0; i < depth; i++) {
+        const auto group = enve::make_shared<ContainerBox>(eBoxType::group);
+        const auto transform = group->getBoxTransformAnimator();
+        if(i == 0) {
+            transform->setPosition(0.5*settings.fWidth, 0.5*settings.fHeight);
+        } else {
+            transform->setPosition(randomReal(seed, -4, 4),
+                                   randomReal(seed, -4, 4));
+            transform->setScale(0.99, 0.99);
+        }
+        animateRotation(group.get(), randomReal(seed, -15, 15),
+                        settings.fFrameCount);
+        for(int j = 0; j < 4; j++) {
+            const auto path = createStar(seed, randomReal(seed, 10, 30));
+            path->getBoxTransformAnimator()->setPosition(
+                        randomReal(seed, -400, 400),
+                        randomReal(seed, -300, 300));
+            group->addContained(path);
+        }
+        parent->addContained(group);
+        parent = group.get();
+    }
+}
+
+void buildEffects(Canvas& scene, const BenchmarkSceneSettings& settings) {
+    quint32 seed = 3;
+    const int count = 24*settings.fComplexity;
+    for(int i = 0; i < count; i++) {
+        const auto group = enve::make_shared<ContainerBox>(eBoxType::group);
+        group->getBoxTransformAnimator()->setPosition(
+                    randomReal(seed, 0, settings.fWidth),
+                    randomReal(seed, 0, settings.fHeight));
+        for(int j = 0; j < 8; j++) {
+            const auto path = createStar(seed, randomReal(seed, 20, 80));
+            path->getBoxTransformAnimator()->setPosition(
+                        randomReal(seed, -100, 100),
+                        randomReal(seed, -100, 100));
+            animateRotation(path.get(), randomReal(seed, -180, 180),
+                            settings.fFrameCount);
+            addCpuRasterEffect(path.get(), enve::make_shared<MotionBlurEffect>());
+            group->addContained(path);
+        }
+        addCpuRasterEffect(group.get(), enve::make_shared<BlurEffect>());
+        addCpuRasterEffect(group.get(), enve::make_shared<ShadowEffect>());
+        addCpuRasterEffect(group.get(), enve::make_shared<BlurEffect>());
+        scene.addContained(group);
+    }
+}
+
+void buildText(Canvas& scene, const BenchmarkSceneSettings& settings) {
+    quint32 seed = 4;
+    const QString paragraph =
+            "Lorem ipsum dolor sit amet, consectetur adipiscing elit,\n"
+            "sed do eiusmod tempor incididunt ut labore et dolore magna\n"
+            "aliqua. Ut enim ad minim veniam, quis nostrud exercitation\n"
+            "ullamco laboris nisi ut aliquip ex ea commodo consequat.";
+    const int count = 40*settings.fComplexity;
+    for(int i = 0; i < count; i++) {
+        const auto text = enve::make_shared<TextBox>();
+        text->setCurrentValue(paragraph);
+        text->setFontSize(randomReal(seed, 12, 36));
+        text->getFillSettings()->setCurrentColor(randomColor(seed));
+        const auto pos = text->getBoxTransformAnimator()->getPosAnimator();
+        const qreal x = randomReal(seed, 0, settings.fWidth);
+        const qreal y = randomReal(seed, 0, settings.fHeight);
+        animateValue(pos->getXAnimator(), x, x + randomReal(seed, -200, 200),
+                     settings.fFrameCount);
+        pos->getYAnimator()->setCurrentBaseValue(y);
+        scene.addContained(text);
+    }
+}
+
+QImage noiseImage(quint32& seed, const int width, const int height) {
+    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter p(&image);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(Qt::NoPen);
+    for(int i = 0; i < 400; i++) {
+        QColor color = randomColor(seed);
+        color.setAlpha(nextRandom(seed) % 200 + 55);
+        p.setBrush(color);
+        const qreal radius = randomReal(seed, 4, 64);
+        p.drawEllipse(QPointF(randomReal(seed, 0, width),
+                              randomReal(seed, 0, height)),
+                      radius, radius);
+    }
+    p.end();
+    return image;
+}
+
+void buildPaint(Canvas& scene, const BenchmarkSceneSettings& settings) {
+    quint32 seed = 5;
+    const int count = 8*settings.fComplexity;
+    for(int i = 0; i < count; i++) {
+        const auto paint = enve::make_shared<PaintBox>();
+        paint->getSurface()->loadPixmap(noiseImage(seed, 1024, 1024));
+        paint->getBoxTransformAnimator()->setPosition(
+                    randomReal(seed, -256, settings.fWidth - 768),
+                    randomReal(seed, -256, settings.fHeight - 768));
+        animateRotation(paint.get(), randomReal(seed, -30, 30),
+                        settings.fFrameCount);
+        animateValue(paint->getBoxTransformAnimator()->getOpacityAnimator(),
+                     100, 40, settings.fFrameCount);
+        scene.addContained(paint);
+    }
+}
+
+// 16-bit stereo PCM sine sweep long enough to cover the whole frame range
+QString writeToneFile(const QString& dir, const int id,
+                      const qreal seconds) {
+    const QString path = dir + "/tone" + QString::number(id) + ".wav";
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly)) return QString();
+    const int sampleRate = eSoundSettings::sSampleRate();
+    const int nChannels = 2;
+    const quint32 nSamples = static_cast<quint32>(qCeil(seconds*sampleRate));
+    const quint32 dataSize = nSamples*nChannels*sizeof(qint16);
+
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.writeRawData("RIFF", 4);
+    stream << quint32(36 + dataSize);
+    stream.writeRawData("WAVEfmt ", 8);
+    stream << quint32(16) << quint16(1) << quint16(nChannels)
+           << quint32(sampleRate)
+           << quint32(sampleRate*nChannels*sizeof(qint16))
+           << quint16(nChannels*sizeof(qint16)) << quint16(16);
+    stream.writeRawData("data", 4);
+    stream << dataSize;
+    const qreal freq = 220*(1 + id % 8);
+    for(quint32 i = 0; i < nSamples; i++) {
+        const qreal t = qreal(i)/sampleRate;
+        const qreal val = 0.2*qSin(2*M_PI*freq*t*(1 + 0.05*t));
+        const qint16 sample = static_cast<qint16>(val*32767);
+        for(int c = 0; c < nChannels; c++) stream << sample;
+    }
+    return path;
+}
+
+void buildSound(Canvas& scene, const BenchmarkSceneSettings& settings) {
+    quint32 seed = 6;
+    const qreal seconds = settings.fFrameCount/settings.fFps + 1;
+    const int count = 16*settings.fComplexity;
+    for(int i = 0; i < count; i++) {
+        const QString path = writeToneFile(settings.fAssetsDir, i, seconds);
+        if(path.isEmpty()) RuntimeThrow("Could not write sound asset");
+        const auto sound = enve::make_shared<eIndependentSound>();
+        sound->setFilePath(path);
+        scene.addContained(sound);
+    }
+    for(int i = 0; i < 200*settings.fComplexity; i++) {
+        const auto path = createStar(seed, randomReal(seed, 8, 40));
+        path->getBoxTransformAnimator()->setPosition(
+                    randomReal(seed, 0, settings.fWidth),
+                    randomReal(seed, 0, settings.fHeight));
+        animateRotation(path.get(), randomReal(seed, -90, 90),
+                        settings.fFrameCount);
+        scene.addContained(path);
+    }
+}
+
+}
+
+QList<BenchmarkScene> BenchmarkScenes::sAll() {
+    return {
+        {"paths", "Thousands of animated SmartVectorPaths", buildPaths},
+        {"nesting", "Deeply nested animated ContainerBoxes", buildNesting},
+        {"effects", "Blur, shadow and motion blur stacks", buildEffects},
+        {"text", "Moving TextBox paragraphs", buildText},
+        {"paint", "Large animated paint layers", buildPaint},
+        {"sound", "Sound layers mixed alongside vector paths", buildSound}
+    };
+}
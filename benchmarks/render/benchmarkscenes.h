@@ -0,0 +1,52 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef BENCHMARKSCENES_H
+#define BENCHMARKSCENES_H
+
+#include <functional>
+
+#include <QList>
+#include <QString>
+
+class Canvas;
+
+struct BenchmarkSceneSettings {
+    int fWidth = 1920;
+    int fHeight = 1080;
+    qreal fFps = 24;
+    int fFrameCount = 48;
+    //! @brief Multiplies the number of objects created by each scene
+    int fComplexity = 1;
+    //! @brief Folder for generated assets (e.g. sound files)
+    QString fAssetsDir;
+};
+
+struct BenchmarkScene {
+    using Builder = std::function<void(Canvas&, const BenchmarkSceneSettings&)>;
+
+    QString fName;
+    QString fDescription;
+    Builder fBuild;
+};
+
+namespace BenchmarkScenes {
+    //! @brief All reference scenes, in the order they are run by default
+    QList<BenchmarkScene> sAll();
+}
+
+#endif // BENCHMARKSCENES_H
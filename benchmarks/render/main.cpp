@@ -0,0 +1,203 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <iostream>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QDateTime>
+#include <QThread>
+
+#include "benchmarkrunner.h"
+#include "benchmarkscenes.h"
+
+#include "Private/esettings.h"
+#include "Private/document.h"
+#include "Private/Tasks/taskscheduler.h"
+#include "Sound/esoundsettings.h"
+#include "GUI/dialogsinterface.h"
+#include "actions.h"
+#include "exceptions.h"
+
+// Benchmarks run unattended, dialogs are never shown
+class BenchmarkDialogs : public DialogsInterface {
+public:
+    stdsptr<ShaderEffectCreator> execShaderChooser(
+            const QString&, const ShaderOptions&) const { return nullptr; }
+    void showExpressionDialog(QrealAnimator* const) const {}
+    void showApplyExpressionDialog(QrealAnimator* const) const {}
+    void showDurationSettingsDialog(DurationRectangle* const) const {}
+    bool execAnimationToPaint(const AnimationBox* const,
+                              int&, int&, int&) const { return false; }
+    void showSceneSettingsDialog(Canvas* const) const {}
+    void displayMessageToUser(const QString& message, const int) const {
+        std::cerr << message.toStdString() << std::endl;
+    }
+    void showStatusMessage(const QString&, const int) const {}
+};
+
+int main(int argc, char *argv[]) {
+    // Render without a display server unless explicitly requested otherwise
+    if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    QApplication::setApplicationName("enve render benchmarks");
+    setlocale(LC_NUMERIC, "C");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+                "Renders procedurally generated reference scenes offscreen "
+                "on the CPU and reports timings as JSON.");
+    parser.addHelpOption();
+    const QCommandLineOption sceneOpt(
+                {"s", "scene"}, "Run only the given scene (repeatable).",
+                "name");
+    const QCommandLineOption listOpt(
+                {"l", "list"}, "List available scenes and exit.");
+    const QCommandLineOption framesOpt(
+                {"f", "frames"}, "Number of frames to render.",
+                "count", "48");
+    const QCommandLineOption sizeOpt(
+                "size", "Scene size.", "WxH", "1920x1080");
+    const QCommandLineOption resolutionOpt(
+                {"r", "resolution"}, "Render resolution fraction.",
+                "fraction", "1");
+    const QCommandLineOption complexityOpt(
+                {"c", "complexity"}, "Object count multiplier.",
+                "factor", "1");
+    const QCommandLineOption passesOpt(
+                {"p", "passes"}, "Render passes over the frame range.",
+                "count", "2");
+    const QCommandLineOption noCacheOpt(
+                "no-cache", "Clear frame caches before every pass.");
+    const QCommandLineOption threadsOpt(
+                {"t", "threads"}, "CPU threads cap (0 - all available).",
+                "count", "0");
+    const QCommandLineOption outputOpt(
+                {"o", "output"}, "Write JSON to file instead of stdout.",
+                "file");
+    parser.addOptions({sceneOpt, listOpt, framesOpt, sizeOpt,
+                       resolutionOpt, complexityOpt, passesOpt,
+                       noCacheOpt, threadsOpt, outputOpt});
+    parser.process(app);
+
+    const auto allScenes = BenchmarkScenes::sAll();
+    if(parser.isSet(listOpt)) {
+        for(const auto& scene : allScenes) {
+            std::cout << scene.fName.toStdString() << "\t" <<
+                         scene.fDescription.toStdString() << std::endl;
+        }
+        return 0;
+    }
+
+    QTemporaryDir assetsDir;
+    if(!assetsDir.isValid()) {
+        std::cerr << "Could not create temporary folder" << std::endl;
+        return 1;
+    }
+
+    BenchmarkSceneSettings sceneSettings;
+    sceneSettings.fFrameCount = qMax(1, parser.value(framesOpt).toInt());
+    sceneSettings.fComplexity = qMax(1, parser.value(complexityOpt).toInt());
+    sceneSettings.fAssetsDir = assetsDir.path();
+    const QStringList size = parser.value(sizeOpt).split('x');
+    if(size.count() == 2) {
+        sceneSettings.fWidth = qMax(1, size.first().toInt());
+        sceneSettings.fHeight = qMax(1, size.last().toInt());
+    }
+    const qreal resolution = qBound(0.01, parser.value(resolutionOpt).toDouble(), 1.);
+    const int passes = qMax(1, parser.value(passesOpt).toInt());
+
+    QList<BenchmarkScene> scenes;
+    const QStringList sceneNames = parser.values(sceneOpt);
+    for(const auto& scene : allScenes) {
+        if(sceneNames.isEmpty() || sceneNames.contains(scene.fName))
+            scenes << scene;
+    }
+    if(scenes.isEmpty()) {
+        std::cerr << "No matching scenes, see --list" << std::endl;
+        return 1;
+    }
+
+    const int cpuThreads = QThread::idealThreadCount();
+    eSettings settings(cpuThreads, intKB(0), GpuVendor::unrecognized);
+    settings.fCpuThreadsCap = parser.value(threadsOpt).toInt();
+    settings.fAccPreference = AccPreference::cpuStrongPreference;
+    settings.fPathGpuAcc = false;
+    settings.fHddCache = false;
+
+    BenchmarkDialogs dialogs;
+    TaskScheduler taskScheduler;
+    taskScheduler.setAlwaysQue(true);
+    Document document(taskScheduler);
+    Actions actions(document);
+    eSoundSettings soundSettings;
+
+    BenchmarkRunner runner(document, sceneSettings, resolution,
+                           passes, parser.isSet(noCacheOpt));
+    QJsonArray results;
+    int failed = 0;
+    for(const auto& scene : scenes) {
+        std::cerr << "Running " << scene.fName.toStdString() << std::endl;
+        try {
+            results.append(runner.run(scene));
+        } catch(const std::exception& e) {
+            // gPrintException would block on a message box
+            std::cerr << gAllTextFromException(e).toStdString() << std::endl;
+            failed++;
+        }
+    }
+
+    QJsonObject config;
+    config["frames"] = sceneSettings.fFrameCount;
+    config["width"] = sceneSettings.fWidth;
+    config["height"] = sceneSettings.fHeight;
+    config["fps"] = sceneSettings.fFps;
+    config["resolution"] = resolution;
+    config["complexity"] = sceneSettings.fComplexity;
+    config["passes"] = passes;
+    config["clearCacheBetweenPasses"] = parser.isSet(noCacheOpt);
+    config["cpuThreads"] = eSettings::sCpuThreadsCapped();
+
+    QJsonObject root;
+    root["enveVersion"] = ENVE_VERSION;
+#ifdef LATEST_COMMIT_HASH
+    root["commit"] = LATEST_COMMIT_HASH;
+#endif
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["config"] = config;
+    root["scenes"] = results;
+    root["peakRssKB"] = BenchmarkRunner::sPeakRssKB();
+
+    const QByteArray json = QJsonDocument(root).toJson();
+    if(parser.isSet(outputOpt)) {
+        QFile file(parser.value(outputOpt));
+        if(!file.open(QIODevice::WriteOnly)) {
+            std::cerr << "Could not open " <<
+                         file.fileName().toStdString() << std::endl;
+            return 1;
+        }
+        file.write(json);
+    } else std::cout << json.constData();
+
+    return failed;
+}
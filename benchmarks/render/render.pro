@@ -0,0 +1,46 @@
+# enve - 2D animations software
+# Copyright (C) 2016-2020 Maurycy Liebner
+
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+QT += core gui widgets opengl multimedia qml xml svg
+LIBS += -lavutil -lavformat -lavcodec -lswscale -lswresample
+CONFIG += c++14 console
+CONFIG -= app_bundle
+DEFINES += QT_NO_FOREACH
+
+# Include third-party dependencies from core
+include(../../src/core/core.pri)
+
+ENVE_CORE_FOLDER = ../../src/core
+
+INCLUDEPATH += $$ENVE_CORE_FOLDER
+DEPENDPATH += $$ENVE_CORE_FOLDER
+LIBS += -L$$OUT_PWD/../../src/core -lenvecore
+
+win32 { # Windows
+    LIBS += -lpsapi
+}
+
+TARGET = enveRenderBenchmarks
+TEMPLATE = app
+
+SOURCES += \
+    benchmarkrunner.cpp \
+    benchmarkscenes.cpp \
+    main.cpp
+
+HEADERS += \
+    benchmarkrunner.h \
+    benchmarkscenes.h
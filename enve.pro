@@ -6,3 +6,8 @@ build_examples {
     SUBDIRS += examples
     examples.depends = src
 }
+
+build_benchmarks {
+    SUBDIRS += benchmarks
+    benchmarks.depends = src
+}
@@ -65,6 +65,8 @@ QPixmap* BoxSingleWidget::PROMOTE_TO_LAYER_PIXMAP;
 
 bool BoxSingleWidget::sStaticPixmapsLoaded = false;
 
+int BoxSingleWidget::sKeysCacheGeneration = 0;
+
 #include "GUI/global.h"
 #include "GUI/mainwindow.h"
 #include "clipboardcontainer.h"
@@ -383,6 +385,7 @@ void BoxSingleWidget::clearAndHideValueAnimators() {
 
 void BoxSingleWidget::setTargetAbstraction(SWT_Abstraction *abs) {
     mTargetConn.clear();
+    mKeysCache = QPixmap();
     SingleWidget::setTargetAbstraction(abs);
     if(!abs) return;
     const auto target = abs->getTarget();
@@ -392,6 +395,15 @@ void BoxSingleWidget::setTargetAbstraction(SWT_Abstraction *abs) {
                            this, qOverload<>(&QWidget::update));
     mTargetConn << connect(prop, &Property::prp_nameChanged,
                            this, qOverload<>(&QWidget::update));
+    const auto clearKeysCache = [this]() { mKeysCache = QPixmap(); };
+    mTargetConn << connect(prop, &Property::prp_absFrameRangeChanged,
+                           this, clearKeysCache);
+    if(const auto anim = enve_cast<Animator*>(prop)) {
+        mTargetConn << connect(anim, &Animator::anim_addedKey,
+                               this, clearKeysCache);
+        mTargetConn << connect(anim, &Animator::anim_removedKey,
+                               this, clearKeysCache);
+    }
 
     const auto boolProperty = enve_cast<BoolProperty*>(prop);
     const auto boolPropertyContainer = enve_cast<BoolPropertyContainer*>(prop);
@@ -680,10 +692,36 @@ void BoxSingleWidget::prp_drawTimelineControls(QPainter * const p,
                                const FrameRange &viewedFrames) {
     if(isHidden() || !mTarget) return;
     const auto target = mTarget->getTarget();
-    if(const auto asAnim = enve_cast<Animator*>(target)) {
-        asAnim->prp_drawTimelineControls(
+    const auto asAnim = enve_cast<Animator*>(target);
+    if(!asAnim) return;
+    if(!asAnim->prp_timelineControlsCachable()) {
+        mKeysCache = QPixmap();
+        return asAnim->prp_drawTimelineControls(
                     p, pixelsPerFrame, viewedFrames, eSizesUI::widget);
     }
+    const qreal dpr = devicePixelRatioF();
+    const bool cacheValid = !mKeysCache.isNull() &&
+            mKeysCacheGeneration == sKeysCacheGeneration &&
+            mKeysCacheRange == viewedFrames &&
+            qFuzzyCompare(mKeysCachePixelsPerFrame, pixelsPerFrame) &&
+            qFuzzyCompare(mKeysCache.devicePixelRatioF(), dpr);
+    if(!cacheValid) {
+        const int width = qCeil(viewedFrames.span()*pixelsPerFrame);
+        const QSize size(width, eSizesUI::widget);
+        mKeysCache = QPixmap(size*dpr);
+        mKeysCache.setDevicePixelRatio(dpr);
+        mKeysCache.fill(Qt::transparent);
+        QPainter cacheP(&mKeysCache);
+        cacheP.setRenderHint(QPainter::Antialiasing);
+        cacheP.setPen(Qt::NoPen);
+        asAnim->prp_drawTimelineControls(
+                    &cacheP, pixelsPerFrame, viewedFrames, eSizesUI::widget);
+        cacheP.end();
+        mKeysCacheGeneration = sKeysCacheGeneration;
+        mKeysCacheRange = viewedFrames;
+        mKeysCachePixelsPerFrame = pixelsPerFrame;
+    }
+    p->drawPixmap(0, 0, mKeysCache);
 }
 
 Key* BoxSingleWidget::getKeyAtPos(const int pressX,
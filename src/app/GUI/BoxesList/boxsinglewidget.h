@@ -72,6 +72,9 @@ public:
     void prp_drawTimelineControls(QPainter * const p,
                   const qreal pixelsPerFrame,
                   const FrameRange &viewedFrames);
+    //! @brief Invalidates key strips of all rows,
+    //! e.g. after key selection or hover changes
+    static void sClearKeysCaches() { sKeysCacheGeneration++; }
     Key *getKeyAtPos(const int pressX,
                      const qreal pixelsPerFrame,
                      const int minViewedFrame);
@@ -149,6 +152,14 @@ private:
     eComboBox *mFillTypeCombo;
 
     ConnContext mTargetConn;
+
+    static int sKeysCacheGeneration;
+    //! @brief Timeline key strip of this row,
+    //! repainted only when keys or the viewed range change
+    QPixmap mKeysCache;
+    int mKeysCacheGeneration = 0;
+    qreal mKeysCachePixelsPerFrame = 0;
+    FrameRange mKeysCacheRange;
 };
 
 #endif // BOXSINGLEWIDGET_H
@@ -0,0 +1,56 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "autosavesettingswidget.h"
+
+#include "Private/esettings.h"
+
+#include <QLabel>
+
+AutosaveSettingsWidget::AutosaveSettingsWidget(QWidget *parent) :
+    SettingsWidget(parent) {
+    mIntervalSpin = new QSpinBox(this);
+    mIntervalSpin->setRange(0, 999);
+    mIntervalSpin->setSuffix(" min");
+    mIntervalSpin->setSpecialValueText("Disabled");
+    add2HWidgets(new QLabel("Autosave every", this), mIntervalSpin);
+
+    mTargetCombo = new QComboBox(this);
+    using Target = eSettings::AutosaveTarget;
+    mTargetCombo->addItem("Autosaves folder",
+                          static_cast<int>(Target::dedicated_folder));
+    mTargetCombo->addItem("Project folder",
+                          static_cast<int>(Target::same_folder));
+    add2HWidgets(new QLabel("Save to", this), mTargetCombo);
+
+    mCapSpin = new QSpinBox(this);
+    mCapSpin->setRange(0, 999);
+    mCapSpin->setSpecialValueText("No limit");
+    add2HWidgets(new QLabel("Autosaves kept", this), mCapSpin);
+}
+
+void AutosaveSettingsWidget::applySettings() {
+    mSett.fAutoQuickSaveMin = mIntervalSpin->value();
+    mSett.fQuickSaveTarget = mTargetCombo->currentData().toInt();
+    mSett.fQuickSaveCap = mCapSpin->value();
+}
+
+void AutosaveSettingsWidget::updateSettings() {
+    mIntervalSpin->setValue(qMax(0, mSett.fAutoQuickSaveMin));
+    const int targetId = mTargetCombo->findData(mSett.fQuickSaveTarget);
+    mTargetCombo->setCurrentIndex(qMax(0, targetId));
+    mCapSpin->setValue(qMax(0, mSett.fQuickSaveCap));
+}
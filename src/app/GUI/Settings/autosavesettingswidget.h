@@ -0,0 +1,37 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AUTOSAVESETTINGSWIDGET_H
+#define AUTOSAVESETTINGSWIDGET_H
+
+#include "settingswidget.h"
+
+#include <QSpinBox>
+#include <QComboBox>
+
+class AutosaveSettingsWidget : public SettingsWidget {
+public:
+    explicit AutosaveSettingsWidget(QWidget *parent);
+
+    void applySettings();
+    void updateSettings();
+private:
+    QSpinBox* mIntervalSpin = nullptr;
+    QComboBox* mTargetCombo = nullptr;
+    QSpinBox* mCapSpin = nullptr;
+};
+
+#endif // AUTOSAVESETTINGSWIDGET_H
@@ -9,6 +9,7 @@
 #include "canvassettingswidget.h"
 #include "timelinesettingswidget.h"
 #include "externalappssettingswidget.h"
+#include "autosavesettingswidget.h"
 
 #include <QVBoxLayout>
 #include <QPushButton>
@@ -41,6 +42,9 @@ SettingsDialog::SettingsDialog(QWidget * const parent) :
     const auto timeline = new TimelineSettingsWidget(this);
     addSettingsWidget(timeline, "Timeline");
 
+    const auto autosave = new AutosaveSettingsWidget(this);
+    addSettingsWidget(autosave, "Autosave");
+
     const auto external = new ExternalAppsSettingsWidget(this);
     addSettingsWidget(external, "External Apps");
 
@@ -16,17 +16,56 @@
 
 #include "audiohandler.h"
 #include "Sound/soundcomposition.h"
+#include "Private/esettings.h"
 
 #include <iostream>
 
+qint64 AudioQueueDevice::bytesAvailable() const {
+    return mQueue.queuedBytes() + QIODevice::bytesAvailable();
+}
+
+qint64 AudioQueueDevice::readData(char *data, qint64 maxLen) {
+    const qint64 read = mQueue.read(data, maxLen);
+    // underrun, play silence rather than stalling the output
+    memset(data + read, 0, static_cast<size_t>(maxLen - read));
+    return maxLen;
+}
+
+qint64 AudioQueueDevice::writeData(const char *data, qint64 len) {
+    Q_UNUSED(data)
+    Q_UNUSED(len)
+    return 0;
+}
+
 AudioHandler* AudioHandler::sInstance = nullptr;
 
 AudioHandler::AudioHandler() {
     Q_ASSERT(!sInstance);
     sInstance = this;
+    mAudioThread.setObjectName("AudioOutputThread");
+    mAudioContext = new QObject;
+    mAudioContext->moveToThread(&mAudioThread);
+    mAudioThread.start(QThread::TimeCriticalPriority);
 }
 
-const int BufferSize = 32768;
+AudioHandler::~AudioHandler() {
+    if(mAudioOutput) {
+        runOnAudioThread([this]() {
+            mAudioOutput->stop();
+            delete mAudioOutput;
+            delete mQueueDevice;
+        });
+    }
+    mAudioThread.quit();
+    mAudioThread.wait();
+    delete mAudioContext;
+}
+
+template <typename F>
+void AudioHandler::runOnAudioThread(const F& func) const {
+    QMetaObject::invokeMethod(mAudioContext, func,
+                              Qt::BlockingQueuedConnection);
+}
 
 QAudioFormat::SampleType toQtAudioFormat(const AVSampleFormat avFormat) {
     if(avFormat == AV_SAMPLE_FMT_S32) {
@@ -47,9 +86,15 @@ AVSampleFormat toAVAudioFormat(const QAudioFormat::SampleType qFormat) {
 }
 
 void AudioHandler::initializeAudio(eSoundSettingsData& soundSettings) {
-    if(mAudioOutput) delete mAudioOutput;
-
-    mAudioBuffer = QByteArray(BufferSize, 0);
+    if(mAudioOutput) {
+        runOnAudioThread([this]() {
+            mAudioOutput->stop();
+            delete mAudioOutput;
+            delete mQueueDevice;
+        });
+        mAudioOutput = nullptr;
+        mQueueDevice = nullptr;
+    }
 
     mAudioDevice = QAudioDeviceInfo::defaultOutputDevice();
     mAudioFormat.setSampleRate(soundSettings.fSampleRate);
@@ -74,30 +119,66 @@ void AudioHandler::initializeAudio(eSoundSettingsData& soundSettings) {
         soundSettings.fSampleFormat = toAVAudioFormat(mAudioFormat.sampleType());
     }
 
-    mAudioOutput = new QAudioOutput(mAudioDevice, mAudioFormat, this);
-    mAudioOutput->setNotifyInterval(128);
+    const int bytesPerFrame = mAudioFormat.bytesPerFrame();
+    const int blockSize = qBound(256, eSettings::instance().fAudioBlockSize,
+                                 mAudioFormat.sampleRate());
+    // the device itself only holds two blocks, the queue covers gui stalls
+    mMaxQueuedBytes = 2*mAudioFormat.sampleRate()*bytesPerFrame;
+
+    mAudioOutput = new QAudioOutput(mAudioDevice, mAudioFormat);
+    mAudioOutput->setBufferSize(2*blockSize*bytesPerFrame);
+    mQueueDevice = new AudioQueueDevice(mQueue);
+    mAudioOutput->moveToThread(&mAudioThread);
+    mQueueDevice->moveToThread(&mAudioThread);
 }
 
 void AudioHandler::startAudio() {
-    mAudioIOOutput = mAudioOutput->start();
+    if(!mAudioOutput || mActive) return;
+    mActive = true;
+    runOnAudioThread([this]() {
+        mQueueDevice->open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+        mAudioOutput->start(mQueueDevice);
+    });
 }
 
 void AudioHandler::pauseAudio() {
-    mAudioOutput->suspend();
+    if(!mAudioOutput) return;
+    runOnAudioThread([this]() { mAudioOutput->suspend(); });
 }
 
 void AudioHandler::resumeAudio() {
-    mAudioOutput->resume();
+    if(!mAudioOutput) return;
+    runOnAudioThread([this]() { mAudioOutput->resume(); });
 }
 
 void AudioHandler::stopAudio() {
-    //mAudioOutput->suspend();
-    //mCurrentSoundComposition->stop();
-    mAudioIOOutput = nullptr;
-    mAudioOutput->stop();
-    mAudioOutput->reset();
+    if(!mAudioOutput || !mActive) return;
+    mActive = false;
+    runOnAudioThread([this]() {
+        mAudioOutput->stop();
+        mAudioOutput->reset();
+        mQueueDevice->close();
+    });
+    mQueue.clear();
 }
 
 void AudioHandler::setVolume(const int value) {
-    if(mAudioOutput) mAudioOutput->setVolume(qreal(value)/100);
+    if(!mAudioOutput) return;
+    const qreal volume = qreal(value)/100;
+    runOnAudioThread([this, volume]() { mAudioOutput->setVolume(volume); });
+}
+
+void AudioHandler::pushData(SoundComposition * const source) {
+    if(!mActive || !source) return;
+    AudioChunk chunk;
+    while(true) {
+        const qint64 space = mMaxQueuedBytes - mQueue.queuedBytes();
+        if(space <= 0 || mQueue.full()) break;
+        if(!source->nextChunk(space, chunk)) break;
+        mQueue.push(chunk);
+    }
+}
+
+void AudioHandler::discardQueued() {
+    mQueue.clear();
 }
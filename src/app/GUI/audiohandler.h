@@ -18,38 +18,35 @@
 #define AUDIOHANDLER_H
 
 #include <QAudioOutput>
+#include <QThread>
 #include <QDebug>
 
+#include "Sound/audiochunkqueue.h"
+
 struct eSoundSettingsData;
+class SoundComposition;
+
+//! @brief Pull device copying queued chunks on the audio thread,
+//! pads underruns with silence to keep the output running.
+class AudioQueueDevice : public QIODevice {
+public:
+    AudioQueueDevice(AudioChunkQueue& queue) : mQueue(queue) {}
+
+    qint64 bytesAvailable() const;
+protected:
+    qint64 readData(char *data, qint64 maxLen);
+    qint64 writeData(const char *data, qint64 len);
+private:
+    AudioChunkQueue& mQueue;
+};
 
 class AudioHandler : public QObject {
 public:
     AudioHandler();
+    ~AudioHandler();
 
     static AudioHandler* sInstance;
 
-    struct DataRequest {
-        char* fData;
-        int fSize;
-
-        operator bool() const {
-            return fSize > 0;
-        }
-    };
-
-    DataRequest dataRequest() {
-        if(mAudioOutput && mAudioOutput->state() != QAudio::StoppedState) {
-            if(mAudioOutput->bytesFree() >= mAudioOutput->periodSize())
-                return {mAudioBuffer.data(), mAudioOutput->periodSize()};
-        }
-        return {nullptr, 0};
-    }
-
-    void provideData(const DataRequest& request) {
-        if(!request || !mAudioIOOutput) return;
-        mAudioIOOutput->write(request.fData, request.fSize);
-    }
-
     void initializeAudio(eSoundSettingsData &soundSettings);
     void startAudio();
     void pauseAudio();
@@ -57,14 +54,27 @@ public:
     void stopAudio();
     void setVolume(const int value);
 
-    QAudioOutput* audioOutput() const { return mAudioOutput; }
+    bool isActive() const { return mActive; }
+    //! @brief Queues merged samples from the source up to about two
+    //! seconds ahead of playback, call from the GUI thread
+    void pushData(SoundComposition * const source);
+    //! @brief Drops audio queued but not yet played, used when seeking
+    void discardQueued();
 private:
+    template <typename F>
+    void runOnAudioThread(const F& func) const;
+
+    QThread mAudioThread;
+    //! @brief Lives on the audio thread, context for queued calls
+    QObject *mAudioContext = nullptr;
     QAudioDeviceInfo mAudioDevice;
     QAudioOutput *mAudioOutput = nullptr;
-    QIODevice *mAudioIOOutput = nullptr; // not owned
+    AudioQueueDevice *mQueueDevice = nullptr;
     QAudioFormat mAudioFormat;
 
-    QByteArray mAudioBuffer;
+    AudioChunkQueue mQueue;
+    qint64 mMaxQueuedBytes = 0;
+    bool mActive = false;
 };
 
 #endif // AUDIOHANDLER_H
@@ -279,6 +279,7 @@ void KeysView::mousePressEvent(QMouseEvent *e) {
                     mSelectionRect.setBottomRight(xFramePos);
                 } else {
                     mLastPressedMovable->pressed(shiftPressed);
+                    BoxSingleWidget::sClearKeysCaches();
                     mMovingRect = true;
                 }
             } else {
@@ -574,12 +575,17 @@ void KeysView::updateHovered(const QPoint &posU) {
         if(mGHoveredPoint) mGHoveredPoint->setHovered(true);
         return;
     }
-    if(mHoveredKey) mHoveredKey->setHovered(false);
-    mHoveredKey = getKeyAtPos(posU.x(), posU.y(),
-                              mPixelsPerFrame,
-                              mMinViewedFrame);
-    if(mHoveredKey) {
-        mHoveredKey->setHovered(true);
+    const auto hoveredKey = getKeyAtPos(posU.x(), posU.y(),
+                                        mPixelsPerFrame,
+                                        mMinViewedFrame);
+    if(hoveredKey) {
+        if(hoveredKey != mHoveredKey) {
+            clearHoveredKey();
+            mHoveredKey = hoveredKey;
+            mHoveredKey->setHovered(true);
+            // hover is drawn in the cached key strips
+            BoxSingleWidget::sClearKeysCaches();
+        }
         clearHoveredMovable();
     } else {
         const auto lastMovable = mHoveredMovable;
@@ -588,6 +594,7 @@ void KeysView::updateHovered(const QPoint &posU) {
                             mPixelsPerFrame,
                             mMinViewedFrame);
         if(lastMovable != mHoveredMovable) {
+            BoxSingleWidget::sClearKeysCaches();
             if(lastMovable) lastMovable->setHovered(false);
             if(mHoveredMovable) {
                 mHoveredMovable->setHovered(true);
@@ -609,12 +616,14 @@ void KeysView::clearHoveredKey() {
     if(!mHoveredKey) return;
     mHoveredKey->setHovered(false);
     mHoveredKey = nullptr;
+    BoxSingleWidget::sClearKeysCaches();
 }
 
 void KeysView::clearHoveredMovable() {
     if(!mHoveredMovable) return;
     mHoveredMovable->setHovered(false);
     mHoveredMovable = nullptr;
+    BoxSingleWidget::sClearKeysCaches();
     setCursor(Qt::ArrowCursor);
 }
 
@@ -760,6 +769,7 @@ void KeysView::handleMouseMove(const QPoint &pos,
                     const bool shiftPressed = QApplication::keyboardModifiers() & Qt::SHIFT;
                     if(!mLastPressedMovable->isSelected()) {
                         mLastPressedMovable->selectionChangeTriggered(shiftPressed);
+                        BoxSingleWidget::sClearKeysCaches();
                     }
                     const auto childProp = mLastPressedMovable->getParentProperty();
                     mMoveAllSelected = true;
@@ -874,6 +884,7 @@ void KeysView::mouseReleaseEvent(QMouseEvent *e) {
                 if(mFirstMove) {
                     if(mLastPressedMovable) {
                         mLastPressedMovable->selectionChangeTriggered(shiftPressed);
+                        BoxSingleWidget::sClearKeysCaches();
                     }
                 } else {
                     const auto childProp = mLastPressedMovable->getParentProperty();
@@ -950,6 +961,7 @@ void KeysView::updatePixelsPerFrame() {
 
 void KeysView::addKeyToSelection(Key * const key) {
     if(!key) return;
+    BoxSingleWidget::sClearKeysCaches();
     QList<Animator*> toSelect;
     key->addToSelection(toSelect);
     for(const auto& anim : toSelect) {
@@ -961,6 +973,7 @@ void KeysView::addKeyToSelection(Key * const key) {
 }
 
 void KeysView::removeKeyFromSelection(Key * const key) {
+    BoxSingleWidget::sClearKeysCaches();
     QList<Animator*> toRemove;
     key->removeFromSelection(toRemove);
     for(const auto& anim : toRemove) {
@@ -970,6 +983,8 @@ void KeysView::removeKeyFromSelection(Key * const key) {
 }
 
 void KeysView::clearKeySelection() {
+    if(mSelectedKeysAnimators.isEmpty()) return;
+    BoxSingleWidget::sClearKeysCaches();
     for(const auto& anim : mSelectedKeysAnimators) {
         anim->anim_deselectAllKeys();
     }
@@ -64,6 +64,7 @@
 #include "closesignalingdockwidget.h"
 #include "eimporters.h"
 #include "ColorWidgets/paintcolorwidget.h"
+#include "autosavehandler.h"
 #include "Dialogs/exportsvgdialog.h"
 #include "alignwidget.h"
 
@@ -98,6 +99,11 @@ MainWindow::MainWindow(Document& document,
             this, [this]() {
         setFileChangedSinceSaving(true);
     });
+    mAutosaveHandler = new AutosaveHandler(mDocument, [this](
+            QIODevice * const dst, eWriteDeferred* const deferred) {
+        // relative paths stay relative to the document, not the autosave
+        writeEV(dst, mDocument.fEvFile, deferred);
+    }, this);
     connect(&mDocument, &Document::activeSceneSet,
             this, &MainWindow::updateSettingsForCurrentCanvas);
     connect(&mDocument, &Document::currentBoxChanged,
@@ -1411,6 +1417,7 @@ void MainWindow::saveFile(const QString& path, const bool setPath) {
         } else RuntimeThrow("Unrecognized file extension " + suffix);
         if(setPath) mDocument.setPath(path);
         setFileChangedSinceSaving(false);
+        mAutosaveHandler->documentSaved();
     } catch(const std::exception& e) {
         gPrintExceptionCritical(e);
     }
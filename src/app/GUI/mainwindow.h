@@ -47,6 +47,8 @@ class TimelineDockWidget;
 class BrushSelectionWidget;
 class CanvasWindow;
 class MemoryHandler;
+class AutosaveHandler;
+class eWriteDeferred;
 
 class ObjectSettingsWidget;
 class BoxScrollWidget;
@@ -75,6 +77,8 @@ public:
 
     FillStrokeSettingsWidget *getFillStrokeSettings();
     void saveToFile(const QString &path);
+    void writeEV(QIODevice * const dst, const QString &path,
+                 eWriteDeferred* const deferred = nullptr);
     void saveToFileXEV(const QString& path);
     void loadEVFile(const QString &path);
     void loadXevFile(const QString &path);
@@ -334,6 +338,7 @@ private:
     PaintColorWidget* mPaintColorWidget;
 
     bool mChangedSinceSaving = false;
+    AutosaveHandler* mAutosaveHandler = nullptr;
     bool mEventFilterDisabled = true;
     bool isEnabled();
     QWidget *mGrayOutWidget = nullptr;
@@ -21,6 +21,7 @@
 #include "Private/Tasks/complextask.h"
 #include "conncontextptr.h"
 #include "memoryhandler.h"
+#include "Private/esettings.h"
 
 #include <QTimer>
 #include <QLocale>
@@ -147,6 +148,9 @@ UsageWidget::UsageWidget(QWidget * const parent) : QStatusBar(parent) {
 
     mRamLabel = new QLabel(this);
 
+    mDiskCacheLabel = new QLabel(this);
+    mDiskCacheLabel->setToolTip("Size of frames swapped to the disk cache");
+
     const auto clearRamButton = new QPushButton("clear memory", this);
     connect(clearRamButton, &QPushButton::clicked,
             this, []() {
@@ -168,6 +172,8 @@ UsageWidget::UsageWidget(QWidget * const parent) : QStatusBar(parent) {
 
     addPermanentWidget(mRamLabel);
 
+    addPermanentWidget(mDiskCacheLabel);
+
     addPermanentWidget(clearRamButton);
 
     setThreadsTotal(QThread::idealThreadCount());
@@ -209,6 +215,13 @@ void UsageWidget::setTotalRam(const qreal totalRamMB) {
     mRamBar->setRange(0, qRound(totalRamMB));
 }
 
+void UsageWidget::setDiskCacheUsage(const qreal usedMB) {
+    const int capMB = eSettings::instance().fHddCacheMBCap.fValue;
+    QString text = "  disk: " + QString::number(qRound(usedMB));
+    if(capMB > 0) text += "/" + QString::number(capMB);
+    mDiskCacheLabel->setText(text + " MB ");
+}
+
 void UsageWidget::addComplexTask(ComplexTask * const task) {
     for(const auto wid : qAsConst(mTaskWidgets)) {
         if(wid->isHidden()) {
@@ -34,6 +34,7 @@ public:
     void setGpuUsage(const bool used);
     void setRamUsage(const qreal thisMB);
     void setTotalRam(const qreal totalRamMB);
+    void setDiskCacheUsage(const qreal usedMB);
 
     void addComplexTask(ComplexTask* const task);
 private:
@@ -42,6 +43,7 @@ private:
     HardwareUsageWidget* mHddBar;
     HardwareUsageWidget* mRamBar;
     QLabel* mRamLabel;
+    QLabel* mDiskCacheLabel;
     QList<ComplexTaskWidget*> mTaskWidgets;
 };
 
@@ -74,6 +74,7 @@ SOURCES += main.cpp\
     GUI/RenderWidgets/outputsettingsdialog.cpp \
     GUI/RenderWidgets/rendersettingsdialog.cpp \
     GUI/RenderWidgets/rendersettingsdisplaywidget.cpp \
+    GUI/Settings/autosavesettingswidget.cpp \
     GUI/Settings/canvassettingswidget.cpp \
     GUI/Settings/externalappssettingswidget.cpp \
     GUI/Settings/interfacesettingswidget.cpp \
@@ -141,6 +142,7 @@ SOURCES += main.cpp\
     GUI/BoxesList/boolpropertywidget.cpp \
     memorychecker.cpp \
     memoryhandler.cpp \
+    autosavehandler.cpp \
     GUI/RenderWidgets/renderwidget.cpp \
     GUI/RenderWidgets/renderinstancewidget.cpp \
     renderinstancesettings.cpp \
@@ -203,6 +205,7 @@ HEADERS  += \
     GUI/RenderWidgets/outputsettingsdialog.h \
     GUI/RenderWidgets/rendersettingsdialog.h \
     GUI/RenderWidgets/rendersettingsdisplaywidget.h \
+    GUI/Settings/autosavesettingswidget.h \
     GUI/Settings/canvassettingswidget.h \
     GUI/Settings/externalappssettingswidget.h \
     GUI/Settings/interfacesettingswidget.h \
@@ -269,6 +272,7 @@ HEADERS  += \
     GUI/BoxesList/boolpropertywidget.h \
     memorychecker.h \
     memoryhandler.h \
+    autosavehandler.h \
     GUI/RenderWidgets/renderwidget.h \
     GUI/RenderWidgets/renderinstancewidget.h \
     renderinstancesettings.h \
@@ -0,0 +1,176 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "autosavehandler.h"
+#include "Private/document.h"
+#include "Private/esettings.h"
+#include "Tasks/updatable.h"
+#include "ReadWrite/ewritestream.h"
+#include "GUI/dialogsinterface.h"
+
+#include <QApplication>
+#include <QBuffer>
+#include <QDir>
+#include <QFileInfo>
+#include <QPointer>
+
+#define AUTOSAVE_PATTERN "%1.autosave%2.ev"
+
+class AutosaveWriter : public eHddTask {
+    e_OBJECT
+protected:
+    using Func = std::function<void(const bool success,
+                                    const std::exception_ptr& error)>;
+    AutosaveWriter(const QString& folder, const QString& baseName,
+                   const QByteArray& data, const eWriteDeferred& deferred,
+                   const int cap, const Func& finishedFunc) :
+        mFolder(folder), mBaseName(baseName), mData(data),
+        mDeferred(deferred), mCap(cap), mFinishedFunc(finishedFunc) {}
+
+    void process() {
+        mData = mDeferred.finish(mData);
+        mDeferred = eWriteDeferred();
+        if(!QDir().mkpath(mFolder))
+            RuntimeThrow("Could not create autosave folder " + mFolder + ".");
+        const QDir dir(mFolder);
+        const QString partPath = dir.filePath(mBaseName + ".autosave.part");
+        QFile file(partPath);
+        if(!file.open(QIODevice::WriteOnly))
+            RuntimeThrow("Could not open file for writing " + partPath + ".");
+        const bool written = file.write(mData) == mData.size();
+        file.close();
+        mData.clear();
+        if(!written) {
+            file.remove();
+            RuntimeThrow("Error while writing to file " + partPath);
+        }
+        // the newest copy is 1, older copies are shifted up
+        int count = 0;
+        while(QFile::exists(copyPath(dir, count + 1))) count++;
+        if(mCap > 0) {
+            for(int i = count; i >= mCap; i--) QFile::remove(copyPath(dir, i));
+            count = qMin(count, mCap - 1);
+        }
+        for(int i = count; i >= 1; i--) {
+            QFile::rename(copyPath(dir, i), copyPath(dir, i + 1));
+        }
+        if(!QFile::rename(partPath, copyPath(dir, 1))) {
+            QFile::remove(partPath);
+            RuntimeThrow("Could not replace autosave file " + copyPath(dir, 1));
+        }
+    }
+
+    void afterProcessing() { mFinishedFunc(true, nullptr); }
+    void afterCanceled() { mFinishedFunc(false, nullptr); }
+
+    bool handleException() {
+        mFinishedFunc(false, takeException());
+        return true;
+    }
+private:
+    QString copyPath(const QDir& dir, const int id) const {
+        return dir.filePath(QString(AUTOSAVE_PATTERN).arg(mBaseName).arg(id));
+    }
+
+    const QString mFolder;
+    const QString mBaseName;
+    QByteArray mData;
+    eWriteDeferred mDeferred;
+    const int mCap;
+    const Func mFinishedFunc;
+};
+
+AutosaveHandler::AutosaveHandler(Document& document, const Writer& writer,
+                                 QObject * const parent) :
+    QObject(parent), mDocument(document), mWriter(writer),
+    mTimer(new QTimer(this)) {
+    connect(mTimer, &QTimer::timeout, this, &AutosaveHandler::autosave);
+    connect(&mDocument, &Document::documentChanged,
+            this, [this]() { mChanged = true; });
+    connect(eSettings::sInstance, &eSettings::settingsChanged,
+            this, &AutosaveHandler::updateInterval);
+    updateInterval();
+}
+
+void AutosaveHandler::updateInterval() {
+    const int min = eSettings::instance().fAutoQuickSaveMin;
+    if(min <= 0) return mTimer->stop();
+    const int msec = min*60000;
+    if(mTimer->isActive() && mTimer->interval() == msec) return;
+    mTimer->start(msec);
+}
+
+void AutosaveHandler::target(QString& folder, QString& baseName) const {
+    const auto& settings = eSettings::instance();
+    const QString& evFile = mDocument.fEvFile;
+    baseName = evFile.isEmpty() ? "untitled" :
+                                  QFileInfo(evFile).completeBaseName();
+    const bool sameFolder = settings.quickSaveTarget() ==
+            eSettings::AutosaveTarget::same_folder;
+    if(sameFolder && !evFile.isEmpty()) {
+        folder = QFileInfo(evFile).absolutePath();
+    } else folder = settings.fUserSettingsDir + "/Autosaves";
+}
+
+void AutosaveHandler::autosave() {
+    if(!mChanged || mSaving) return;
+    if(mDocument.fScenes.isEmpty()) return;
+    // scenes are not in a consistent state mid-interaction,
+    // the next timeout retries
+    if(QApplication::mouseButtons() != Qt::NoButton) return;
+
+    QString folder;
+    QString baseName;
+    target(folder, baseName);
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    eWriteDeferred deferred;
+    try {
+        mWriter(&buffer, &deferred);
+    } catch(...) {
+        reportFailure(std::current_exception());
+        return;
+    }
+    buffer.close();
+
+    mChanged = false;
+    mSaving = true;
+    const QPointer<AutosaveHandler> ptr = this;
+    const auto finished = [ptr](const bool success,
+                                const std::exception_ptr& error) {
+        if(!ptr) return;
+        ptr->mSaving = false;
+        if(success) ptr->mFailed = false;
+        else ptr->mChanged = true;
+        if(error) ptr->reportFailure(error);
+    };
+    const int cap = eSettings::instance().fQuickSaveCap;
+    const auto task = enve::make_shared<AutosaveWriter>(
+                          folder, baseName, data, deferred, cap, finished);
+    task->queTask();
+}
+
+void AutosaveHandler::reportFailure(const std::exception_ptr& error) {
+    // an unreachable target fails on every interval,
+    // only the first failure since the last success gets a dialog
+    if(mFailed) {
+        const auto& dialogs = DialogsInterface::instance();
+        dialogs.showStatusMessage("Autosave failed");
+    } else gPrintExceptionCritical(error);
+    mFailed = true;
+}
@@ -0,0 +1,54 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AUTOSAVEHANDLER_H
+#define AUTOSAVEHANDLER_H
+#include <QObject>
+#include <QTimer>
+#include <functional>
+#include <exception>
+
+class Document;
+class eWriteDeferred;
+
+//! @brief Periodically saves a copy of the document when it has changed.
+//! The main thread only takes an uncompressed snapshot, compressing,
+//! writing and rotating the copies is done by an HDD task.
+class AutosaveHandler : public QObject {
+    Q_OBJECT
+public:
+    using Writer = std::function<void(QIODevice* const dst,
+                                      eWriteDeferred* const deferred)>;
+    AutosaveHandler(Document& document, const Writer& writer,
+                    QObject * const parent = nullptr);
+
+    //! @brief Changes saved manually do not need another copy
+    void documentSaved() { mChanged = false; }
+private:
+    void updateInterval();
+    void autosave();
+    void target(QString& folder, QString& baseName) const;
+    void reportFailure(const std::exception_ptr& error);
+
+    Document& mDocument;
+    const Writer mWriter;
+    QTimer* const mTimer;
+    bool mChanged = false;
+    bool mSaving = false;
+    bool mFailed = false;
+};
+
+#endif // AUTOSAVEHANDLER_H
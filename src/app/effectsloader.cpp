@@ -26,6 +26,7 @@
 EffectsLoader::EffectsLoader() {}
 
 EffectsLoader::~EffectsLoader() {
+    if(!mGpuInitialized) return;
     makeCurrent();
     glDeleteBuffers(1, &GL_PLAIN_SQUARE_VBO);
     glDeleteVertexArrays(1, &mPlainSquareVAO);
@@ -80,6 +81,7 @@ void EffectsLoader::initializeGpu() {
     std::cout << "iniColorPrograms" << std::endl;
 
     doneCurrent();
+    mGpuInitialized = true;
     std::cout << "Done OffscreenQGL33c current" << std::endl;
 }
 
@@ -220,18 +222,27 @@ void EffectsLoader::iniCustomRasterEffects() {
 void EffectsLoader::reloadProgram(ShaderEffectCreator* const loaded,
                                   const QString &fragPath) {
     try {
-        makeCurrent();
-        loaded->reloadProgram(this, fragPath);
+        loaded->reloadProgram(makeCurrentIfGpu(), fragPath);
         emit programChanged(&*loaded->fProgram);
-        doneCurrent();
+        doneCurrentIfGpu();
     } catch(const std::exception& e) {
-        doneCurrent();
+        doneCurrentIfGpu();
         gPrintExceptionCritical(e);
     }
 }
 
-void EffectsLoader::iniShaderEffects() {
+QGL33* EffectsLoader::makeCurrentIfGpu() {
+    if(!mGpuInitialized) return nullptr;
     makeCurrent();
+    return this;
+}
+
+void EffectsLoader::doneCurrentIfGpu() {
+    if(mGpuInitialized) doneCurrent();
+}
+
+void EffectsLoader::iniShaderEffects() {
+    makeCurrentIfGpu();
     QDir(eSettings::sSettingsDir()).mkdir("ShaderEffects");
     const QString dirPath = eSettings::sSettingsDir() + "/ShaderEffects";
     QDirIterator dirIt(dirPath, QDirIterator::NoIteratorFlags);
@@ -281,16 +292,16 @@ void EffectsLoader::iniShaderEffects() {
             }
         });
     });
-    doneCurrent();
+    doneCurrentIfGpu();
 }
 
 void EffectsLoader::iniSingleRasterEffectProgram(const QString& grePath) {
     try {
-        makeCurrent();
+        makeCurrentIfGpu();
         iniShaderEffectProgramExec(grePath);
-        doneCurrent();
+        doneCurrentIfGpu();
     } catch(const std::exception& e) {
-        doneCurrent();
+        doneCurrentIfGpu();
         gPrintExceptionCritical(e);
     }
 }
@@ -302,7 +313,8 @@ void EffectsLoader::iniShaderEffectProgramExec(const QString& grePath) {
             fileInfo.completeBaseName() + ".frag";
     if(!QFile(fragPath).exists()) return;
     try {
-        const auto loaded = ShaderEffectCreator::sLoadFromFile(this, grePath).get();
+        const auto gl = mGpuInitialized ? this : nullptr;
+        const auto loaded = ShaderEffectCreator::sLoadFromFile(gl, grePath).get();
         mLoadedGREPaths << grePath;
 
         const auto newFileWatcher = QSharedPointer<QFileSystemWatcher>(
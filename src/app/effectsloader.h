@@ -35,6 +35,11 @@ public:
 signals:
     void programChanged(ShaderEffectProgram*);
 private:
+    //! @brief Shader effects fall back to their cpu programs
+    //! if the gpu could not be initialized
+    QGL33* makeCurrentIfGpu();
+    void doneCurrentIfGpu();
+
     void reloadProgram(ShaderEffectCreator * const loaded,
                        const QString& fragPath);
     void iniSingleRasterEffectProgram(const QString &grePath);
@@ -43,6 +48,7 @@ private:
     void iniCustomRasterEffect(const QString &soPath);
     void iniIfCustomRasterEffect(const QString &path);
 
+    bool mGpuInitialized = false;
     QStringList mLoadedGREPaths;
     GLuint mPlainSquareVAO;
     GLuint mTexturedSquareVAO;
@@ -21,6 +21,8 @@
 #include "svgimporter.h"
 #include "Ora/oraimporter.h"
 
+#include <QProgressDialog>
+
 qsptr<BoundingBox> eXevImporter::import(const QFileInfo &fileInfo, Canvas * const scene) const {
     Q_UNUSED(scene);
     MainWindow::sGetInstance()->loadXevFile(fileInfo.absoluteFilePath());
@@ -37,8 +39,16 @@ qsptr<BoundingBox> eSvgImporter::import(const QFileInfo &fileInfo, Canvas * cons
     const auto gradientCreator = [scene]() {
         return scene->createNewGradient();
     };
+    QProgressDialog dialog("Importing " + fileInfo.fileName() + "...",
+                           "Cancel", 0, 100, MainWindow::sGetInstance());
+    dialog.setWindowModality(Qt::WindowModal);
+    dialog.setMinimumDuration(500);
+    const auto progress = [&dialog](const qreal value) {
+        dialog.setValue(qRound(100*value));
+        return !dialog.wasCanceled();
+    };
     return ImportSVG::loadSVGFile(fileInfo.absoluteFilePath(),
-                                  gradientCreator);
+                                  gradientCreator, progress);
 }
 
 qsptr<BoundingBox> eOraImporter::import(const QFileInfo &fileInfo, Canvas * const scene) const {
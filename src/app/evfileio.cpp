@@ -110,8 +110,22 @@ void MainWindow::saveToFile(const QString &path) {
 
     if(!file.open(QIODevice::WriteOnly))
         RuntimeThrow("Could not open file for writing " + path + ".");
-    eWriteStream writeStream(&file);
+    try {
+        writeEV(&file, path);
+    } catch(...) {
+        file.close();
+        RuntimeThrow("Error while writing to file " + path);
+    }
+    file.close();
+
+    addRecentFile(path);
+}
+
+void MainWindow::writeEV(QIODevice * const dst, const QString &path,
+                         eWriteDeferred* const deferred) {
+    eWriteStream writeStream(dst);
     writeStream.setPath(path);
+    writeStream.setDeferred(deferred);
     try {
         writeStream.writeCheckpoint();
         const auto& scenes = mDocument.fScenes;
@@ -130,13 +144,10 @@ void MainWindow::saveToFile(const QString &path) {
         writeStream.writeFutureTable();
         FileFooter::sWrite(writeStream);
     } catch(...) {
-        file.close();
-        RuntimeThrow("Error while writing to file " + path);
+        BoundingBox::sClearWriteBoxes();
+        throw;
     }
-    file.close();
-
     BoundingBox::sClearWriteBoxes();
-    addRecentFile(path);
 }
 
 #include "XML/xevzipfilesaver.h"
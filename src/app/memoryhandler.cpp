@@ -19,6 +19,7 @@
 #include "GUI/mainwindow.h"
 #include <QMetaType>
 #include "GUI/usagewidget.h"
+#include "smartPointers/epool.h"
 
 #ifdef Q_OS_MAC
 #include <malloc/malloc.h>
@@ -61,7 +62,10 @@ MemoryHandler::~MemoryHandler() {
 }
 
 void MemoryHandler::clearMemory() {
+    // an explicit clear drops everything, compressed copies included
+    mDataHandler.setCompressEvicted(false);
     freeMemory(NORMAL_MEMORY_STATE, longB(std::numeric_limits<qint64>::max()));
+    mDataHandler.setCompressEvicted(true);
 }
 
 MemoryState MemoryHandler::sMemoryState() {
@@ -90,10 +94,15 @@ void MemoryHandler::freeMemory(const MemoryState newState,
 
     if(minFreeBytes.fValue <= 0) return;
     qint64 memToFree = minFreeBytes.fValue;
+    const bool compress = mDataHandler.compressEvicted();
+    // compressing takes time and memory we do not have now
+    if(newState == CRITICAL_MEMORY_STATE) mDataHandler.setCompressEvicted(false);
     while(memToFree > 0 && !mDataHandler.isEmpty()) {
         const auto cont = mDataHandler.takeFirst();
         memToFree -= cont->free_RAM_k();
     }
+    mDataHandler.setCompressEvicted(compress);
+    if(memToFree > 0) memToFree -= ePool::sTrim();
     if(newState == CRITICAL_MEMORY_STATE ||
        memToFree > 0) {
         mMemoryState = CRITICAL_MEMORY_STATE;
@@ -110,4 +119,6 @@ void MemoryHandler::memoryChecked(const intKB memKb, const intKB totMemKb) {
     if(!usageWidget) return;
     usageWidget->setTotalRam(totMemKb.fValue/qreal(1024));
     usageWidget->setRamUsage((totMemKb - memKb).fValue/qreal(1024));
+    const qreal diskMB = mDiskCacheHandler.usedBytes()/qreal(1024*1024);
+    usageWidget->setDiskCacheUsage(diskMB);
 }
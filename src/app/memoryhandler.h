@@ -19,6 +19,8 @@
 #include <QThread>
 #include "memorychecker.h"
 #include "memorydatahandler.h"
+#include "diskcachehandler.h"
+#include "CacheHandlers/persistentframecache.h"
 
 class MemoryHandler : public QObject {
     Q_OBJECT
@@ -41,6 +43,8 @@ private:
     void memoryChecked(const intKB memKb, const intKB totMemKb);
 
     MemoryDataHandler mDataHandler;
+    DiskCacheHandler mDiskCacheHandler;
+    PersistentFrameCache mPersistentFrameCache;
     MemoryState mMemoryState = NORMAL_MEMORY_STATE;
     QTimer *mTimer;
     QThread *mMemoryChekerThread;
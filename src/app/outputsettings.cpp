@@ -99,6 +99,13 @@ uint64_t OutputSettings::sGetChannelsLayout(const QString &name) {
     return AV_CH_LAYOUT_STEREO;
 }
 
+bool OutputSettings::highBitDepthVideo() const {
+    if(!fVideoEnabled) return false;
+    const auto desc = av_pix_fmt_desc_get(fVideoPixelFormat);
+    if(!desc) return false;
+    return desc->comp[0].depth > 8;
+}
+
 void OutputSettings::write(eWriteStream &dst) const {
     dst << (fOutputFormat ? QString(fOutputFormat->name) : "");
 
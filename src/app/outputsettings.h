@@ -29,6 +29,7 @@ extern "C" {
     #include <libavutil/channel_layout.h>
     #include <libavutil/mathematics.h>
     #include <libavutil/opt.h>
+    #include <libavutil/pixdesc.h>
 }
 
 struct OutputSettings {
@@ -39,6 +40,9 @@ struct OutputSettings {
     void write(eWriteStream& dst) const;
     void read(eReadStream& src);
 
+    //! @brief Video pixel format stores more than 8 bits per component
+    bool highBitDepthVideo() const;
+
     const AVOutputFormat *fOutputFormat = nullptr;
 
     bool fVideoEnabled = false;
@@ -23,6 +23,7 @@
 #include "CacheHandlers/soundcachecontainer.h"
 #include "CacheHandlers/sceneframecontainer.h"
 #include "Private/document.h"
+#include "Private/esettings.h"
 
 RenderHandler* RenderHandler::sInstance = nullptr;
 
@@ -43,11 +44,20 @@ RenderHandler::RenderHandler(Document &document,
     mPreviewFPSTimer->setTimerType(Qt::PreciseTimer);
     connect(mPreviewFPSTimer, &QTimer::timeout,
             this, &RenderHandler::nextPreviewFrame);
-    connect(mPreviewFPSTimer, &QTimer::timeout,
-            this, &RenderHandler::audioPushTimerExpired);
-    connect(audioHandler.audioOutput(), &QAudioOutput::notify,
+
+    mAudioFillTimer = new QTimer(this);
+    mAudioFillTimer->setTimerType(Qt::PreciseTimer);
+    mAudioFillTimer->setInterval(10);
+    connect(mAudioFillTimer, &QTimer::timeout,
             this, &RenderHandler::audioPushTimerExpired);
 
+    mScrubStopTimer = new QTimer(this);
+    mScrubStopTimer->setSingleShot(true);
+    connect(mScrubStopTimer, &QTimer::timeout,
+            this, &RenderHandler::stopScrubAudio);
+    connect(&document, &Document::activeSceneFrameSet,
+            this, &RenderHandler::scrubAudio);
+
     const auto vidEmitter = videoEncoder.getEmitter();
 //    connect(vidEmitter, &VideoEncoderEmitter::encodingStarted,
 //            this, &SceneWindow::leaveOnlyInterruptionButtonsEnabled);
@@ -97,7 +107,10 @@ void RenderHandler::renderFromSettings(RenderInstanceSettings * const settings)
                                                       mCurrentRenderFrame});
         mCurrentScene->anim_setAbsFrame(mCurrentRenderFrame);
         mCurrentScene->setOutputRendering(true);
+        const auto& outputSettings = settings->getOutputRenderSettings();
+        mCurrentScene->setHighBitDepth(outputSettings.highBitDepthVideo());
         TaskScheduler::instance()->setAlwaysQue(true);
+        TaskScheduler::instance()->setPlayheadFrame(mCurrentRenderFrame);
         //fitSceneToSize();
         if(!isZero6Dec(mSavedResolutionFraction - resolutionFraction)) {
             mCurrentScene->setResolution(resolutionFraction);
@@ -138,6 +151,12 @@ void RenderHandler::nextCurrentRenderFrame() {
 
     mCurrentRenderFrame = newCurrentRenderFrame;
     mCurrRenderRange.fMax = mCurrentRenderFrame;
+    // frames before the first missing one are done,
+    // the scheduler orders the ques from the frame needed next
+    const int neededFrame = cacheHandler.firstEmptyFrameAtOrAfter(
+                mCurrRenderRange.fMin);
+    TaskScheduler::instance()->setPlayheadFrame(
+                qMin(neededFrame, mCurrentRenderFrame));
     if(allDone) Document::sInstance->actionFinished();
     else setFrameAction(mCurrentRenderFrame);
 }
@@ -178,6 +197,7 @@ void RenderHandler::renderPreview() {
     mCurrentSoundComposition->setMinFrameUseRange(mCurrentRenderFrame);
 
     setPreviewState(PreviewSate::rendering);
+    TaskScheduler::instance()->setPlayheadFrame(mCurrentRenderFrame);
 
     emit previewBeingRendered();
 
@@ -214,7 +234,10 @@ void RenderHandler::interruptPreviewRendering() {
 }
 
 void RenderHandler::interruptOutputRendering() {
-    if(mCurrentScene) mCurrentScene->setOutputRendering(false);
+    if(mCurrentScene) {
+        mCurrentScene->setOutputRendering(false);
+        mCurrentScene->setHighBitDepth(false);
+    }
     TaskScheduler::instance()->setAlwaysQue(false);
     TaskScheduler::sClearAllFinishedFuncs();
     stopPreview();
@@ -238,6 +261,7 @@ void RenderHandler::stopPreview() {
 void RenderHandler::pausePreview() {
     if(mPreviewing) {
         mAudioHandler.pauseAudio();
+        mAudioFillTimer->stop();
         mPreviewFPSTimer->stop();
         emit previewPaused();
         setPreviewState(PreviewSate::paused);
@@ -247,6 +271,7 @@ void RenderHandler::pausePreview() {
 void RenderHandler::resumePreview() {
     if(mPreviewing) {
         mAudioHandler.resumeAudio();
+        mAudioFillTimer->start();
         mPreviewFPSTimer->start();
         emit previewBeingPlayed();
         setPreviewState(PreviewSate::playing);
@@ -324,6 +349,7 @@ void RenderHandler::finishEncoding() {
     TaskScheduler::sClearAllFinishedFuncs();
     mCurrentRenderSettings = nullptr;
     mCurrentScene->setOutputRendering(false);
+    mCurrentScene->setHighBitDepth(false);
     TaskScheduler::instance()->setAlwaysQue(false);
     setFrameAction(mSavedCurrentFrame);
     if(!isZero4Dec(mSavedResolutionFraction - mCurrentScene->getResolution())) {
@@ -346,10 +372,10 @@ void RenderHandler::nextSaveOutputFrame() {
             const int minSample = qRound(mMinRenderFrame*sampleRate/fps);
             const int max = samples->fSampleRange.fMax;
             VideoEncoder::sAddCacheContainerToEncoder(
-                        samples->mid({minSample, max}));
+                        samples->slice({minSample, max}));
         } else {
-            VideoEncoder::sAddCacheContainerToEncoder(
-                        enve::make_shared<Samples>(samples));
+            // cached samples are never modified, share them
+            VideoEncoder::sAddCacheContainerToEncoder(samples);
         }
         mCurrentEncodeSoundSecond++;
     }
@@ -386,24 +412,55 @@ void RenderHandler::nextSaveOutputFrame() {
 }
 
 void RenderHandler::startAudio() {
+    stopScrubAudio();
     mAudioHandler.startAudio();
     if(mCurrentSoundComposition)
         mCurrentSoundComposition->start(mCurrentPreviewFrame);
     audioPushTimerExpired();
+    mAudioFillTimer->start();
 }
 
 void RenderHandler::stopAudio() {
+    mAudioFillTimer->stop();
     mAudioHandler.stopAudio();
     if(mCurrentSoundComposition) mCurrentSoundComposition->stop();
 }
 
 void RenderHandler::audioPushTimerExpired() {
-    if(!mCurrentSoundComposition) return;
-    while(auto request = mAudioHandler.dataRequest()) {
-        const qint64 len = mCurrentSoundComposition->read(
-                    request.fData, request.fSize);
-        if(len <= 0) break;
-        request.fSize = int(len);
-        mAudioHandler.provideData(request);
+    if(mScrubComposition) {
+        mAudioHandler.pushData(mScrubComposition);
+    } else if(mCurrentSoundComposition) {
+        mAudioHandler.pushData(mCurrentSoundComposition);
     }
 }
+
+void RenderHandler::scrubAudio(const int frame) {
+    if(mPreviewSate != PreviewSate::stopped) return;
+    if(mCurrentRenderSettings) return;
+    if(!eSettings::instance().fScrubAudio) return;
+    const auto scene = mDocument.fActiveScene;
+    if(!scene) return;
+    const auto composition = scene->getSoundComposition();
+    if(!composition->hasAnySounds()) return;
+    if(mScrubComposition && mScrubComposition != composition)
+        stopScrubAudio();
+    mScrubComposition = composition;
+    const int nFrames = 2;
+    composition->startScrub(frame, nFrames);
+    mAudioHandler.discardQueued();
+    mAudioHandler.startAudio();
+    audioPushTimerExpired();
+    mAudioFillTimer->start();
+    const int mSecs = qCeil(nFrames*1000/scene->getFps());
+    // let the queued slice drain before stopping the output
+    mScrubStopTimer->start(mSecs + 100);
+}
+
+void RenderHandler::stopScrubAudio() {
+    mScrubStopTimer->stop();
+    if(!mScrubComposition) return;
+    mAudioFillTimer->stop();
+    mAudioHandler.stopAudio();
+    mScrubComposition->stop();
+    mScrubComposition = nullptr;
+}
@@ -83,6 +83,9 @@ private:
     void startAudio();
     void audioPushTimerExpired();
     void stopAudio();
+    //! @brief Plays a short slice of the scene sound at the frame
+    void scrubAudio(const int frame);
+    void stopScrubAudio();
 
     Document& mDocument;
 
@@ -96,6 +99,10 @@ private:
 
     Canvas* mCurrentScene = nullptr;
     QTimer *mPreviewFPSTimer = nullptr;
+    //! @brief Keeps the audio ring buffer filled while sound plays
+    QTimer *mAudioFillTimer = nullptr;
+    QTimer *mScrubStopTimer = nullptr;
+    qptr<SoundComposition> mScrubComposition;
     RenderInstanceSettings *mCurrentRenderSettings = nullptr;
 
     int mCurrentPreviewFrame;
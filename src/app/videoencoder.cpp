@@ -20,6 +20,8 @@
 #include "CacheHandlers/sceneframecontainer.h"
 #include "canvas.h"
 
+#include "include/private/SkHalf.h"
+
 #define AV_RuntimeThrow(errId, message) \
 { \
     char * const errMsg = new char[AV_ERROR_MAX_STRING_SIZE]; \
@@ -140,6 +142,23 @@ static void addVideoStream(OutputStream * const ost,
     }
 }
 
+//! @brief Converts premultiplied half float pixels
+//! to 16 bit unsigned components, one pixel per vector
+static void halfToRgba64(const SkPixmap& src, AVFrame * const dst) {
+    const int width = qMin(src.width(), dst->width);
+    const int height = qMin(src.height(), dst->height);
+    for(int y = 0; y < height; y++) {
+        const auto srcLine = static_cast<const uint64_t*>(src.addr(0, y));
+        const auto dstLine = reinterpret_cast<uint16_t*>(
+                    dst->data[0] + y*dst->linesize[0]);
+        for(int x = 0; x < width; x++) {
+            const Sk4f rgba = SkHalfToFloat_finite_ftz(srcLine[x]);
+            const Sk4f clamped = Sk4f::Min(Sk4f::Max(rgba, 0.f), 1.f);
+            SkNx_cast<uint16_t>(clamped*65535.f + 0.5f).store(dstLine + 4*x);
+        }
+    }
+}
+
 static AVFrame *getVideoFrame(OutputStream * const ost,
                               const sk_sp<SkImage> &image) {
     AVCodecContext *c = ost->fCodec;
@@ -149,23 +168,37 @@ static AVFrame *getVideoFrame(OutputStream * const ost,
 //                      STREAM_DURATION, (AVRational) { 1, 1 }) >= 0)
 //        return nullptr;
 
+    SkPixmap pixmap;
+    if(!image->peekPixels(&pixmap))
+        RuntimeThrow("Could not peek frame pixels");
+    // half float frames are rendered for pixel formats above 8 bits
+    const bool wide = pixmap.colorType() == kRGBA_F16_SkColorType;
+    const auto srcFormat = wide ? AV_PIX_FMT_RGBA64 : AV_PIX_FMT_RGBA;
+
     /* as we only generate a rgba picture, we must convert it
      * to the codec pixel format if needed */
-    if(!ost->fSwsCtx) {
-        ost->fSwsCtx = sws_getContext(c->width, c->height,
-                                      AV_PIX_FMT_RGBA,
-                                      c->width, c->height,
-                                      c->pix_fmt, SWS_BICUBIC,
-                                      nullptr, nullptr, nullptr);
-        if(!ost->fSwsCtx)
-            RuntimeThrow("Cannot initialize the conversion context");
+    ost->fSwsCtx = sws_getCachedContext(ost->fSwsCtx,
+                                        c->width, c->height, srcFormat,
+                                        c->width, c->height,
+                                        c->pix_fmt, SWS_BICUBIC,
+                                        nullptr, nullptr, nullptr);
+    if(!ost->fSwsCtx)
+        RuntimeThrow("Cannot initialize the conversion context");
+
+    const uint8_t * dstSk[4] = {nullptr};
+    int linesizesSk[4] = {0};
+    if(wide) {
+        if(!ost->fWideFrame) {
+            ost->fWideFrame = allocPicture(AV_PIX_FMT_RGBA64,
+                                           c->width, c->height);
+        }
+        halfToRgba64(pixmap, ost->fWideFrame);
+        dstSk[0] = ost->fWideFrame->data[0];
+        linesizesSk[0] = ost->fWideFrame->linesize[0];
+    } else {
+        dstSk[0] = static_cast<const uint8_t*>(pixmap.addr());
+        av_image_fill_linesizes(linesizesSk, AV_PIX_FMT_RGBA, image->width());
     }
-    SkPixmap pixmap;
-    image->peekPixels(&pixmap);
-    const uint8_t * const dstSk[] = {static_cast<uint8_t*>(pixmap.writable_addr())};
-    int linesizesSk[4];
-
-    av_image_fill_linesizes(linesizesSk, AV_PIX_FMT_RGBA, image->width());
     const int ret = av_frame_make_writable(ost->fDstFrame) ;
     if(ret < 0) AV_RuntimeThrow(ret, "Could not make AVFrame writable")
 
@@ -375,8 +408,15 @@ static void processAudioStream(AVFormatContext * const oc,
                                OutputStream * const ost,
                                SoundIterator &iterator,
                                bool * const audioEnabled) {
-    iterator.fillFrame(ost->fSrcFrame);
-    bool gotOutput = ost->fSrcFrame;
+    // whole frame within one cached buffer, encode it in place
+    AVFrame * refFrame = iterator.refFrame(ost->fSrcFrame->nb_samples);
+    AVFrame * const frame = refFrame ? refFrame : ost->fSrcFrame;
+    if(!refFrame) {
+        const int ret = av_frame_make_writable(ost->fSrcFrame);
+        if(ret < 0) AV_RuntimeThrow(ret, "Could not make AVFrame writable")
+        iterator.fillFrame(ost->fSrcFrame);
+    }
+    bool gotOutput = frame;
 
 //    const int nb_samples =
 //            swr_convert(ost->fSwrCtx,
@@ -388,14 +428,16 @@ static void processAudioStream(AVFormatContext * const oc,
 
 //    ost->fNextPts += ost->fDstFrame->nb_samples;
 
-    ost->fSrcFrame->pts = ost->fNextPts;
-    ost->fNextPts += ost->fSrcFrame->nb_samples;
+    frame->pts = ost->fNextPts;
+    ost->fNextPts += frame->nb_samples;
 
     try {
-        encodeAudioFrame(oc, ost, ost->fSrcFrame, &gotOutput);
+        encodeAudioFrame(oc, ost, frame, &gotOutput);
     } catch(...) {
+        if(refFrame) av_frame_free(&refFrame);
         RuntimeThrow("Error while encoding audio frame");
     }
+    if(refFrame) av_frame_free(&refFrame);
 
     *audioEnabled = gotOutput;
 }
@@ -554,6 +596,7 @@ static void closeStream(OutputStream * const ost) {
     }
     if(ost->fDstFrame) av_frame_free(&ost->fDstFrame);
     if(ost->fSrcFrame) av_frame_free(&ost->fSrcFrame);
+    if(ost->fWideFrame) av_frame_free(&ost->fWideFrame);
     if(ost->fSwsCtx) sws_freeContext(ost->fSwsCtx);
     if(ost->fSwrCtx) swr_free(&ost->fSwrCtx);
     *ost = OutputStream();
@@ -86,8 +86,8 @@ public:
         } else {
             while(remaining > 0) {
                 const int cpySamples = qMin(remaining,
-                                            mEndSample - mCurrentSample + 1)*nChannels;
-                const uint cpyBytes = static_cast<uint>(cpySamples*sampleSize);
+                                            mEndSample - mCurrentSample + 1);
+                const uint cpyBytes = static_cast<uint>(cpySamples*sampleSize*nChannels);
                 memcpy(frame->data[0] + frameSample*sampleSize*nChannels,
                         mCurrentData[0] + mCurrentSample*sampleSize*nChannels, cpyBytes);
 
@@ -104,6 +104,49 @@ public:
         }
     }
 
+    //! @brief Frame pointing straight into the current samples, keeps
+    //! a reference to them until the encoder releases the frame.
+    //! Returns nullptr if nSamples are not contiguous in one buffer.
+    AVFrame* refFrame(const int nSamples) {
+        if(!mCurrentSamples) return nullptr;
+        if(mEndSample - mCurrentSample + 1 < nSamples) return nullptr;
+        const int nChannels = static_cast<int>(mCurrentSamples->fNChannels);
+        const bool planar = mCurrentSamples->fPlanar;
+        if(planar && nChannels > AV_NUM_DATA_POINTERS) return nullptr;
+        AVFrame* frame = av_frame_alloc();
+        if(!frame) RuntimeThrow("Error allocating an audio frame");
+        frame->format = mCurrentSamples->fFormat;
+        frame->channel_layout = mCurrentSamples->fChannelLayout;
+        frame->channels = nChannels;
+        frame->sample_rate = mCurrentSamples->fSampleRate;
+        frame->nb_samples = nSamples;
+
+        const int sampleSize = int(mCurrentSamples->fSampleSize);
+        const int nPlanes = planar ? nChannels : 1;
+        const int planeSamples = planar ? nSamples : nSamples*nChannels;
+        frame->linesize[0] = planeSamples*sampleSize;
+        const int offset = mCurrentSample*sampleSize*(planar ? 1 : nChannels);
+        for(int i = 0; i < nPlanes; i++) {
+            frame->data[i] = mCurrentData[i] + offset;
+        }
+        frame->extended_data = frame->data;
+
+        const auto holder = new stdsptr<Samples>(mSamples.first());
+        frame->buf[0] = av_buffer_create(frame->data[0],
+                                         frame->linesize[0],
+                                         &sReleaseSamples, holder,
+                                         AV_BUFFER_FLAG_READONLY);
+        if(!frame->buf[0]) {
+            delete holder;
+            av_frame_free(&frame);
+            RuntimeThrow("Error referencing audio samples");
+        }
+
+        mCurrentSample += nSamples;
+        if(mCurrentSample > mEndSample) next();
+        return frame;
+    }
+
     bool next() {
         if(mSamples.isEmpty()) return false;
         mSamples.removeFirst();
@@ -121,6 +164,11 @@ public:
         updateCurrent();
     }
 private:
+    static void sReleaseSamples(void* opaque, uint8_t* data) {
+        Q_UNUSED(data)
+        delete static_cast<stdsptr<Samples>*>(opaque);
+    }
+
     bool updateCurrent() {
         if(mSamples.isEmpty()) {
             mCurrentSamples = nullptr;
@@ -152,6 +200,8 @@ typedef struct OutputStream {
     AVCodecContext *fCodec = nullptr;
     AVFrame *fDstFrame = nullptr;
     AVFrame *fSrcFrame = nullptr;
+    // 16 bit per component copy of half float frames
+    AVFrame *fWideFrame = nullptr;
     struct SwsContext *fSwsCtx = nullptr;
     struct SwrContext *fSwrCtx = nullptr;
 } OutputStream;
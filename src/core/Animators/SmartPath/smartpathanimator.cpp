@@ -104,7 +104,7 @@ void SmartPathAnimator::prp_readProperty_impl(eReadStream& src) {
 
 void SmartPathAnimator::prp_writeProperty_impl(eWriteStream &dst) const {
     anim_writeKeys(dst);
-    dst << baseValue();
+    if(!dst.fingerprint() || !anim_hasKeys()) dst << baseValue();
     dst.write(&mMode, sizeof(Mode));
     dst << prp_getName();
 }
@@ -87,7 +87,7 @@ int Animator::anim_getNextKeyRelFrame(const int relFrame) const {
 void Animator::prp_afterChangedAbsRange(const FrameRange &range, const bool clip) {
     if(range.inRange(anim_mCurrentAbsFrame))
         prp_afterChangedCurrent(UpdateReason::userChange);
-    emit prp_absFrameRangeChanged(range, clip);
+    prp_emitAbsFrameRangeChanged(range, clip);
 }
 
 void Animator::anim_updateAfterChangedKey(Key * const key) {
@@ -276,6 +276,8 @@ void Animator::anim_appendKey(const stdsptr<Key>& newKey) {
         anim_setKeyOnCurrentFrame(newKey.get());
     if(!isComplex) anim_updateAfterChangedKey(newKey.get());
     emit anim_addedKey(newKey.get(), QPrivateSignal());
+    if(const auto parent = prp_notifiedParent())
+        parent->ca_addDescendantsKey(newKey.get());
 }
 
 void Animator::anim_removeKey(const stdsptr<Key>& keyToRemove) {
@@ -308,6 +310,8 @@ void Animator::removeKeyWithoutDeselecting(const stdsptr<Key>& keyToRemove) {
     if(rFrame == anim_mCurrentRelFrame)
         anim_setKeyOnCurrentFrame(nullptr);
     emit anim_removedKey(keyPtr, QPrivateSignal());
+    if(const auto parent = prp_notifiedParent())
+        parent->ca_removeDescendantsKey(keyPtr);
 }
 
 void Animator::anim_moveKeyToRelFrame(Key * const key, const int newFrame) {
@@ -386,7 +390,13 @@ void Animator::anim_setRecordingValue(const bool rec) {
         prp_addUndoRedo(ur);
     }
     anim_mIsRecording = rec;
+    anim_afterRecordingChanged();
+}
+
+void Animator::anim_afterRecordingChanged() {
     emit anim_isRecordingChanged();
+    if(const auto parent = prp_notifiedParent())
+        parent->ca_childIsRecordingChanged();
 }
 
 bool Animator::anim_isRecording() {
@@ -209,6 +209,8 @@ protected:
     void anim_writeKeys(eWriteStream& dst) const;
 
     IdRange anim_frameRangeToKeyIdRange(const FrameRange& relRange) const;
+    //! @brief Emits anim_isRecordingChanged and updates the parent
+    void anim_afterRecordingChanged();
 signals:
     void anim_isRecordingChanged();
     void anim_changedKeyOnCurrentFrame(Key* key, QPrivateSignal);
@@ -197,7 +197,7 @@ void BasedAnimatorT<B, K, T>::anim_addKeyAtRelFrame(const int relFrame) {
 template<typename B, typename K, typename T>
 void BasedAnimatorT<B, K, T>::prp_writeProperty_impl(eWriteStream &dst) const {
     this->anim_writeKeys(dst);
-    dst << mCurrentValue;
+    if(!dst.fingerprint() || !this->anim_hasKeys()) dst << mCurrentValue;
 }
 
 template<typename B, typename K, typename T>
@@ -25,6 +25,28 @@ ComplexAnimator::ComplexAnimator(const QString &name) :
     SWT_setEnabled(false);
 }
 
+ComplexAnimator::~ComplexAnimator() {
+    for(const auto& child : ca_mChildren) {
+        if(child->prp_mNotifiedParent != this) continue;
+        child->prp_mNotifiedParent = nullptr;
+        child->prp_mParentInfluenced = false;
+    }
+}
+
+void ComplexAnimator::prp_afterAncestorChanged() {
+    Property::prp_afterAncestorChanged();
+    for(const auto& child : ca_mChildren) {
+        if(child->getParent() == this) child->prp_afterAncestorChanged();
+    }
+}
+
+void ComplexAnimator::prp_afterPathChanged() {
+    Property::prp_afterPathChanged();
+    for(const auto& child : ca_mChildren) {
+        if(child->getParent() == this) child->prp_afterPathChanged();
+    }
+}
+
 bool ComplexAnimator::prp_dependsOn(const Property* const prop) const {
     if(Property::prp_dependsOn(prop)) return true;
     for(const auto& child : ca_mChildren) {
@@ -135,7 +157,17 @@ void ComplexAnimator::ca_insertChild(const qsptr<Property>& child,
         if(ca_mHiddenEmpty) SWT_setVisible(true);
     }
 
+    const bool changeInfluence = !(enve_cast<BoundingBox*>(this) &&
+                                   enve_cast<eSound*>(child));
+
     ca_mChildren.insert(id, child);
+    // a shared child, e.g. a gradient, notifies its first parent directly
+    // and any further parents through connections
+    const bool notified = !child->prp_mNotifiedParent;
+    if(notified) {
+        child->prp_mNotifiedParent = this;
+        child->prp_mParentInfluenced = changeInfluence;
+    }
     child->setParent(this);
     child->prp_setInheritedFrameShift(prp_getTotalFrameShift(), this);
     if(child->prp_drawsOnCanvas() ||
@@ -143,21 +175,20 @@ void ComplexAnimator::ca_insertChild(const qsptr<Property>& child,
         prp_updateCanvasProps();
     }
 
-    const bool changeInfluence = !(enve_cast<BoundingBox*>(this) &&
-                                   enve_cast<eSound*>(child));
-
     if(const auto childAnimator = enve_cast<Animator*>(child.get())) {
-        connect(childAnimator, &Animator::anim_isRecordingChanged,
-                this, &ComplexAnimator::ca_childIsRecordingChanged);
-        connect(childAnimator, &Animator::anim_addedKey,
-                this, &ComplexAnimator::ca_addDescendantsKey);
-        connect(childAnimator, &Animator::anim_removedKey,
-                this, &ComplexAnimator::ca_removeDescendantsKey);
+        if(!notified) {
+            connect(childAnimator, &Animator::anim_isRecordingChanged,
+                    this, &ComplexAnimator::ca_childIsRecordingChanged);
+            connect(childAnimator, &Animator::anim_addedKey,
+                    this, &ComplexAnimator::ca_addDescendantsKey);
+            connect(childAnimator, &Animator::anim_removedKey,
+                    this, &ComplexAnimator::ca_removeDescendantsKey);
+        }
         childAnimator->anim_addAllKeysToComplexAnimator(this);
         ca_childIsRecordingChanged();
         childAnimator->anim_setAbsFrame(anim_getCurrentAbsFrame());
     }
-    if(changeInfluence){
+    if(!notified && changeInfluence) {
         connect(child.data(), &Property::prp_absFrameRangeChanged,
                 this, &ComplexAnimator::prp_afterChangedAbsRange);
     }
@@ -281,6 +312,10 @@ void ComplexAnimator::ca_removeChild(const qsptr<Property> child) {
         childAnimator->anim_removeAllKeysFromComplexAnimator(this);
     }
     disconnect(child.get(), nullptr, this, nullptr);
+    if(child->prp_mNotifiedParent == this) {
+        child->prp_mNotifiedParent = nullptr;
+        child->prp_mParentInfluenced = false;
+    }
 
     SWT_removeChild(child.get());
 
@@ -397,7 +432,7 @@ void ComplexAnimator::ca_childIsRecordingChanged() {
     rec = rec && childRec;
     if(childRec != ca_mChildRecording) {
         ca_mChildRecording = childRec;
-        if(rec == anim_isRecording()) emit anim_isRecordingChanged();
+        if(rec == anim_isRecording()) anim_afterRecordingChanged();
     }
     if(rec != anim_isRecording()) {
         anim_setRecordingValue(rec);
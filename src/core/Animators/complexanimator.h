@@ -29,7 +29,9 @@ class CORE_EXPORT ComplexAnimator : public Animator {
     e_DECLARE_TYPE(ComplexAnimator)
 protected:
     ComplexAnimator(const QString& name);
-public:    
+public:
+    ~ComplexAnimator();
+
     virtual void ca_childIsRecordingChanged();
     virtual void ca_removeAllChildren();
 
@@ -160,6 +162,9 @@ protected:
     const QList<qsptr<Property>>& ca_getChildren() const
     { return ca_mChildren; }
 private:
+    void prp_afterAncestorChanged();
+    void prp_afterPathChanged();
+
     bool ca_mDisabledEmpty = true;
     bool ca_mHiddenEmpty = false;
     bool ca_mChildRecording = false;
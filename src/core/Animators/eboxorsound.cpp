@@ -205,6 +205,10 @@ void eBoxOrSound::prp_drawTimelineControls(
                 p, pixelsPerFrame, absFrameRange, rowHeight);
 }
 
+bool eBoxOrSound::prp_timelineControlsCachable() const {
+    return !mDurationRectangle || !mDurationRectangle->drawsCache();
+}
+
 void eBoxOrSound::setDurationRectangle(
         const qsptr<DurationRectangle>& durationRect,
         const bool lock) {
@@ -65,6 +65,7 @@ public:
     void prp_drawTimelineControls(
             QPainter * const p, const qreal pixelsPerFrame,
             const FrameRange &absFrameRange, const int rowHeight);
+    bool prp_timelineControlsCachable() const;
 
     void setParentGroup(ContainerBox * const parent);
     ContainerBox *getParentGroup() const { return mParentGroup; }
@@ -329,7 +329,7 @@ void InterOptimalAnimatorT<T, K>::writeValuesXEV(
 template <typename T, typename K>
 void InterOptimalAnimatorT<T, K>::prp_writeProperty_impl(eWriteStream &dst) const {
     anim_writeKeys(dst);
-    mBaseValue.write(dst);
+    if(!dst.fingerprint() || !anim_hasKeys()) mBaseValue.write(dst);
     dst << prp_getName();
 }
 
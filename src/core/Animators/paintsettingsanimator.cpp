@@ -40,6 +40,14 @@ void PaintSettingsAnimator::prp_writeProperty_impl(eWriteStream& dst) const {
     mColor->prp_writeProperty_impl(dst);
     dst.write(&mPaintType, sizeof(PaintType));
     dst.write(&mGradientType, sizeof(GradientType));
+    if(dst.fingerprint()) {
+        // runtime ids differ between sessions, hash the colors instead
+        dst << static_cast<bool>(mGradient);
+        if(mGradient) mGradient->prp_writeProperty_impl(dst);
+        mGradientPoints->prp_writeProperty_impl(dst);
+        mGradientTransform->prp_writeProperty_impl(dst);
+        return;
+    }
     const int gradRWId = mGradient ? mGradient->getReadWriteId() : -1;
     const int gradDocId = mGradient ? mGradient->getDocumentId() : -1;
     dst << gradRWId;
@@ -69,7 +69,7 @@ void QrealAnimator::prp_setupTreeViewMenu(PropertyMenu * const menu) {
 
 void QrealAnimator::prp_writeProperty_impl(eWriteStream& dst) const {
     anim_writeKeys(dst);
-    dst << mCurrentBaseValue;
+    if(!dst.fingerprint() || !anim_hasKeys()) dst << mCurrentBaseValue;
     dst << !!mExpression;
     if(mExpression) {
         dst << mExpression->bindingsString();
@@ -24,6 +24,8 @@
 #include "svgexporter.h"
 #include "Boxes/boundingbox.h"
 
+int BasicTransformAnimator::sCacheGeneration = 0;
+
 BasicTransformAnimator::BasicTransformAnimator() :
     StaticComplexAnimator("transform") {
     mPosAnimator = enve::make_shared<QPointFAnimator>("translation");
@@ -213,6 +215,8 @@ void BasicTransformAnimator::updateInheritedTransform(const UpdateReason reason)
 }
 
 void BasicTransformAnimator::updateTotalTransform(const UpdateReason reason) {
+    // parent or effect target change, transforms at other frames may differ
+    if(reason == UpdateReason::userChange) sClearTransformCache();
     if(mParentTransform) {
         mTotalTransform = mRelTransform*mInheritedTransform;
     } else {
@@ -288,15 +292,54 @@ QMatrix BasicTransformAnimator::getInheritedTransformAtFrame(
 
 QMatrix BasicTransformAnimator::getTotalTransformAtFrame(
         const qreal relFrame) const {
-    if(mParentTransform) {
-        const qreal absFrame = prp_relFrameToAbsFrameF(relFrame);
-        const qreal parentRelFrame =
-                mParentTransform->prp_absFrameToRelFrameF(absFrame);
-        return getRelativeTransformAtFrame(relFrame)*
-                mParentTransform->getTotalTransformAtFrame(parentRelFrame);
-    } else {
-        return getRelativeTransformAtFrame(relFrame);
+    {
+        const auto& cached = cachedTransform(relFrame);
+        if(cached.fTotalValid) return cached.fTotal;
+    }
+    const auto relative = getCachedRelativeTransformAtFrame(relFrame);
+    const auto total = mParentTransform ?
+                relative*getInheritedTransformAtFrame(relFrame) : relative;
+    auto& cached = cachedTransform(relFrame);
+    cached.fTotal = total;
+    cached.fTotalValid = true;
+    return total;
+}
+
+QMatrix BasicTransformAnimator::getCachedRelativeTransformAtFrame(
+        const qreal relFrame) const {
+    {
+        const auto& cached = cachedTransform(relFrame);
+        if(cached.fRelativeValid) return cached.fRelative;
+    }
+    const auto relative = getRelativeTransformAtFrame(relFrame);
+    auto& cached = cachedTransform(relFrame);
+    cached.fRelative = relative;
+    cached.fRelativeValid = true;
+    return relative;
+}
+
+BasicTransformAnimator::CachedTransform&
+    BasicTransformAnimator::cachedTransform(const qreal relFrame) const {
+    if(mCacheGeneration != sCacheGeneration) {
+        mTransformCache.clear();
+        mCacheGeneration = sCacheGeneration;
+    }
+    const auto it = mTransformCache.find(relFrame);
+    if(it != mTransformCache.end()) return it->second;
+    if(int(mTransformCache.size()) >= sMaxCachedFrames) {
+        mTransformCache.erase(mTransformCache.begin());
     }
+    return mTransformCache[relFrame];
+}
+
+void BasicTransformAnimator::sClearTransformCache() {
+    sCacheGeneration++;
+}
+
+void BasicTransformAnimator::prp_afterChangedAbsRange(const FrameRange &range,
+                                                      const bool clip) {
+    sClearTransformCache();
+    StaticComplexAnimator::prp_afterChangedAbsRange(range, clip);
 }
 
 FrameRange BasicTransformAnimator::prp_getIdenticalRelRange(const int relFrame) const {
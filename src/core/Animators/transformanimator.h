@@ -22,6 +22,8 @@
 
 #include <QMatrix>
 
+#include <map>
+
 class TransformUpdater;
 class BoxPathPoint;
 class MovablePoint;
@@ -39,7 +41,16 @@ public:
     virtual QMatrix getInheritedTransformAtFrame(const qreal relFrame) const;
     virtual QMatrix getTotalTransformAtFrame(const qreal relFrame) const;
 
+    //! @brief Memoized getRelativeTransformAtFrame,
+    //! valid until any transform in the document changes
+    QMatrix getCachedRelativeTransformAtFrame(const qreal relFrame) const;
+
     FrameRange prp_getIdenticalRelRange(const int relFrame) const;
+    void prp_afterChangedAbsRange(const FrameRange &range,
+                                  const bool clip = true) override;
+
+    //! @brief Invalidates memoized transforms of all animators
+    static void sClearTransformCache();
 
     void resetScale();
     void resetTranslation();
@@ -111,7 +122,22 @@ protected:
     qsptr<QPointFAnimator> mScaleAnimator;
     qsptr<QrealAnimator> mRotAnimator;
 private:
+    struct CachedTransform {
+        bool fRelativeValid = false;
+        bool fTotalValid = false;
+        QMatrix fRelative;
+        QMatrix fTotal;
+    };
+
+    CachedTransform& cachedTransform(const qreal relFrame) const;
+
     bool rotationFlipped() const;
+
+    static const int sMaxCachedFrames = 64;
+    static int sCacheGeneration;
+
+    mutable int mCacheGeneration = 0;
+    mutable std::map<qreal, CachedTransform> mTransformCache;
 signals:
     void totalTransformChanged(const UpdateReason);
     void inheritedTransformChanged(const UpdateReason);
@@ -33,6 +33,10 @@ void BlendEffectBoxShadow::prp_drawTimelineControls(
                                        absFrameRange, rowHeight);
 }
 
+bool BlendEffectBoxShadow::prp_timelineControlsCachable() const {
+    return mBox->prp_timelineControlsCachable();
+}
+
 qsptr<BlendEffectBoxShadow> BlendEffectBoxShadow::createLink() const {
     return enve::make_shared<BlendEffectBoxShadow>(mBox, mEffect);
 }
@@ -23,6 +23,7 @@ public:
     void prp_drawTimelineControls(
             QPainter * const p, const qreal pixelsPerFrame,
             const FrameRange &absFrameRange, const int rowHeight);
+    bool prp_timelineControlsCachable() const;
 
     QMimeData *SWT_createMimeData() { return nullptr; }
 
@@ -46,6 +46,9 @@
 #include "svgexporthelpers.h"
 #include "internallinkcanvas.h"
 
+#include <QBuffer>
+#include <QCryptographicHash>
+
 int BoundingBox::sNextDocumentId = 0;
 QList<BoundingBox*> BoundingBox::sDocumentBoxes;
 int BoundingBox::sNextWriteId;
@@ -89,6 +92,9 @@ BoundingBox::BoundingBox(const QString& name, const eBoxType type) :
     });
     connect(mBlendEffectCollection.get(), &Property::prp_currentFrameChanged,
             this, &BoundingBox::blendEffectChanged);
+    // links to hidden boxes still follow changes
+    connect(this, &Property::prp_absFrameRangeChanged,
+            this, [this]() { mLinkRasterInstances.clear(); });
 }
 
 BoundingBox::~BoundingBox() {
@@ -96,12 +102,54 @@ BoundingBox::~BoundingBox() {
 }
 
 void BoundingBox::writeBoundingBox(eWriteStream& dst) const {
+    if(dst.fingerprint()) {
+        eBoxOrSound::prp_writeProperty_impl(dst);
+        dst.write(&mBlendMode, sizeof(SkBlendMode));
+        return;
+    }
     if(mWriteId < 0) assignWriteId();
     eBoxOrSound::prp_writeProperty_impl(dst);
     dst << mWriteId;
     dst.write(&mBlendMode, sizeof(SkBlendMode));
 }
 
+bool BoundingBox::fingerprintValid() const {
+    if(mFingerprint.isEmpty()) return false;
+    if(mFingerprintChangeId != mChangeId) return false;
+    if(mFingerprintStateId != mStateId) return false;
+    for(const auto& dep : mFingerprintDeps) {
+        if(!dep.fBox) return false;
+        if(dep.fBox->fingerprint() != dep.fFingerprint) return false;
+    }
+    return true;
+}
+
+const QByteArray& BoundingBox::fingerprint() const {
+    // boxes linking each other
+    if(mFingerprinting) return mFingerprint;
+    if(fingerprintValid()) return mFingerprint;
+    mFingerprinting = true;
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    eWriteStream dst(&buffer);
+    dst.setFingerprint(true);
+    writeIdentifier(dst);
+    writeBoundingBox(dst);
+    mFingerprintDeps.clear();
+    for(const auto box : dst.fingerprintDeps()) {
+        const auto& depFingerprint = box->fingerprint();
+        dst << depFingerprint;
+        mFingerprintDeps.append({box, depFingerprint});
+    }
+    buffer.close();
+    mFingerprint = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    mFingerprintChangeId = mChangeId;
+    mFingerprintStateId = mStateId;
+    mFingerprinting = false;
+    return mFingerprint;
+}
+
 void BoundingBox::readBoundingBox(eReadStream& src) {
     eBoxOrSound::prp_readProperty_impl(src);
     if(src.evFileVersion() < 10) {
@@ -144,6 +192,8 @@ BoundingBox *BoundingBox::sGetBoxByDocumentId(const int documentId) {
 
 void BoundingBox::prp_afterChangedAbsRange(const FrameRange &range, const bool clip) {
     const auto croppedRange = clip ? prp_absInfluenceRange()*range : range;
+    mIdenticalRelRange = FrameRange::INVALID;
+    mChangeId++;
     StaticComplexAnimator::prp_afterChangedAbsRange(croppedRange, clip);
     if(croppedRange.inRange(anim_getCurrentAbsFrame())) {
         planUpdate(UpdateReason::userChange);
@@ -249,6 +299,10 @@ bool BoundingBox::getRasterEffectsEnabled() const {
     return mRasterEffectsAnimators->SWT_isEnabled();
 }
 
+bool BoundingBox::hasRasterEffects() const {
+    return mRasterEffectsAnimators->hasEffects();
+}
+
 void BoundingBox::updateAllBoxes(const UpdateReason reason) {
     planUpdate(reason);
 }
@@ -397,10 +451,13 @@ void BoundingBox::anim_setAbsFrame(const int frame) {
     const int oldRelFrame = anim_getCurrentRelFrame();
     ComplexAnimator::anim_setAbsFrame(frame);
     const int newRelFrame = anim_getCurrentRelFrame();
-
-    if(prp_differencesBetweenRelFrames(oldRelFrame, newRelFrame)) {
-        planUpdate(UpdateReason::frameChange);
+    // skip walking the whole subtree while the cached range covers both
+    if(!mIdenticalRelRange.inRange(oldRelFrame)) {
+        mIdenticalRelRange = prp_getIdenticalRelRange(oldRelFrame);
     }
+    if(mIdenticalRelRange.inRange(newRelFrame)) return;
+    mIdenticalRelRange = prp_getIdenticalRelRange(newRelFrame);
+    planUpdate(UpdateReason::frameChange);
 }
 
 bool BoundingBox::diffsIncludingInherited(
@@ -500,7 +557,6 @@ void BoundingBox::updateCurrentPreviewDataFromRenderData(
 }
 
 void BoundingBox::planUpdate(const UpdateReason reason) {
-    if(mUpdatePlanned && mPlannedReason == UpdateReason::userChange) return;
     if(!isVisibleAndInVisibleDurationRect()) return;
     const auto parent = getParentGroup();
     if(parent) parent->planUpdate(reason);
@@ -508,6 +564,7 @@ void BoundingBox::planUpdate(const UpdateReason reason) {
     if(reason == UpdateReason::userChange) {
         mStateId++;
         mRenderDataHandler.clear();
+        mLinkRasterInstances.clear();
     }
 
     mDrawRenderContainer.setExpired(true);
@@ -875,6 +932,7 @@ void BoundingBox::setupWithoutRasterEffects(const qreal relFrame,
     data->fTotalTransform = thisRelM*parentM;
 
     data->fResolution = scene->getResolution();
+    data->fHighBitDepth = scene->highBitDepth();
     data->fResolutionScale.reset();
     data->fResolutionScale.scale(data->fResolution, data->fResolution);
     data->fOpacity = getOpacity(relFrame);
@@ -997,7 +1055,7 @@ void BoundingBox::removeRasterEffect(const qsptr<RasterEffect> &effect) {
 QMatrix BoundingBox::getRelativeTransformAtFrame(const qreal relFrame) const {
     if(isZero6Dec(relFrame - anim_getCurrentRelFrame()))
         return mTransformAnimator->getRelativeTransform();
-    return mTransformAnimator->getRelativeTransformAtFrame(relFrame);
+    return mTransformAnimator->getCachedRelativeTransformAtFrame(relFrame);
 }
 
 QMatrix BoundingBox::getInheritedTransformAtFrame(const qreal relFrame) const {
@@ -1012,6 +1070,13 @@ QMatrix BoundingBox::getTotalTransformAtFrame(const qreal relFrame) const {
     return mTransformAnimator->getTotalTransformAtFrame(relFrame);
 }
 
+void BoundingBox::cacheTransformsAtAbsFrames(const QList<qreal>& absFrames) {
+    for(const qreal absFrame : absFrames) {
+        const qreal relFrame = prp_absFrameToRelFrameF(absFrame);
+        getTotalTransformAtFrame(relFrame);
+    }
+}
+
 void BoundingBox::setCustomPropertiesVisible(const bool visible) {
     if(mCustomProperties->SWT_isVisible() == visible) return;
     {
@@ -1295,6 +1360,13 @@ void BoundingBox::renderDataFinished(BoxRenderData *renderData) {
     }
 }
 
+void BoundingBox::renderDataCanceled(BoxRenderData *renderData) {
+    // let the frame be qued again once it is needed
+    const qreal relFrame = renderData->fRelFrame;
+    if(mRenderDataHandler.getItemAtRelFrame(relFrame) != renderData) return;
+    mRenderDataHandler.removeItemAtRelFrame(relFrame);
+}
+
 //QString skBlendModeToSVG(const SkBlendMode mode) {
 //    switch(mode) {
 //    case SkBlendMode::kMultiply:    return "multiply";
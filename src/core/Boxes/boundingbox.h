@@ -21,6 +21,7 @@
 #include "boxrendercontainer.h"
 #include "skia/skiaincludes.h"
 #include "renderdatahandler.h"
+#include "linkrasterinstances.h"
 #include "smartPointers/ememory.h"
 #include "colorhelpers.h"
 #include "MovablePoints/segment.h"
@@ -181,6 +182,9 @@ public:
     virtual QMatrix getRelativeTransformAtFrame(const qreal relFrame) const;
     virtual QMatrix getInheritedTransformAtFrame(const qreal relFrame) const;
     virtual QMatrix getTotalTransformAtFrame(const qreal relFrame) const;
+    //! @brief Fills the transform cache of this box and its descendants
+    //! for absFrames in one top-down pass
+    virtual void cacheTransformsAtAbsFrames(const QList<qreal>& absFrames);
     virtual QPointF mapAbsPosToRel(const QPointF &absPos);
 
     virtual void applyPaintSetting(const PaintSettingsApplier &setting);
@@ -199,6 +203,9 @@ public:
                                  BoxRenderData * const data,
                                  Canvas * const scene);
     virtual void renderDataFinished(BoxRenderData *renderData);
+    void renderDataCanceled(BoxRenderData *renderData);
+    LinkRasterInstances& linkRasterInstances()
+    { return mLinkRasterInstances; }
     virtual void updateCurrentPreviewDataFromRenderData(
             BoxRenderData* renderData);
 
@@ -217,6 +224,10 @@ public:
     virtual void writeBoundingBox(eWriteStream& dst) const;
     virtual void readBoundingBox(eReadStream& src);
 
+    //! @brief Sha1 of the frame independent content, only boxes changed
+    //! since the last call (or depending on changed boxes) are rewritten
+    const QByteArray& fingerprint() const;
+
     virtual SkBlendMode getBlendMode() const
     { return mBlendMode; }
 
@@ -351,6 +362,7 @@ public:
 
     void setRasterEffectsEnabled(const bool enable);
     bool getRasterEffectsEnabled() const;
+    bool hasRasterEffects() const;
 
     void clearRasterEffects();
 
@@ -439,15 +451,22 @@ protected:
     uint mStateId = 0;
 
     int mNReasonsNotToApplyUglyTransform = 0;
+    //! @brief Identical range containing the current frame,
+    //! invalidated on every change to the box or its descendants
+    FrameRange mIdenticalRelRange = FrameRange::INVALID;
 protected:
     bool getUpdatePlanned() const
     { return mUpdatePlanned; }
+    //! @brief For boxes queuing no render data of their own
+    void resetUpdatePlanned()
+    { mUpdatePlanned = false; }
 
     const int mDocumentId;
 
     eBoxType mType;
 
     RenderDataHandler mRenderDataHandler;
+    LinkRasterInstances mLinkRasterInstances;
 
     const qsptr<CustomProperties> mCustomProperties;
     const qsptr<BlendEffectCollection> mBlendEffectCollection;
@@ -463,10 +482,25 @@ private:
     void setBlendEffectsVisible(const bool visible);
     void setTransformEffectsVisible(const bool visible);
 
+    bool fingerprintValid() const;
+
     SkBlendMode mBlendMode = SkBlendMode::kSrcOver;
 
     mutable int mWriteId = -1;
 
+    struct FingerprintDep {
+        qptr<BoundingBox> fBox;
+        QByteArray fFingerprint;
+    };
+
+    //! @brief Incremented on every change to the box or its descendants
+    uint mChangeId = 0;
+    mutable uint mFingerprintChangeId = 0;
+    mutable uint mFingerprintStateId = 0;
+    mutable bool mFingerprinting = false;
+    mutable QByteArray mFingerprint;
+    mutable QList<FingerprintDep> mFingerprintDeps;
+
     bool mVisibleInScene = true;
     bool mCenterPivotPlanned = false;
     bool mUpdatePlanned = false;
@@ -142,8 +142,9 @@ void BoxRenderData::process() {
     if(isZero4Dec(fOpacity)) return;
     if(fGlobalRect.width() <= 0 || fGlobalRect.height() <= 0) return;
 
-    const auto info = SkiaHelpers::getPremulRGBAInfo(fGlobalRect.width(),
-                                                     fGlobalRect.height());
+    auto info = SkiaHelpers::getPremulRGBAInfo(fGlobalRect.width(),
+                                               fGlobalRect.height());
+    if(useHighBitDepth()) info = info.makeColorType(kRGBA_F16_SkColorType);
     mBitmap.allocPixels(info);
     mBitmap.eraseColor(eraseColor());
     SkCanvas canvas(mBitmap);
@@ -159,7 +160,47 @@ void BoxRenderData::beforeProcessing(const Hardware hw) {
     Q_ASSERT(mStep != Step::EFFECTS);
     setupRenderData();
     if(!mDataSet) dataSet();
-    if(isZero4Dec(fOpacity)) finishedProcessing();
+    // direct draws already finish in setupRenderData
+    if(!finished()) {
+        if(isZero4Dec(fOpacity)) finishedProcessing();
+        else if(fInstanceSource && setupInstanceDraw()) finishedProcessing();
+        else if(!mEffectsRenderer.isEmpty()) {
+            // lets effects evaluate their scripts on the gui thread,
+            // process() computes the same rect again and reports errors
+            try {
+                updateGlobalRect();
+            } catch(...) {}
+        }
+    }
+    fInstanceSource.reset();
+}
+
+bool BoxRenderData::setupInstanceDraw() {
+    const auto src = fInstanceSource.get();
+    if(!src->finished() || !src->fRenderedImage) return false;
+    bool invertible = false;
+    const QMatrix srcInv = src->fScaledTransform.inverted(&invertible);
+    if(!invertible) return false;
+    fScaledTransform = fTotalTransform*fResolutionScale;
+    const QMatrix instanceM = srcInv*fScaledTransform;
+    const QRect& srcRect = src->fGlobalRect;
+    const QRect srcInner = src->fMaxBoundsRect.adjusted(1, 1, -1, -1);
+    if(!srcInner.contains(srcRect)) {
+        // source was clamped, make sure the missing part is not needed
+        const auto neededRect = instanceM.inverted().mapRect(
+                    QRectF(fMaxBoundsRect));
+        if(!QRectF(src->fMaxBoundsRect).contains(neededRect)) return false;
+    }
+    fGlobalRect = instanceM.mapRect(QRectF(srcRect)).toAlignedRect();
+    fGlobalRect = fGlobalRect.intersected(fMaxBoundsRect);
+    fRenderTransform.reset();
+    fRenderTransform.translate(srcRect.x(), srcRect.y());
+    fRenderTransform *= instanceM;
+    fRenderTransform.translate(-fGlobalRect.x(), -fGlobalRect.y());
+    fUseRenderTransform = true;
+    fRenderedImage = src->fRenderedImage;
+    fAntiAlias = true;
+    return true;
 }
 
 void BoxRenderData::afterProcessing() {
@@ -173,6 +214,10 @@ void BoxRenderData::afterProcessing() {
     }
 }
 
+void BoxRenderData::afterCanceled() {
+    if(fParentBox && fParentIsTarget) fParentBox->renderDataCanceled(this);
+}
+
 void BoxRenderData::afterQued() {
     if(mDataSet) return;
     if(!mDelayDataSet) dataSet();
@@ -182,10 +227,16 @@ void BoxRenderData::afterQued() {
 
 HardwareSupport BoxRenderData::hardwareSupport() const {
     if(mStep == Step::EFFECTS) {
+        // half float frames are processed by cpu effects only
+        if(useHighBitDepth()) return HardwareSupport::cpuOnly;
         return mEffectsRenderer.nextHardwareSupport();
     } else {
-        if(fParentBox) return fParentBox->hardwareSupport();
-        return HardwareSupport::cpuPreffered;
+        if(!fParentBox) return HardwareSupport::cpuPreffered;
+        const auto support = fParentBox->hardwareSupport();
+        // gpu textures are 8 bit
+        if(support != HardwareSupport::gpuOnly && useHighBitDepth())
+            return HardwareSupport::cpuOnly;
+        return support;
     }
 }
 
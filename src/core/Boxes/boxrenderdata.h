@@ -43,8 +43,9 @@ protected:
     virtual void updateGlobalRect();
 
     HardwareSupport hardwareSupport() const;
+    bool rendersFrame() const { return true; }
 
-    void afterCanceled() {}
+    void afterCanceled();
     void beforeProcessing(const Hardware hw) final;
     void afterProcessing();
     void afterQued();
@@ -53,6 +54,10 @@ protected:
     virtual SkColor eraseColor() const {
         return SK_ColorTRANSPARENT;
     }
+    //! @brief Mypaint surfaces and most raster effects only handle 8 bit pixels
+    virtual bool supportsHighBitDepth() const {
+        return mEffectsRenderer.supportsHighBitDepth();
+    }
 public:
     virtual void drawOnParentLayer(SkCanvas * const canvas,
                                    SkPaint& paint);
@@ -101,12 +106,18 @@ public:
     stdptr<BoxRenderData> fMotionBlurTarget;
     // for motion blur
 
+    //! @brief Identical content rendered with a similar transform,
+    //! its raster is drawn transformed instead of rasterizing again
+    stdsptr<BoxRenderData> fInstanceSource;
+
     SkBlendMode fBlendMode = SkBlendMode::kSrcOver;
     const SkFilterQuality fFilterQuality;
     bool fAntiAlias = false;
     bool fUseRenderTransform = false;
 
     bool fParentIsTarget = true;
+    //! @brief Render to a half float bitmap if supported
+    bool fHighBitDepth = false;
     qptr<BoundingBox> fParentBox;
     BoundingBox* fBlendEffectIdentifier;
     sk_sp<SkImage> fRenderedImage;
@@ -116,10 +127,13 @@ public:
     void addEffect(const stdsptr<RasterEffectCaller>& effect) {
         mEffectsRenderer.add(effect);
     }
-protected:
     bool hasEffects() const { return !mEffectsRenderer.isEmpty(); }
+protected:
+    bool useHighBitDepth() const
+    { return fHighBitDepth && supportsHighBitDepth(); }
 
     void setBaseGlobalRect(const QRectF &baseRectF);
+    bool setupInstanceDraw();
 
     //! @brief For use with mypaint based outlines
     SkBitmap mBitmap;
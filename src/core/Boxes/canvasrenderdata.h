@@ -23,6 +23,8 @@ struct CORE_EXPORT CanvasRenderData : public ContainerBoxRenderData {
     int fCanvasWidth;
     int fCanvasHeight;
     SkColor fBgColor;
+    //! @brief Qued by Canvas::queSceneFrame for a link canvas
+    bool fQuedForLink = false;
 
     SkColor eraseColor() const { return fBgColor; }
 protected:
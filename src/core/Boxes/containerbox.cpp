@@ -353,11 +353,21 @@ void ContainerBox::queChildrenTasks() {
         child->queTasks();
 }
 
+void ContainerBox::cacheTransformsAtAbsFrames(const QList<qreal>& absFrames) {
+    BoundingBox::cacheTransformsAtAbsFrames(absFrames);
+    for(const auto box : mContainedBoxes) {
+        box->cacheTransformsAtAbsFrames(absFrames);
+    }
+}
+
 void ContainerBox::queTasks() {
+    // planUpdate plans the parent group first
+    if(!getUpdatePlanned()) return;
     queChildrenTasks();
-    if(getUpdatePlanned() && isGroup())
+    if(isGroup()) {
         updateRelBoundingRect();
-    else BoundingBox::queTasks();
+        resetUpdatePlanned();
+    } else BoundingBox::queTasks();
 }
 
 void ContainerBox::promoteToLayer() {
@@ -1418,7 +1428,9 @@ void ContainerBox::writeAllContained(eWriteStream& dst) const {
         dst << isBox;
         if(isBox) {
             box->writeIdentifier(dst);
-            box->writeBoundingBox(dst);
+            // unchanged children reuse their cached fingerprint
+            if(dst.fingerprint()) dst << dst.addFingerprintDep(box);
+            else box->writeBoundingBox(dst);
         } else {
             Q_ASSERT(enve_cast<eIndependentSound*>(child));
             child->prp_writeProperty_impl(dst);
@@ -62,6 +62,7 @@ public:
                          const QMatrix& parentM,
                          BoxRenderData * const data,
                          Canvas * const scene);
+    void cacheTransformsAtAbsFrames(const QList<qreal>& absFrames);
     void processChildrenData(const qreal relFrame,
                              const QMatrix& thisM,
                              BoxRenderData* const data,
@@ -65,3 +65,10 @@ HardwareSupport EffectsRenderer::nextHardwareSupport() const {
     Q_ASSERT(!isEmpty());
     return mEffects.at(mCurrentId)->hardwareSupport();
 }
+
+bool EffectsRenderer::supportsHighBitDepth() const {
+    for(const auto& effect : mEffects) {
+        if(!effect->supportsHighBitDepth()) return false;
+    }
+    return true;
+}
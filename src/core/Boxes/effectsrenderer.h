@@ -40,6 +40,8 @@ public:
                            const SkIRect& skMaxBounds) const;
 
     HardwareSupport nextHardwareSupport() const;
+    //! @brief True if all effects can process kRGBA_F16 pixels
+    bool supportsHighBitDepth() const;
 private:
     int mCurrentId = 0;
     QList<stdsptr<RasterEffectCaller>> mEffects;
@@ -27,20 +27,26 @@ public:
     EffectSubTaskSpawner_priv(const stdsptr<RasterEffectCaller>& effect,
                               const stdsptr<BoxRenderData>& data) :
         mUseDst(effect->srcDstSeparation()),
+        mPasses(qMax(1, effect->cpuPasses())),
         mEffectCaller(effect), mData(data) {}
 
     void initialize();
 private:
     void decRemaining_k();
     void spawn();
+    void nextPass();
     void splitSpawn(CpuRenderData& data,
                     const SkIRect& rect,
-                    const int nSplits);
+                    const int nSplits,
+                    const CpuTileSplit split);
 
     const bool mUseDst;
+    const int mPasses;
+    int mPass = 0;
     int mRemaining = 0;
     const stdsptr<RasterEffectCaller> mEffectCaller;
     const stdsptr<BoxRenderData> mData;
+    SkBitmap mBaseBitmap;
     SkBitmap mSrcBitmap;
     SkBitmap mDstBitmap;
 
@@ -53,13 +59,15 @@ void EffectSubTaskSpawner_priv::initialize() {
     mSrcRasterImg = srcImg->makeRasterImage();
     mSrcRasterImg->peekPixels(&pixmap);
     mSrcBitmap.installPixels(pixmap);
+    mBaseBitmap = mSrcBitmap;
     if(mUseDst) mDstBitmap.allocPixels(mSrcBitmap.info());
     spawn();
 }
 
 void EffectSubTaskSpawner_priv::splitSpawn(CpuRenderData& data,
                                            const SkIRect& rect,
-                                           const int nSplits) {
+                                           const int nSplits,
+                                           const CpuTileSplit split) {
     if(nSplits == 0) return;
     if(nSplits == 1) {
         data.fTexTile = rect;
@@ -72,7 +80,7 @@ void EffectSubTaskSpawner_priv::splitSpawn(CpuRenderData& data,
                 } else {
                     mSrcBitmap.extractSubset(&dstBitmap, data.fTexTile);
                 }
-                CpuRenderTools tools{mSrcBitmap, dstBitmap};
+                CpuRenderTools tools{mSrcBitmap, dstBitmap, mBaseBitmap};
                 mEffectCaller->processCpu(tools, data);
             }, decRemaining, decRemaining);
         CpuTaskExecutor::sAddTask(subTask);
@@ -81,27 +89,32 @@ void EffectSubTaskSpawner_priv::splitSpawn(CpuRenderData& data,
 
     const int splits1 = nSplits/2;
     const int splits2 = nSplits - splits1;
-    const bool splitWidth = rect.width() > rect.height();
+    bool splitWidth;
+    switch(split) {
+    case CpuTileSplit::rows: splitWidth = false; break;
+    case CpuTileSplit::columns: splitWidth = true; break;
+    default: splitWidth = rect.width() > rect.height();
+    }
     if(splitWidth) {
         const int width1 = rect.width()*splits1/nSplits;
         const auto rect1 = SkIRect::MakeXYWH(rect.x(), rect.y(),
                                              width1, rect.height());
-        splitSpawn(data, rect1, splits1);
+        splitSpawn(data, rect1, splits1, split);
 
         //const int width2 = rect.width() - width1;
         const auto rect2 = SkIRect::MakeLTRB(rect1.right(), rect.top(),
                                              rect.right(), rect.bottom());
-        splitSpawn(data, rect2, splits2);
+        splitSpawn(data, rect2, splits2, split);
     } else {
         const int height1 = rect.height()*splits1/nSplits;
         const auto rect1 = SkIRect::MakeXYWH(rect.x(), rect.y(),
                                              rect.width(), height1);
-        splitSpawn(data, rect1, splits1);
+        splitSpawn(data, rect1, splits1, split);
 
         //const int height2 = rect.height() - height1;
         const auto rect2 = SkIRect::MakeLTRB(rect.left(), rect1.bottom(),
                                              rect.right(), rect.bottom());
-        splitSpawn(data, rect2, splits2);
+        splitSpawn(data, rect2, splits2, split);
     }
 }
 
@@ -120,13 +133,31 @@ void EffectSubTaskSpawner_priv::spawn() {
     data.fPos = mData->fGlobalRect.topLeft();
     data.fWidth = static_cast<uint>(srcWidth);
     data.fHeight = static_cast<uint>(srcHeight);
+    data.fPass = mPass;
+
+    const auto split = mEffectCaller->cpuTileSplit(mPass);
+    splitSpawn(data, srcImage->bounds(), nThreads, split);
+}
 
-    splitSpawn(data, srcImage->bounds(), nThreads);
+void EffectSubTaskSpawner_priv::nextPass() {
+    mPass++;
+    if(mUseDst) {
+        // ping-pong between two buffers, the base bitmap stays intact
+        SkBitmap newDst;
+        if(mSrcBitmap.getPixels() == mBaseBitmap.getPixels()) {
+            newDst.allocPixels(mSrcBitmap.info());
+        } else newDst = mSrcBitmap;
+        mSrcBitmap = mDstBitmap;
+        mDstBitmap = newDst;
+    }
+    spawn();
 }
 
 void EffectSubTaskSpawner_priv::decRemaining_k() {
     if(--mRemaining > 0) return;
-    if(mData->getState() != eTaskState::canceled) {
+    const bool canceled = mData->getState() == eTaskState::canceled;
+    if(!canceled && mPass + 1 < mPasses) return nextPass();
+    if(!canceled) {
         if(mUseDst) {
             mData->fRenderedImage = SkiaHelpers::transferDataToSkImage(
                                         mDstBitmap);
@@ -52,4 +52,7 @@ void InternalLinkBox::setupRenderData(const qreal relFrame,
     const auto linkTarget = getLinkTarget();
     if(linkTarget) linkTarget->setupRenderData(relFrame, parentM, data, scene);
     BoundingBox::setupRenderData(relFrame, parentM, data, scene);
+    const bool outermost = data->fParentBox.data() == this;
+    if(linkTarget && outermost)
+        linkTarget->linkRasterInstances().setup(data);
 }
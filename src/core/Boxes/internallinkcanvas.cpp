@@ -58,12 +58,7 @@ void InternalLinkCanvas::setupRenderData(const qreal relFrame,
                                          const QMatrix& parentM,
                                          BoxRenderData * const data,
                                          Canvas* const scene) {
-    {
-        BoundingBox::setupRenderData(relFrame, parentM, data, scene);
-        const qreal remapped = mFrameRemapping->frame(relFrame);
-        const auto thisM = getTotalTransformAtFrame(relFrame);
-        processChildrenData(remapped, thisM, data, scene);
-    }
+    BoundingBox::setupRenderData(relFrame, parentM, data, scene);
 
     ContainerBox* finalTarget = getFinalTarget();
     auto canvasData = static_cast<LinkCanvasRenderData*>(data);
@@ -79,6 +74,34 @@ void InternalLinkCanvas::setupRenderData(const qreal relFrame,
     } else {
         canvasData->fClipToCanvas = mClipToCanvas->getValue();
     }
+
+    const qreal remapped = mFrameRemapping->frame(relFrame);
+    if(setupSceneFrame(remapped, canvasData)) return;
+    const auto thisM = getTotalTransformAtFrame(relFrame);
+    processChildrenData(remapped, thisM, data, scene);
+}
+
+bool InternalLinkCanvas::setupSceneFrame(const qreal remapped,
+                                         LinkCanvasRenderData * const data) {
+    // only clipped links match the scene frame exactly
+    if(!data->fClipToCanvas) return false;
+    if(!isInteger4Dec(remapped)) return false;
+    const auto canvasTarget = static_cast<Canvas*>(getFinalTarget());
+    if(canvasTarget->hasRasterEffects()) return false;
+    const qreal targetRes = canvasTarget->getResolution();
+    QMatrix frameM;
+    frameM.scale(1/targetRes, 1/targetRes);
+    frameM *= data->fTotalTransform*data->fResolutionScale;
+    if(!LinkRasterInstances::sQualityPreserved(frameM)) return false;
+    const int frame = qRound(remapped);
+    data->fSceneFrameResolution = targetRes;
+    data->fSceneFrame = canvasTarget->sceneFrameImage(frame);
+    if(data->fSceneFrame) return true;
+    const auto frameData = canvasTarget->queSceneFrame(frame);
+    if(!frameData) return false;
+    data->fSceneFrameData = frameData;
+    frameData->addDependent(data);
+    return true;
 }
 
 bool InternalLinkCanvas::clipToCanvas() {
@@ -20,6 +20,8 @@
 #include "Properties/boolproperty.h"
 #include "Boxes/frameremapping.h"
 
+struct LinkCanvasRenderData;
+
 class CORE_EXPORT InternalLinkCanvas : public InternalLinkGroupBox {
     e_OBJECT
 protected:
@@ -44,6 +46,9 @@ public:
 
     bool clipToCanvas();
 private:
+    bool setupSceneFrame(const qreal remapped,
+                         LinkCanvasRenderData * const data);
+
     qsptr<BoolProperty> mClipToCanvas =
             enve::make_shared<BoolProperty>("clip");
     qsptr<QrealFrameRemapping> mFrameRemapping =
@@ -18,7 +18,36 @@
 #include "skia/skiahelpers.h"
 #include "skia/skqtconversions.h"
 
+void LinkCanvasRenderData::setupRenderData() {
+    if(fSceneFrameData) {
+        fSceneFrame = fSceneFrameData->fRenderedImage;
+        fSceneFrameData.reset();
+    }
+    if(!fSceneFrame || hasEffects()) return;
+    dataSet();
+    updateGlobalRect();
+    fRenderTransform.reset();
+    fRenderTransform.scale(1/fSceneFrameResolution, 1/fSceneFrameResolution);
+    fRenderTransform *= fScaledTransform;
+    fRenderTransform.translate(-fGlobalRect.x(), -fGlobalRect.y());
+    fUseRenderTransform = true;
+    fRenderedImage = fSceneFrame;
+    fAntiAlias = true;
+    finishedProcessing();
+}
+
 void LinkCanvasRenderData::drawSk(SkCanvas * const canvas) {
+    if(fSceneFrame) {
+        canvas->save();
+        canvas->concat(toSkMatrix(fScaledTransform));
+        const float invRes = toSkScalar(1/fSceneFrameResolution);
+        canvas->scale(invRes, invRes);
+        SkPaint paint;
+        paint.setFilterQuality(fFilterQuality);
+        canvas->drawImage(fSceneFrame, 0, 0, &paint);
+        canvas->restore();
+        return;
+    }
     ContainerBoxRenderData::drawSk(canvas);
     if(fClipToCanvas) {
         canvas->save();
@@ -22,7 +22,15 @@ struct CORE_EXPORT LinkCanvasRenderData : public CanvasRenderData {
         CanvasRenderData(parentBoxT) {}
 
     bool fClipToCanvas = false;
+
+    //! @brief Cached frame of the target scene drawn instead of its children
+    sk_sp<SkImage> fSceneFrame;
+    //! @brief Target scene frame still rendering, fSceneFrame once finished
+    stdsptr<BoxRenderData> fSceneFrameData;
+    qreal fSceneFrameResolution = 1;
 protected:
+    void setupRenderData();
+
     SkColor eraseColor() const {
         if(fClipToCanvas) return fBgColor;
         else return SK_ColorTRANSPARENT;
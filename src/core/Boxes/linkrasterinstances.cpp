@@ -0,0 +1,67 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "linkrasterinstances.h"
+
+#include <QtMath>
+
+// instanced rasters are only scaled within this range,
+// sampling quality degrades when upscaling or heavily downscaling
+const qreal gMaxInstanceUpscale = 1.05;
+const qreal gMinInstanceDownscale = 0.5;
+const int gMaxInstanceSources = 16;
+
+bool LinkRasterInstances::sQualityPreserved(const QMatrix& instanceM) {
+    // singular values of the linear part
+    const qreal e = (instanceM.m11() + instanceM.m22())*0.5;
+    const qreal f = (instanceM.m11() - instanceM.m22())*0.5;
+    const qreal g = (instanceM.m21() + instanceM.m12())*0.5;
+    const qreal h = (instanceM.m21() - instanceM.m12())*0.5;
+    const qreal q = qSqrt(e*e + h*h);
+    const qreal r = qSqrt(f*f + g*g);
+    const qreal maxScale = q + r;
+    const qreal minScale = qAbs(q - r);
+    return maxScale < gMaxInstanceUpscale && minScale > gMinInstanceDownscale;
+}
+
+void LinkRasterInstances::setup(BoxRenderData * const data) {
+    if(isZero4Dec(data->fOpacity)) return;
+    // raster effects are applied in global coordinates (shadow offset,
+    // blur radius, motion blur), their output can not be transformed
+    if(data->hasEffects()) return;
+    const QMatrix dataM = data->fTotalTransform*data->fResolutionScale;
+    for(int i = 0; i < mSources.count();) {
+        const auto src = mSources.at(i).get();
+        if(!src || src->getState() == eTaskState::canceled) {
+            mSources.removeAt(i);
+            continue;
+        }
+        i++;
+        if(!isZero4Dec(src->fRelFrame - data->fRelFrame)) continue;
+        if(!isZero4Dec(src->fResolution - data->fResolution)) continue;
+        const QMatrix srcM = src->fTotalTransform*src->fResolutionScale;
+        bool invertible = false;
+        const QMatrix srcInv = srcM.inverted(&invertible);
+        if(!invertible) continue;
+        if(!sQualityPreserved(srcInv*dataM)) continue;
+        data->fInstanceSource = src->ref<BoxRenderData>();
+        src->addDependent(data);
+        return;
+    }
+    if(mSources.count() >= gMaxInstanceSources) mSources.removeFirst();
+    mSources << data;
+}
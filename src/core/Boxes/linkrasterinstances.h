@@ -0,0 +1,39 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef LINKRASTERINSTANCES_H
+#define LINKRASTERINSTANCES_H
+#include "boxrenderdata.h"
+
+//! @brief Rasters of a link target rendered for its links.
+//! Links with identical content reuse an earlier raster of the same frame
+//! and resolution as a transformed instance instead of rasterizing again.
+class CORE_EXPORT LinkRasterInstances {
+public:
+    void clear() { mSources.clear(); }
+    //! @brief Makes data an instance of a matching registered raster,
+    //! or registers data as a raster other links can instance.
+    //! Data with raster effects is neither instanced nor registered.
+    void setup(BoxRenderData * const data);
+
+    //! @brief Whether a raster drawn with instanceM keeps its sampling quality
+    static bool sQualityPreserved(const QMatrix& instanceM);
+private:
+    QList<stdptr<BoxRenderData>> mSources;
+};
+
+#endif // LINKRASTERINSTANCES_H
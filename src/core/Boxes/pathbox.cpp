@@ -28,17 +28,22 @@
 #include "RasterEffects/rastereffectcollection.h"
 #include "Animators/outlinesettingsanimator.h"
 #include "PathEffects/patheffectstask.h"
+#include "PathEffects/patheffectscache.h"
 #include "Private/Tasks/taskscheduler.h"
 #include "clipboardcontainer.h"
 #include "circle.h"
 #include "Boxes/smartvectorpath.h"
 
 PathBox::PathBox(const QString &name, const eBoxType type) :
-    BoxWithPathEffects(name, type) {
+    BoxWithPathEffects(name, type),
+    mPathEffectsCache(std::make_shared<PathEffectsCache>()) {
     connect(this, &eBoxOrSound::parentChanged, this, [this]() {
         setPathsOutdated(UpdateReason::userChange);
     });
 
+    connect(this, &Property::prp_absFrameRangeChanged,
+            this, &PathBox::clearArcLengthTables);
+
     connect(mPathEffectsAnimators.get(), &Property::prp_currentFrameChanged,
             this, [this](const UpdateReason reason) {
         setPathsOutdated(reason);
@@ -59,6 +64,17 @@ PathBox::PathBox(const QString &name, const eBoxType type) :
         setOutlinePathOutdated(reason);
     });
 
+    using Stage = PathEffectsCache::Stage;
+    const auto clearCacheOnChange = [this](PathEffectCollection* const effects,
+                                           const Stage stage) {
+        connect(effects, &Property::prp_absFrameRangeChanged,
+                this, [this, stage]() { mPathEffectsCache->clear(stage); });
+    };
+    clearCacheOnChange(mPathEffectsAnimators.get(), Stage::base);
+    clearCacheOnChange(mFillPathEffectsAnimators.get(), Stage::fill);
+    clearCacheOnChange(mOutlineBasePathEffectsAnimators.get(), Stage::outlineBase);
+    clearCacheOnChange(mOutlinePathEffectsAnimators.get(), Stage::outline);
+
     mFillSettings = enve::make_shared<FillSettingsAnimator>(this);
     mFillGradientPoints = mFillSettings->getGradientPoints();
     mStrokeSettings = enve::make_shared<OutlineSettingsAnimator>(this);
@@ -169,12 +185,38 @@ void PathBox::setupRenderData(const qreal relFrame, const QMatrix& parentM,
 
     if(!pathEffects.isEmpty() || !fillEffects.isEmpty() ||
        !outlineBaseEffects.isEmpty() || !outlineEffects.isEmpty()) {
-        const auto pathTask = enve::make_shared<PathEffectsTask>(
+        // results are memoized only for chains not affected by parent effects
+        const auto parent = getParentGroup();
+        using Stage = PathEffectsCache::Stage;
+        const auto lookup = [&](const bool skip, const bool parentHas,
+                                const Stage stage,
+                                PathEffectCollection* const effects) {
+            if(skip || parentHas) return PathEffectsCache::Lookup();
+            return PathEffectsCache::sLookup(
+                        mPathEffectsCache, stage, relFrame,
+                        [effects](const int frame1, const int frame2) {
+                return effects->prp_differencesBetweenRelFrames(frame1, frame2);
+            });
+        };
+        PathEffectsLookups lookups;
+        lookups.fBase = lookup(pathEffects.isEmpty(),
+                               parent && parent->hasBasePathEffects(),
+                               Stage::base, mPathEffectsAnimators.get());
+        lookups.fFill = lookup(fillEffects.isEmpty(),
+                               parent && parent->hasFillEffects(),
+                               Stage::fill, mFillPathEffectsAnimators.get());
+        lookups.fOutlineBase = lookup(outlineBaseEffects.isEmpty(),
+                                      parent && parent->hasOutlineBaseEffects(),
+                                      Stage::outlineBase,
+                                      mOutlineBasePathEffectsAnimators.get());
+        lookups.fOutline = lookup(outlineEffects.isEmpty(),
+                                  parent && parent->hasOutlineEffects(),
+                                  Stage::outline,
+                                  mOutlinePathEffectsAnimators.get());
+        PathEffectsTask::sQueTasks(
                     pathData, std::move(pathEffects), std::move(fillEffects),
-                    std::move(outlineBaseEffects), std::move(outlineEffects));
-        pathTask->addDependent(pathData);
-        pathData->delayDataSet();
-        pathTask->queTask();
+                    std::move(outlineBaseEffects), std::move(outlineEffects),
+                    std::move(lookups));
     }
 
     if(currentOutlinePathCompatible && currentFillPathCompatible) {
@@ -299,10 +341,39 @@ bool PathBox::differenceInOutlinePathBetweenFrames(const int frame1, const int f
 }
 
 void PathBox::setPathsOutdated(const UpdateReason reason) {
+    if(reason == UpdateReason::userChange) clearArcLengthTables();
     mCurrentPathsOutdated = true;
     planUpdate(reason);
 }
 
+void PathBox::clearArcLengthTables() {
+    std::lock_guard<std::mutex> lock(mArcLengthMutex);
+    mArcLengthTables.clear();
+}
+
+stdsptr<const ArcLengthTable> PathBox::getArcLengthTable(
+        const qreal relFrame) const {
+    {
+        std::lock_guard<std::mutex> lock(mArcLengthMutex);
+        const bool integral = isInteger4Dec(relFrame);
+        for(const auto& entry : mArcLengthTables) {
+            if(isZero4Dec(entry.fRelFrame - relFrame)) return entry.fTable;
+            if(!integral || !isInteger4Dec(entry.fRelFrame)) continue;
+            const int frame1 = qRound(entry.fRelFrame);
+            const int frame2 = qRound(relFrame);
+            if(!differenceInEditPathBetweenFrames(frame1, frame2))
+                return entry.fTable;
+        }
+    }
+    const auto table = std::make_shared<const ArcLengthTable>(
+                getRelativePath(relFrame));
+    std::lock_guard<std::mutex> lock(mArcLengthMutex);
+    if(mArcLengthTables.count() >= sMaxArcLengthTables)
+        mArcLengthTables.removeFirst();
+    mArcLengthTables.append({relFrame, table});
+    return table;
+}
+
 void PathBox::setOutlinePathOutdated(const UpdateReason reason) {
     mCurrentOutlinePathOutdated = true;
     planUpdate(reason);
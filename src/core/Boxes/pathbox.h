@@ -25,11 +25,15 @@
 #include "pathboxrenderdata.h"
 #include "libmypaintincludes.h"
 #include "Animators/qcubicsegment1danimator.h"
+#include "Segments/arclengthtable.h"
+
+#include <mutex>
 class SmartVectorPath;
 class GradientPoints;
 class SkStroke;
 class PathEffectCollection;
 class PathEffect;
+class PathEffectsCache;
 
 class CORE_EXPORT PathBox : public BoxWithPathEffects {
     typedef qCubicSegment1DAnimator::Action SegAction;
@@ -91,6 +95,9 @@ public:
     SkPath getAbsolutePath(const qreal relFrame) const;
     SkPath getAbsolutePath() const;
     const SkPath &getRelativePath() const;
+    //! @brief Arc-length table of getRelativePath(relFrame),
+    //! shared by all length-based consumers of this path
+    stdsptr<const ArcLengthTable> getArcLengthTable(const qreal relFrame) const;
     void setOutlineAffectedByScale(const bool bT);
 
     void copyDataToOperationResult(PathBox * const targetBox) const;
@@ -129,6 +136,20 @@ protected:
 
     qsptr<FillSettingsAnimator> mFillSettings;
     qsptr<OutlineSettingsAnimator> mStrokeSettings;
+private:
+    void clearArcLengthTables();
+
+    struct ArcLengthEntry {
+        qreal fRelFrame;
+        stdsptr<const ArcLengthTable> fTable;
+    };
+    static const int sMaxArcLengthTables = 8;
+
+    mutable std::mutex mArcLengthMutex;
+    mutable QList<ArcLengthEntry> mArcLengthTables;
+
+    //! @brief Results of this box' path effects, shared with PathEffectsTask
+    const stdsptr<PathEffectsCache> mPathEffectsCache;
 };
 
 #endif // PATHBOX_H
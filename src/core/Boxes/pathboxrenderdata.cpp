@@ -78,6 +78,12 @@ QPointF PathBoxRenderData::getCenterPosition() {
     return toQRectF(fEditPath.getBounds()).center();
 }
 
+bool PathBoxRenderData::supportsHighBitDepth() const {
+    if(fStrokeSettings.fPaintType == PaintType::BRUSHPAINT &&
+       !fOutlinePath.isEmpty()) return false;
+    return BoxRenderData::supportsHighBitDepth();
+}
+
 void PathBoxRenderData::drawSk(SkCanvas * const canvas) {
     SkPaint paint;
     paint.setAntiAlias(true);
@@ -34,6 +34,7 @@ struct CORE_EXPORT PathBoxRenderData : public BoxRenderData {
     void updateRelBoundingRect();
     QPointF getCenterPosition();
 protected:
+    bool supportsHighBitDepth() const;
     void setupRenderData();
     void drawSk(SkCanvas * const canvas);
     void drawOnParentLayer(SkCanvas * const canvas, SkPaint &paint);
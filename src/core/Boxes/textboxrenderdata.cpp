@@ -75,12 +75,9 @@ LetterRenderData::LetterRenderData(TextBox * const parent) :
 void LetterRenderData::afterQued() {
     if(!fPathEffects.isEmpty() || !fFillEffects.isEmpty() ||
        !fOutlineBaseEffects.isEmpty() || !fOutlineEffects.isEmpty()) {
-        const auto pathTask = enve::make_shared<PathEffectsTask>(
+        PathEffectsTask::sQueTasks(
                     this, std::move(fPathEffects), std::move(fFillEffects),
                     std::move(fOutlineBaseEffects), std::move(fOutlineEffects));
-        pathTask->addDependent(this);
-        this->delayDataSet();
-        pathTask->queTask();
     }
     BoxRenderData::afterQued();
 }
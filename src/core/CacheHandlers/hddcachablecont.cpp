@@ -15,6 +15,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "hddcachablecont.h"
+#include "diskcachehandler.h"
 
 HddCachableCont::HddCachableCont() {}
 
@@ -25,12 +26,14 @@ HddCachableCont::~HddCachableCont() {
 int HddCachableCont::free_RAM_k() {
     const int bytes = clearMemory();
     setDataInMemory(false);
-    if(!mTmpFile && !mTmpSaveTask) noDataLeft_k();
+    if(!mTmpFile && !mTmpSaveTask && !hasCompressedData()) noDataLeft_k();
     return bytes;
 }
 
 eTask *HddCachableCont::scheduleDeleteTmpFile() {
     if(!mTmpFile) return nullptr;
+    if(DiskCacheHandler::sInstance)
+        DiskCacheHandler::sInstance->removeContainer(this);
     const auto updatable = enve::make_shared<TmpDeleter>(mTmpFile);
     mTmpFile.reset();
     updatable->queTask();
@@ -47,8 +50,15 @@ eTask *HddCachableCont::scheduleSaveToTmpFile() {
 eTask *HddCachableCont::scheduleLoadFromTmpFile() {
     if(storesDataInMemory()) return nullptr;
     if(mTmpLoadTask) return mTmpLoadTask.get();
+    if(hasCompressedData()) {
+        mTmpLoadTask = createCompressedDataLoader();
+        mTmpLoadTask->queTask();
+        return mTmpLoadTask.get();
+    }
     if(!mTmpSaveTask && !mTmpFile) return nullptr;
 
+    if(DiskCacheHandler::sInstance)
+        DiskCacheHandler::sInstance->containerUsed(this);
     mTmpLoadTask = createTmpFileDataLoader();
     if(mTmpSaveTask)
         mTmpSaveTask->addDependent(mTmpLoadTask.get());
@@ -56,9 +66,25 @@ eTask *HddCachableCont::scheduleLoadFromTmpFile() {
     return mTmpLoadTask.get();
 }
 
-void HddCachableCont::setDataSavedToTmpFile(const qsptr<QTemporaryFile> &tmpFile) {
+void HddCachableCont::setDataSavedToTmpFile(const qsptr<QTemporaryFile> &tmpFile,
+                                            const qint64 bytes) {
     mTmpSaveTask.reset();
     mTmpFile = tmpFile;
+    if(DiskCacheHandler::sInstance)
+        DiskCacheHandler::sInstance->addContainer(this, bytes);
+}
+
+bool HddCachableCont::tmpFileDroppable() const {
+    return mTmpFile && !mTmpLoadTask && !inUse() && recomputable();
+}
+
+void HddCachableCont::dropTmpFile() {
+    const auto thisRef = ref<HddCachableCont>();
+    scheduleDeleteTmpFile();
+    if(!storesDataInMemory() && !mTmpSaveTask && !hasCompressedData()) {
+        removeFromMemoryManagment();
+        noDataLeft_k();
+    }
 }
 
 void HddCachableCont::afterDataLoadedFromTmpFile() {
@@ -21,11 +21,18 @@
 class eTask;
 
 class CORE_EXPORT HddCachableCont : public CacheContainer {
+    friend class DiskCacheHandler;
 protected:
     HddCachableCont();
     virtual int clearMemory() = 0;
     virtual stdsptr<eHddTask> createTmpFileDataSaver() = 0;
     virtual stdsptr<eHddTask> createTmpFileDataLoader() = 0;
+    //! @brief Optional in-RAM compressed tier, checked before the tmp file
+    virtual stdsptr<eTask> createCompressedDataLoader() { return nullptr; }
+    virtual bool hasCompressedData() const { return false; }
+    //! @brief Whether the data can be recomputed after
+    //! the tmp file is dropped to respect the disk cache cap
+    virtual bool recomputable() const { return false; }
 public:
     ~HddCachableCont();
 
@@ -35,7 +42,8 @@ public:
     eTask* scheduleSaveToTmpFile();
     eTask* scheduleLoadFromTmpFile();
 
-    void setDataSavedToTmpFile(const qsptr<QTemporaryFile> &tmpFile);
+    void setDataSavedToTmpFile(const qsptr<QTemporaryFile> &tmpFile,
+                               const qint64 bytes);
 
     bool storesDataInMemory() const { return mDataInMemory; }
     qsptr<QTemporaryFile> getTmpFile() const { return mTmpFile; }
@@ -46,6 +54,9 @@ protected:
 
     qsptr<QTemporaryFile> mTmpFile;
 private:
+    bool tmpFileDroppable() const;
+    void dropTmpFile();
+
     bool mDataInMemory = false;
     stdsptr<eTask> mTmpLoadTask;
     stdsptr<eTask> mTmpSaveTask;
@@ -29,6 +29,7 @@ protected:
                          HddCachableCacheHandler * const parent) :
         mRange(range), mParentCacheHandler_k(parent) {}
     virtual int clearMemory() = 0;
+    bool recomputable() const { return mParentCacheHandler_k; }
 public:
     void noDataLeft_k();
 
@@ -0,0 +1,225 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "persistentframecache.h"
+#include "sceneframecontainer.h"
+#include "Tasks/updatable.h"
+#include "Private/esettings.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QDateTime>
+
+#define FRAME_FILE_SUFFIX ".eframe"
+#define FRAME_FILE_MAGIC 0x65467231
+
+class PersistentFrameSaver : public eHddTask {
+    e_OBJECT
+protected:
+    using Func = std::function<void(const qint64 bytes)>;
+    PersistentFrameSaver(const QString& path,
+                         const sk_sp<SkImage>& image,
+                         const Func& finishedFunc) :
+        mPath(path), mImage(image), mFinishedFunc(finishedFunc) {}
+
+    void process() {
+        SkPixmap pixmap;
+        const auto raster = mImage->makeRasterImage();
+        mImage.reset();
+        if(!raster || !raster->peekPixels(&pixmap)) return;
+        // scene frames are rendered as kRGBA_8888
+        if(pixmap.colorType() != kRGBA_8888_SkColorType) return;
+        CompressedFrame frame;
+        compressFrame(pixmap, frame);
+        // written aside and renamed, partial files are never loaded
+        const QString partPath = mPath + ".part";
+        QFile file(partPath);
+        if(!file.open(QIODevice::WriteOnly)) return;
+        eWriteStream dst(&file);
+        dst << int(FRAME_FILE_MAGIC);
+        dst << frame.fInfo.width();
+        dst << frame.fInfo.height();
+        dst << int(pixmap.alphaType());
+        dst.write(frame.fData.constData(), frame.fData.size());
+        file.close();
+        QFile::remove(mPath);
+        if(!QFile::rename(partPath, mPath)) {
+            QFile::remove(partPath);
+            return;
+        }
+        mBytes = QFileInfo(mPath).size();
+    }
+
+    void afterProcessing() { mFinishedFunc(mBytes); }
+    void afterCanceled() { mFinishedFunc(0); }
+private:
+    const QString mPath;
+    sk_sp<SkImage> mImage;
+    const Func mFinishedFunc;
+    qint64 mBytes = 0;
+};
+
+class PersistentFrameLoader : public eHddTask {
+    e_OBJECT
+protected:
+    using Func = PersistentFrameCache::Loaded;
+    PersistentFrameLoader(const QString& path,
+                          const Func& finishedFunc) :
+        mPath(path), mFinishedFunc(finishedFunc) {}
+
+    void process() {
+        QFile file(mPath);
+        if(!file.open(QIODevice::ReadOnly)) return;
+        // the modification time orders files for eviction in later sessions
+        file.setFileTime(QDateTime::currentDateTime(),
+                         QFileDevice::FileModificationTime);
+        eReadStream src(&file);
+        int magic; src >> magic;
+        if(magic != FRAME_FILE_MAGIC) return;
+        int width; src >> width;
+        int height; src >> height;
+        int alphaType; src >> alphaType;
+        if(width <= 0 || height <= 0) return;
+        CompressedFrame frame;
+        frame.fInfo = SkImageInfo::Make(width, height, kRGBA_8888_SkColorType,
+                                        static_cast<SkAlphaType>(alphaType));
+        frame.fData = file.readAll();
+        file.close();
+        mImage = decompressFrame(frame);
+    }
+
+    void afterProcessing() { mFinishedFunc(mImage); }
+    void afterCanceled() { mFinishedFunc(nullptr); }
+private:
+    const QString mPath;
+    const Func mFinishedFunc;
+    sk_sp<SkImage> mImage;
+};
+
+PersistentFrameCache *PersistentFrameCache::sInstance = nullptr;
+
+PersistentFrameCache::PersistentFrameCache() {
+    Q_ASSERT(!sInstance);
+    sInstance = this;
+}
+
+PersistentFrameCache::~PersistentFrameCache() {
+    sInstance = nullptr;
+}
+
+bool PersistentFrameCache::sEnabled() {
+    return sInstance && eSettings::instance().fPersistentCache;
+}
+
+QString PersistentFrameCache::sKey(const QByteArray& contentHash,
+                                   const int rangeMin,
+                                   const qreal resolution) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(contentHash);
+    hash.addData(reinterpret_cast<const char*>(&rangeMin), sizeof(int));
+    hash.addData(reinterpret_cast<const char*>(&resolution), sizeof(qreal));
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString PersistentFrameCache::filePath(const QString& key) const {
+    return mFolder + "/" + key + FRAME_FILE_SUFFIX;
+}
+
+void PersistentFrameCache::updateFolder() {
+    const auto& settings = eSettings::instance();
+    QString folder = settings.fPersistentCacheFolder;
+    if(folder.isEmpty()) folder = settings.fUserSettingsDir + "/FrameCache";
+    if(folder == mFolder) return;
+    mFolder = folder;
+    mKeys.clear();
+    mBytes.clear();
+    mSaving.clear();
+    mUsedBytes = 0;
+    QDir dir(mFolder);
+    if(!dir.exists() && !QDir().mkpath(mFolder)) return;
+    const QStringList filters{QString("*") + FRAME_FILE_SUFFIX};
+    const auto files = dir.entryInfoList(filters, QDir::Files,
+                                         QDir::Time | QDir::Reversed);
+    for(const auto& file : files) {
+        addEntry(file.completeBaseName(), file.size());
+    }
+    applyCap();
+}
+
+bool PersistentFrameCache::contains(const QString& key) {
+    updateFolder();
+    return mBytes.contains(key);
+}
+
+void PersistentFrameCache::load(const QString& key, const Loaded& finished) {
+    if(!contains(key)) return finished(nullptr);
+    mKeys.removeOne(key);
+    mKeys.append(key);
+    const QString folder = mFolder;
+    const auto func = [key, folder, finished](const sk_sp<SkImage>& img) {
+        // unreadable files are dropped from the index
+        if(!img && sInstance && sInstance->mFolder == folder) {
+            QFile::remove(sInstance->filePath(key));
+            sInstance->removeEntry(key);
+        }
+        finished(img);
+    };
+    const auto task = enve::make_shared<PersistentFrameLoader>(
+                          filePath(key), func);
+    task->queTask();
+}
+
+void PersistentFrameCache::store(const QString& key,
+                                 const sk_sp<SkImage>& image) {
+    if(!image || contains(key) || mSaving.contains(key)) return;
+    mSaving << key;
+    const QString folder = mFolder;
+    const auto finished = [key, folder](const qint64 bytes) {
+        if(!sInstance || sInstance->mFolder != folder) return;
+        sInstance->mSaving.remove(key);
+        if(bytes > 0) sInstance->addEntry(key, bytes);
+        sInstance->applyCap();
+    };
+    const auto task = enve::make_shared<PersistentFrameSaver>(
+                          filePath(key), image, finished);
+    task->queTask();
+}
+
+void PersistentFrameCache::addEntry(const QString& key, const qint64 bytes) {
+    removeEntry(key);
+    mKeys.append(key);
+    mBytes.insert(key, bytes);
+    mUsedBytes += bytes;
+}
+
+void PersistentFrameCache::removeEntry(const QString& key) {
+    const auto it = mBytes.find(key);
+    if(it == mBytes.end()) return;
+    mUsedBytes -= it.value();
+    mBytes.erase(it);
+    mKeys.removeOne(key);
+}
+
+void PersistentFrameCache::applyCap() {
+    const qint64 capMB = eSettings::instance().fPersistentCacheMBCap.fValue;
+    if(capMB <= 0) return;
+    const qint64 capBytes = capMB*1024*1024;
+    while(mUsedBytes > capBytes && mKeys.count() > 1) {
+        const QString key = mKeys.first();
+        QFile::remove(filePath(key));
+        removeEntry(key);
+    }
+}
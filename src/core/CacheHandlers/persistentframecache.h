@@ -0,0 +1,65 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef PERSISTENTFRAMECACHE_H
+#define PERSISTENTFRAMECACHE_H
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <functional>
+
+#include "skia/skiaincludes.h"
+#include "core_global.h"
+
+//! @brief Keeps rendered scene frames on disk between sessions,
+//! under a key derived from the scene content hash.
+//! Files are evicted least recently used first
+//! to stay within eSettings::fPersistentCacheMBCap.
+class CORE_EXPORT PersistentFrameCache {
+public:
+    PersistentFrameCache();
+    ~PersistentFrameCache();
+
+    static PersistentFrameCache *sInstance;
+
+    static bool sEnabled();
+    static QString sKey(const QByteArray& contentHash,
+                        const int rangeMin, const qreal resolution);
+
+    using Loaded = std::function<void(const sk_sp<SkImage>& img)>;
+
+    bool contains(const QString& key);
+    //! @brief Schedules loading, finished gets nullptr on failure
+    void load(const QString& key, const Loaded& finished);
+    void store(const QString& key, const sk_sp<SkImage>& image);
+
+    qint64 usedBytes() const { return mUsedBytes; }
+private:
+    QString filePath(const QString& key) const;
+    void updateFolder();
+    void addEntry(const QString& key, const qint64 bytes);
+    void removeEntry(const QString& key);
+    void applyCap();
+
+    QString mFolder;
+    //! @brief Least recently used first
+    QStringList mKeys;
+    QHash<QString, qint64> mBytes;
+    QSet<QString> mSaving;
+    qint64 mUsedBytes = 0;
+};
+
+#endif // PERSISTENTFRAMECACHE_H
@@ -87,8 +87,30 @@ protected:
     }
 
     Samples(const stdsptr<Samples>& src) : Samples(src.get()) {}
+
+    //! @brief Read-only view of range, shares the buffers of base
+    Samples(const stdsptr<const Samples>& base,
+            const SampleRange& range) :
+        Samples(nullptr, range, base->fSampleRate,
+                base->fFormat, base->fChannelLayout) {
+        mBase = base->mBase ? base->mBase : base;
+        const auto displ = static_cast<ulong>(range.fMin - base->fSampleRange.fMin)*fSampleSize;
+        if(fPlanar) {
+            fData = new uchar*[fNChannels];
+            for(uint i = 0; i < fNChannels; i++) {
+                fData[i] = base->fData[i] + displ;
+            }
+        } else {
+            fData = new uchar*[1];
+            fData[0] = base->fData[0] + displ*fNChannels;
+        }
+    }
 public:
     ~Samples() {
+        if(mBase) {
+            delete[] fData;
+            return;
+        }
         if(fPlanar) {
             for(uint i = 0; i < fNChannels; i++)
                 delete[] fData[i];
@@ -133,6 +155,20 @@ public:
     const SampleRange fSampleRange;
     uchar ** fData;
 
+    //! @brief True if the buffers are shared with other Samples,
+    //! views have to be treated as read-only
+    bool isView() const { return static_cast<bool>(mBase); }
+
+    //! @brief Reference-counted view of range without copying any data
+    stdsptr<Samples> slice(const SampleRange& range) const {
+        if(!range.isValid()) RuntimeThrow("Invalid range");
+        if(range.fMin < fSampleRange.fMin ||
+           range.fMax > fSampleRange.fMax)
+            RuntimeThrow("Range outside bounds");
+        return enve::make_shared<Samples>(ref<const Samples>(), range);
+    }
+
+    //! @brief Deep copy of range
     stdsptr<Samples> mid(const SampleRange& range) const {
         if(!range.isValid()) RuntimeThrow("Invalid range");
         if(range.fMin < fSampleRange.fMin ||
@@ -161,6 +197,9 @@ public:
     void write(eWriteStream& dst) const;
 
     static stdsptr<Samples> sRead(eReadStream& src);
+private:
+    //! @brief Owner of the buffers for views, null otherwise
+    stdsptr<const Samples> mBase;
 };
 
 #endif // SAMPLES_H
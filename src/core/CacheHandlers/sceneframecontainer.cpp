@@ -17,6 +17,96 @@
 #include "sceneframecontainer.h"
 #include "../Boxes/boxrenderdata.h"
 #include "../canvas.h"
+#include "Private/esettings.h"
+#include "memorydatahandler.h"
+
+// Delta against the previous pixel makes flat and gradient areas
+// compress well even at the fastest zlib level
+void compressFrame(const SkPixmap& src, CompressedFrame& dst) {
+    const int width = src.width();
+    const int height = src.height();
+    const int bpp = src.info().bytesPerPixel();
+    const int rowBytes = width*bpp;
+    QByteArray filtered(rowBytes*height, Qt::Uninitialized);
+    for(int y = 0; y < height; y++) {
+        const auto srcLine = static_cast<const uchar*>(src.addr(0, y));
+        auto dstLine = reinterpret_cast<uchar*>(filtered.data() + y*rowBytes);
+        for(int i = 0; i < bpp; i++) dstLine[i] = srcLine[i];
+        for(int i = bpp; i < rowBytes; i++) {
+            dstLine[i] = static_cast<uchar>(srcLine[i] - srcLine[i - bpp]);
+        }
+    }
+    dst.fInfo = src.info();
+    dst.fData = qCompress(filtered, 1);
+}
+
+sk_sp<SkImage> decompressFrame(const CompressedFrame& src) {
+    QByteArray data = qUncompress(src.fData);
+    const int bpp = src.fInfo.bytesPerPixel();
+    const int rowBytes = src.fInfo.width()*bpp;
+    if(data.size() != rowBytes*src.fInfo.height()) return nullptr;
+    auto bytes = reinterpret_cast<uchar*>(data.data());
+    for(int y = 0; y < src.fInfo.height(); y++) {
+        const auto line = bytes + y*rowBytes;
+        for(int i = bpp; i < rowBytes; i++) {
+            line[i] = static_cast<uchar>(line[i] + line[i - bpp]);
+        }
+    }
+    SkBitmap bitmap;
+    bitmap.allocPixels(src.fInfo);
+    const auto dst = static_cast<uchar*>(bitmap.getPixels());
+    for(int y = 0; y < src.fInfo.height(); y++) {
+        memcpy(dst + y*bitmap.rowBytes(), bytes + y*rowBytes,
+               static_cast<size_t>(rowBytes));
+    }
+    return SkiaHelpers::transferDataToSkImage(bitmap);
+}
+
+class FrameCompressor : public eCpuTask {
+    e_OBJECT
+protected:
+    using Func = std::function<void(const bool success)>;
+    FrameCompressor(const sk_sp<SkImage>& image,
+                    const stdsptr<CompressedFrame>& target,
+                    const Func& finishedFunc) :
+        mImage(image), mTarget(target), mFinishedFunc(finishedFunc) {}
+
+    void process() {
+        SkPixmap pixmap;
+        const auto raster = mImage->makeRasterImage();
+        mImage.reset();
+        if(!raster || !raster->peekPixels(&pixmap)) return;
+        // scene frames are rendered as kRGBA_8888 or kRGBA_F16
+        if(pixmap.colorType() != kRGBA_8888_SkColorType &&
+           pixmap.colorType() != kRGBA_F16_SkColorType) return;
+        compressFrame(pixmap, *mTarget);
+        mSuccess = true;
+    }
+
+    void afterProcessing() { mFinishedFunc(mSuccess); }
+    void afterCanceled() { mFinishedFunc(false); }
+private:
+    sk_sp<SkImage> mImage;
+    const stdsptr<CompressedFrame> mTarget;
+    const Func mFinishedFunc;
+    bool mSuccess = false;
+};
+
+class FrameDecompressor : public eCpuTask {
+    e_OBJECT
+protected:
+    using Func = std::function<void(const sk_sp<SkImage>& img)>;
+    FrameDecompressor(const stdsptr<CompressedFrame>& src,
+                      const Func& finishedFunc) :
+        mSrc(src), mFinishedFunc(finishedFunc) {}
+
+    void process() { mImage = decompressFrame(*mSrc); }
+    void afterProcessing() { mFinishedFunc(mImage); }
+private:
+    const stdsptr<CompressedFrame> mSrc;
+    const Func mFinishedFunc;
+    sk_sp<SkImage> mImage;
+};
 
 SceneFrameContainer::SceneFrameContainer(
         Canvas * const scene,
@@ -28,6 +118,87 @@ SceneFrameContainer::SceneFrameContainer(
     fResolution(data->fResolution),
     mScene(scene) {}
 
+SceneFrameContainer::SceneFrameContainer(
+        Canvas * const scene,
+        const sk_sp<SkImage>& image,
+        const uint boxState,
+        const qreal resolution,
+        const FrameRange &range,
+        HddCachableCacheHandler * const parent) :
+    ImageCacheContainer(image, range, parent),
+    fBoxState(boxState),
+    fResolution(resolution),
+    mScene(scene) {}
+
+int SceneFrameContainer::getByteCount() {
+    const int compressed = mCompressed ? mCompressed->fData.size() : 0;
+    if(storesDataInMemory()) return getImageByteCount() + compressed;
+    return compressed;
+}
+
+int SceneFrameContainer::clearMemory() {
+    if(!storesDataInMemory()) {
+        // second eviction drops the compressed copy as well
+        const int bytes = getByteCount();
+        mCompressed.reset();
+        return bytes;
+    }
+    const bool compress = !mCompressed &&
+            eSettings::instance().fRamCacheCompression &&
+            MemoryDataHandler::sInstance->compressEvicted();
+    if(compress && scheduleCompress()) {
+        // the compressor holds on to the image until it is done,
+        // nothing is freed yet
+        ImageCacheContainer::clearMemory();
+        return 0;
+    }
+    return ImageCacheContainer::clearMemory();
+}
+
+bool SceneFrameContainer::hasCompressedData() const {
+    return mCompressed.get();
+}
+
+bool SceneFrameContainer::scheduleCompress() {
+    const auto image = getImage();
+    if(!image) return false;
+    mCompressed = std::make_shared<CompressedFrame>();
+    const stdptr<SceneFrameContainer> ptr = this;
+    const auto func = [ptr](const bool success) {
+        if(ptr) ptr->compressFinished(success);
+    };
+    mCompressTask = enve::make_shared<FrameCompressor>(image, mCompressed, func);
+    mCompressTask->queTask();
+    return true;
+}
+
+void SceneFrameContainer::compressFinished(const bool success) {
+    mCompressTask.reset();
+    if(!mCompressed) return;
+    if(!success) {
+        mCompressed.reset();
+        if(!storesDataInMemory() && !mTmpFile) noDataLeft_k();
+        return;
+    }
+    // the compressed copy is accounted for until evicted again
+    if(!storesDataInMemory()) addToMemoryManagment();
+}
+
+stdsptr<eTask> SceneFrameContainer::createCompressedDataLoader() {
+    const stdptr<SceneFrameContainer> ptr = this;
+    const auto func = [ptr](const sk_sp<SkImage>& img) {
+        if(!ptr) return;
+        if(!img) return ptr->noDataLeft_k();
+        ptr->setDataLoadedFromTmpFile(img);
+        if(ptr->mScene) {
+            ptr->mScene->setSceneFrame(ptr->ref<SceneFrameContainer>());
+        }
+    };
+    const auto loader = enve::make_shared<FrameDecompressor>(mCompressed, func);
+    if(mCompressTask) mCompressTask->addDependent(loader.get());
+    return loader;
+}
+
 stdsptr<eHddTask> SceneFrameContainer::createTmpFileDataLoader() {
     const ImgLoader::Func func = [this](sk_sp<SkImage> img) {
         setDataLoadedFromTmpFile(img);
@@ -19,19 +19,44 @@
 #include "imagecachecontainer.h"
 struct BoxRenderData;
 
+//! @brief Losslessly compressed copy of a scene frame kept in RAM
+struct CompressedFrame {
+    SkImageInfo fInfo;
+    QByteArray fData;
+};
+
+void compressFrame(const SkPixmap& src, CompressedFrame& dst);
+sk_sp<SkImage> decompressFrame(const CompressedFrame& src);
+
 class CORE_EXPORT SceneFrameContainer : public ImageCacheContainer {
 public:
     SceneFrameContainer(Canvas * const scene,
                         const BoxRenderData* const data,
                         const FrameRange &range,
                         HddCachableCacheHandler * const parent);
+    SceneFrameContainer(Canvas * const scene,
+                        const sk_sp<SkImage>& image,
+                        const uint boxState,
+                        const qreal resolution,
+                        const FrameRange &range,
+                        HddCachableCacheHandler * const parent);
+
+    int getByteCount();
 
     uint fBoxState;
     const qreal fResolution;
 protected:
+    int clearMemory();
     stdsptr<eHddTask> createTmpFileDataLoader();
+    stdsptr<eTask> createCompressedDataLoader();
+    bool hasCompressedData() const;
 private:
+    bool scheduleCompress();
+    void compressFinished(const bool success);
+
     const qptr<Canvas> mScene;
+    stdsptr<CompressedFrame> mCompressed;
+    stdsptr<eTask> mCompressTask;
 };
 
 #endif // SCENEFRAMECONTAINER_H
@@ -15,15 +15,21 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "tmpsaver.h"
+#include "diskcachehandler.h"
 
 TmpSaver::TmpSaver(HddCachableCont* const target) :
-    mTarget(target) {}
+    mTarget(target), mFileTemplate(DiskCacheHandler::sTmpFileTemplate()) {}
 
 void TmpSaver::process() {
-    mTmpFile = qsptr<QTemporaryFile>(new QTemporaryFile());
+    if(mFileTemplate.isEmpty()) {
+        mTmpFile = qsptr<QTemporaryFile>(new QTemporaryFile());
+    } else {
+        mTmpFile = qsptr<QTemporaryFile>(new QTemporaryFile(mFileTemplate));
+    }
     if(mTmpFile->open()) {
         eWriteStream dst(mTmpFile.get());
         write(dst);
+        mBytesWritten = mTmpFile->size();
         mTmpFile->close();
         mSavingSuccessful = true;
     } else {
@@ -34,5 +40,5 @@ void TmpSaver::process() {
 void TmpSaver::afterProcessing() {
     if(!mTarget) return;
     if(!mSavingSuccessful) return;
-    mTarget->setDataSavedToTmpFile(mTmpFile);
+    mTarget->setDataSavedToTmpFile(mTmpFile, mBytesWritten);
 }
@@ -31,7 +31,9 @@ public:
     void afterProcessing();
 private:
     const stdptr<HddCachableCont> mTarget;
+    const QString mFileTemplate;
     bool mSavingSuccessful = false;
+    qint64 mBytesWritten = 0;
     qsptr<QTemporaryFile> mTmpFile;
 };
 
@@ -14,7 +14,7 @@ void SoundReaderForMerger::afterProcessing() {
         for(const auto& ss : mSSAbsRanges) {
             merger->addSoundToMerge({ss.fSampleShift, ss.fSamplesRange,
                                      ss.fVolume, ss.fSpeed,
-                                     enve::make_shared<Samples>(getSamples())});
+                                     getSamples()});
         }
     }
     SoundReader::afterProcessing();
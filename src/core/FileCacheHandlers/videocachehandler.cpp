@@ -26,7 +26,7 @@
 
 VideoFrameHandler::VideoFrameHandler(VideoDataHandler * const cacheHandler) :
     mDataHandler(cacheHandler) {
-    openVideoStream();
+    if(mDataHandler->getFrameCount() <= 0) openVideoStream();
 }
 
 ImageCacheContainer* VideoFrameHandler::getFrameAtFrame(const int relFrame) {
@@ -66,7 +66,7 @@ VideoFrameLoader *VideoFrameHandler::getFrameLoader(const int frame) {
 
 VideoFrameLoader *VideoFrameHandler::addFrameLoader(const int frameId) {
     const auto loader = enve::make_shared<VideoFrameLoader>(
-                    this, mVideoStreamsData, frameId);
+                    this, videoStreamsData(), frameId);
     mDataHandler->addFrameLoader(frameId, loader);
     for(const auto& nFrame : mNeededFrames) {
         const auto nLoader = getFrameLoader(nFrame);
@@ -81,7 +81,7 @@ VideoFrameLoader *VideoFrameHandler::addFrameLoader(const int frameId) {
 VideoFrameLoader *VideoFrameHandler::addFrameConverter(
         const int frameId,  AVFrame * const frame) {
     const auto loader = enve::make_shared<VideoFrameLoader>(
-                    this, mVideoStreamsData, frameId, frame);
+                    this, videoStreamsData(), frameId, frame);
     mDataHandler->addFrameLoader(frameId, loader);
     return loader.get();
 }
@@ -97,6 +97,14 @@ void VideoFrameHandler::openVideoStream() {
     mDataHandler->setFrameCount(mVideoStreamsData->fFrameCount);
 }
 
+const stdsptr<VideoStreamsData>& VideoFrameHandler::videoStreamsData() {
+    if(!mVideoStreamsData) {
+        const auto filePath = mDataHandler->getFilePath();
+        mVideoStreamsData = VideoStreamsData::sOpen(filePath);
+    }
+    return mVideoStreamsData;
+}
+
 eTask* VideoFrameHandler::scheduleFrameLoad(const int frame) {
     if(frame < 0 || frame >= getFrameCount())
         RuntimeThrow("Frame outside of range " + std::to_string(frame));
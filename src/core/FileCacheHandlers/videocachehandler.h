@@ -83,6 +83,9 @@ protected:
     void removeFrameLoader(const int frame);
 
     void openVideoStream();
+    //! @brief Streams are opened on the first frame load,
+    //! the frame count is shared through the VideoDataHandler
+    const stdsptr<VideoStreamsData>& videoStreamsData();
 private:
     std::set<int> mNeededFrames;
 
@@ -22,9 +22,12 @@
 
 #include "exceptions.h"
 #include "oraparser.h"
+#include "parallelfor.h"
 
 #include <QSvgRenderer>
 
+#include <map>
+
 void applyAttributesToBox(OraElement& ele, BoundingBox& box) {
     box.prp_setName(ele.fName);
     box.setRelativePos(QPointF(ele.fX, ele.fY));
@@ -41,11 +44,50 @@ qsptr<TextBox> textToBox(OraText& text) {
     return result;
 }
 
-qsptr<BoundingBox> layerPNGToBox(OraLayerPNG_Qt& layer) {
+using DecodedLayers = std::map<const OraLayerPNG_Raw*,
+                                stdsptr<UndoableAutoTiledSurface>>;
+
+void collectLayersPNG(OraStack_Raw& stack, QList<OraLayerPNG_Raw*>& layers) {
+    for(const auto& child : stack.fChildren) {
+        switch(child->fType) {
+        case OraElementType::stack:
+            collectLayersPNG(static_cast<OraStack_Raw&>(*child), layers);
+            break;
+        case OraElementType::layerPNG:
+            layers << static_cast<OraLayerPNG_Raw*>(child.get());
+            break;
+        default: break;
+        }
+    }
+}
+
+//! @brief Decodes all png layers in parallel directly into tiles
+DecodedLayers decodeLayersPNG(OraStack_Raw& stack) {
+    QList<OraLayerPNG_Raw*> layers;
+    collectLayersPNG(stack, layers);
+    std::vector<stdsptr<UndoableAutoTiledSurface>> surfaces(layers.count());
+    ParallelFor::run(layers.count(), [&layers, &surfaces](const int i) {
+        const auto layer = layers.at(i);
+        const auto surface = std::make_shared<UndoableAutoTiledSurface>();
+        const auto& qData = layer->fImage;
+        const auto data = SkData::MakeWithoutCopy(qData.data(), qData.size());
+        if(!surface->loadEncoded(data))
+            RuntimeThrow("Decoding png layer failed");
+        layer->fImage.clear();
+        surfaces[i] = surface;
+    });
+    DecodedLayers result;
+    for(int i = 0; i < layers.count(); i++) {
+        result[layers.at(i)] = surfaces[i];
+    }
+    return result;
+}
+
+qsptr<BoundingBox> layerPNGToBox(OraLayerPNG_Raw& layer,
+                                 const DecodedLayers& decoded) {
     const auto result = enve::make_shared<PaintBox>();
     const auto surf = result->getSurface()->getCurrentSurface();
-    if(layer.fImage.isNull()) RuntimeThrow("Decoding png layer failed");
-    surf->loadPixmap(layer.fImage);
+    surf->loadSurface(*decoded.at(&layer));
     if(result) applyAttributesToBox(layer, *result);
     return result;
 }
@@ -57,7 +99,8 @@ qsptr<BoundingBox> layerSVGToBox(OraLayerSVG& layer,
     return result;
 }
 
-qsptr<ContainerBox> stackToBox(OraStack_Qt& stack,
+qsptr<ContainerBox> stackToBox(OraStack_Raw& stack,
+                               const DecodedLayers& decoded,
                                const GradientCreator& gradientCreator) {
     const auto result = enve::make_shared<ContainerBox>(eBoxType::layer);
     applyAttributesToBox(stack, *result);
@@ -66,14 +109,15 @@ qsptr<ContainerBox> stackToBox(OraStack_Qt& stack,
         const auto type = child->fType;
         switch(type) {
         case OraElementType::stack:
-            childBox = stackToBox(static_cast<OraStack_Qt&>(*child),
-                                  gradientCreator);
+            childBox = stackToBox(static_cast<OraStack_Raw&>(*child),
+                                  decoded, gradientCreator);
             break;
         case OraElementType::text:
             childBox = textToBox(static_cast<OraText&>(*child));
             break;
         case OraElementType::layerPNG:
-            childBox = layerPNGToBox(static_cast<OraLayerPNG_Qt&>(*child));
+            childBox = layerPNGToBox(static_cast<OraLayerPNG_Raw&>(*child),
+                                     decoded);
             break;
         case OraElementType::layerSVG:
             childBox = layerSVGToBox(static_cast<OraLayerSVG&>(*child),
@@ -91,8 +135,9 @@ qsptr<ContainerBox> stackToBox(OraStack_Qt& stack,
 
 qsptr<ContainerBox> ImportORA::loadORAFile(
         const QString &filename, const GradientCreator& gradientCreator) {
-    const auto oraImg = ImportORA::readOraFileQImage(filename);
-    return stackToBox(*oraImg, gradientCreator);
+    const auto oraImg = ImportORA::readOraFileRaw(filename);
+    const auto decoded = decodeLayersPNG(*oraImg);
+    return stackToBox(*oraImg, decoded, gradientCreator);
 }
 
 void setupPaint(OraElement& element, SkPaint& paint) {
@@ -19,6 +19,7 @@
 #include <QtXml/QDomDocument>
 
 #include "zipfileloader.h"
+#include "parallelfor.h"
 #include "XML/xmlexporthelpers.h"
 
 void parseOraElementAttributes(OraElement& oraEle,
@@ -178,18 +179,36 @@ std::shared_ptr<OraImage_XX> readStackXml(ZipFileLoader& fileProcessor) {
 }
 
 
-void loadLayerSourcePNG(OraLayerPNG_Sk& layer, ZipFileLoader& fileProcessor) {
+using LayerDecoders = QList<std::function<void()>>;
+
+void loadLayerSourcePNG(OraLayerPNG_Sk& layer, ZipFileLoader& fileProcessor,
+                        LayerDecoders& decoders) {
+    QByteArray qData;
     fileProcessor.process(layer.fSource, [&](QIODevice* const src) {
-        const QByteArray qData = src->readAll();
+        qData = src->readAll();
+    });
+    decoders << [&layer, qData]() {
         const auto data = SkData::MakeWithoutCopy(qData.data(), qData.size());
         layer.fImage = SkImage::DecodeToRaster(data);
-    });
+    };
 }
 
-void loadLayerSourcePNG(OraLayerPNG_Qt& layer, ZipFileLoader& fileProcessor) {
+void loadLayerSourcePNG(OraLayerPNG_Qt& layer, ZipFileLoader& fileProcessor,
+                        LayerDecoders& decoders) {
+    QByteArray qData;
     fileProcessor.process(layer.fSource, [&](QIODevice* const src) {
-        const QByteArray qData = src->readAll();
+        qData = src->readAll();
+    });
+    decoders << [&layer, qData]() {
         layer.fImage.loadFromData(qData);
+    };
+}
+
+void loadLayerSourcePNG(OraLayerPNG_Raw& layer, ZipFileLoader& fileProcessor,
+                        LayerDecoders& decoders) {
+    Q_UNUSED(decoders)
+    fileProcessor.process(layer.fSource, [&](QIODevice* const src) {
+        layer.fImage = src->readAll();
     });
 }
 
@@ -201,15 +220,17 @@ void loadLayerSourceSVG(OraLayerSVG& layer, ZipFileLoader& fileProcessor) {
 
 template <typename OraLayerPNG_XX,
           typename OraStack_XX = OraStack<OraLayerPNG_XX>>
-void loadLayerSourceFiles(OraStack_XX& stack, ZipFileLoader& fileProcessor) {
+void loadLayerSourceFiles(OraStack_XX& stack, ZipFileLoader& fileProcessor,
+                          LayerDecoders& decoders) {
     for(const auto& child : stack.fChildren) {
         switch(child->fType) {
         case OraElementType::stack:
             loadLayerSourceFiles<OraLayerPNG_XX>(static_cast<OraStack_XX&>(*child),
-                                                 fileProcessor);
+                                                 fileProcessor, decoders);
             break;
         case OraElementType::layerPNG:
-            loadLayerSourcePNG(static_cast<OraLayerPNG_XX&>(*child), fileProcessor);
+            loadLayerSourcePNG(static_cast<OraLayerPNG_XX&>(*child),
+                               fileProcessor, decoders);
             break;
         case OraElementType::layerSVG:
             loadLayerSourceSVG(static_cast<OraLayerSVG&>(*child), fileProcessor);
@@ -225,7 +246,13 @@ std::shared_ptr<OraImage<OraLayerPNG_XX>> readOraFile(const QString &filename) {
     fileProcessor.setZipPath(filename);
 
     const auto result = readStackXml<OraLayerPNG_XX>(fileProcessor);
-    if(result) loadLayerSourceFiles<OraLayerPNG_XX>(*result, fileProcessor);
+    if(!result) return result;
+    // zip entries are read in order, layers are decoded in parallel
+    LayerDecoders decoders;
+    loadLayerSourceFiles<OraLayerPNG_XX>(*result, fileProcessor, decoders);
+    ParallelFor::run(decoders.count(), [&decoders](const int i) {
+        decoders.at(i)();
+    });
     return result;
 }
 
@@ -237,6 +264,10 @@ std::shared_ptr<OraImage_Sk> ImportORA::readOraFileSkImage(const QString &filena
     return readOraFile<OraLayerPNG_Sk>(filename);
 }
 
+std::shared_ptr<OraImage_Raw> ImportORA::readOraFileRaw(const QString &filename) {
+    return readOraFile<OraLayerPNG_Raw>(filename);
+}
+
 sk_sp<SkImage> ImportORA::loadContainedMerged(const QString &filename) {
     ZipFileLoader fileProcessor;
     fileProcessor.setZipPath(filename);
@@ -24,6 +24,9 @@ namespace ImportORA {
     std::shared_ptr<OraImage_Qt> readOraFileQImage(const QString &filename);
     CORE_EXPORT
     std::shared_ptr<OraImage_Sk> readOraFileSkImage(const QString &filename);
+    //! @brief Layer PNGs are left encoded
+    CORE_EXPORT
+    std::shared_ptr<OraImage_Raw> readOraFileRaw(const QString &filename);
     CORE_EXPORT
     sk_sp<SkImage> loadContainedMerged(const QString &filename);
 }
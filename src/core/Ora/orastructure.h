@@ -64,6 +64,7 @@ struct OraLayerPNG : public OraLayer {
 
 using OraLayerPNG_Qt = OraLayerPNG<QImage>;
 using OraLayerPNG_Sk = OraLayerPNG<sk_sp<SkImage>>;
+using OraLayerPNG_Raw = OraLayerPNG<QByteArray>;
 
 struct CORE_EXPORT OraLayerSVG : public OraLayer {
     OraLayerSVG() : OraLayer(OraElementType::layerSVG) {}
@@ -96,6 +97,7 @@ struct OraStack : public OraElement {
 
 using OraStack_Qt = OraStack<OraLayerPNG_Qt>;
 using OraStack_Sk = OraStack<OraLayerPNG_Sk>;
+using OraStack_Raw = OraStack<OraLayerPNG_Raw>;
 
 template <typename OraLayerPNG_XX>
 struct OraImage : public OraStack<OraLayerPNG_XX> {
@@ -107,5 +109,6 @@ struct OraImage : public OraStack<OraLayerPNG_XX> {
 
 using OraImage_Qt = OraImage<OraLayerPNG_Qt>;
 using OraImage_Sk = OraImage<OraLayerPNG_Sk>;
+using OraImage_Raw = OraImage<OraLayerPNG_Raw>;
 
 #endif // ORASTRUCTURE_H
@@ -71,7 +71,7 @@ void AnimatedSurface::prp_readProperty_impl(eReadStream& src) {
 void AnimatedSurface::prp_writeProperty_impl(eWriteStream& dst) const {
     Animator::prp_writeProperty_impl(dst);
     anim_writeKeys(dst);
-    mBaseValue->write(dst);
+    if(!dst.fingerprint() || !anim_hasKeys()) mBaseValue->write(dst);
 }
 
 void savePaintImageXEV(const QString& path, const XevExporter& exp,
@@ -76,6 +76,7 @@ public:
                                        absFrameRange,
                                        rowHeight);
     }
+    bool prp_timelineControlsCachable() const { return false; }
 
     FrameRange prp_getIdenticalRelRange(const int relFrame) const {
         const auto at = anim_getKeyAtRelFrame(relFrame);
@@ -51,6 +51,9 @@ public:
     void setPixelClamp(const QRect& pixRect);
     void loadPixmap(const SkPixmap &src);
     void loadPixmap(const QImage &src);
+    bool loadEncoded(const sk_sp<SkData>& data) {
+        return mAutoTilesData.loadEncoded(data);
+    }
 
     MyPaintRectangle paintPressEvent(MyPaintBrush * const brush,
                                      const QPointF& pos,
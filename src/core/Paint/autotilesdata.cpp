@@ -20,6 +20,9 @@
 
 #include "exceptions.h"
 #include "skia/skiahelpers.h"
+#include "include/codec/SkCodec.h"
+#include "include/private/SkNx.h"
+#include "include/private/SkHalf.h"
 
 AutoTilesData::AutoTilesData(const TileCreator& tileCreator) :
     mTileCreator(tileCreator) {}
@@ -174,42 +177,51 @@ void premul_16_to_15(uint16_t const *& srcLine, uint16_t*& dstLine) {
     *dstLine++ = (a * (1<<15) + USHRT_MAX/2) / USHRT_MAX;
 }
 
-template <typename Addr, void (*To15Bit)(Addr const *& srcLine, uint16_t*& dstLine)>
-void AutoTilesData::loadPixmap(const Addr * const src, const int width, const int height) {
+void AutoTilesData::startLoading(const int width) {
     clear();
     const int nCols = qCeil(static_cast<qreal>(width)/TILE_SIZE);
-    const int nRows = qCeil(static_cast<qreal>(height)/TILE_SIZE);
-
     for(int col = 0; col < nCols; col++) {
-        const bool lastCol = col == (nCols - 1);
+        mColumns << QList<stdsptr<Tile>>();
+    }
+    mColumnCount = nCols;
+}
+
+template <typename Addr, void (*To15Bit)(Addr const *& srcLine, uint16_t*& dstLine)>
+void AutoTilesData::appendTileRow(const Addr * const src,
+                                  const int width, const int height,
+                                  const bool lastRow) {
+    for(int col = 0; col < mColumnCount; col++) {
+        const bool lastCol = col == (mColumnCount - 1);
         const int x0 = col*TILE_SIZE;
         const int maxX = qMin(x0 + TILE_SIZE, width);
-        QList<stdsptr<Tile>> colRows;
-        for(int row = 0; row < nRows; row++) {
-            const auto tile = mTileCreator(TILE_SPIXEL_SIZE);
-
-            const bool lastRow = row == (nRows - 1);
-            const bool iniZeroed = lastCol || lastRow;
-            if(iniZeroed) tile->zeroData();
-            const auto tileP = tile->requestData();
-
-            const int y0 = row*TILE_SIZE;
-            const int maxY = qMin(y0 + TILE_SIZE, height);
-            for(int y = y0; y < maxY; y++) {
-                const Addr * srcLine = src + (y*width + x0)*4;
-                uint16_t* dstLine = tileP + (y - y0)*TILE_SIZE*4;
-                for(int x = x0; x < maxX; x++) {
-                    To15Bit(srcLine, dstLine);
-                }
+        const auto tile = mTileCreator(TILE_SPIXEL_SIZE);
+
+        const bool iniZeroed = lastCol || lastRow;
+        if(iniZeroed) tile->zeroData();
+        const auto tileP = tile->requestData();
+
+        for(int y = 0; y < height; y++) {
+            const Addr * srcLine = src + (y*width + x0)*4;
+            uint16_t* dstLine = tileP + y*TILE_SIZE*4;
+            for(int x = x0; x < maxX; x++) {
+                To15Bit(srcLine, dstLine);
             }
-            colRows << tile;
         }
-        mColumns << colRows;
+        mColumns[col] << tile;
+    }
+    mRowCount++;
+}
+
+template <typename Addr, void (*To15Bit)(Addr const *& srcLine, uint16_t*& dstLine)>
+void AutoTilesData::loadPixmap(const Addr * const src, const int width, const int height) {
+    startLoading(width);
+    const int nRows = qCeil(static_cast<qreal>(height)/TILE_SIZE);
+    for(int row = 0; row < nRows; row++) {
+        const int y0 = row*TILE_SIZE;
+        const int rowHeight = qMin(TILE_SIZE, height - y0);
+        appendTileRow<Addr, To15Bit>(src + y0*width*4, width, rowHeight,
+                                     row == (nRows - 1));
     }
-    mColumnCount = nCols;
-    mRowCount = nRows;
-    mZeroTileCol = 0;
-    mZeroTileRow = 0;
 }
 
 template <typename T>
@@ -329,6 +341,70 @@ void AutoTilesData::loadPixmap(const SkPixmap &src) {
     }
 }
 
+//! @brief Converts half float components in place to 16 bit unsigned
+static void halfToUnorm16(uint16_t * const data, const size_t count) {
+    for(size_t i = 0; i < count; i += 4) {
+        const auto rgba = SkHalfToFloat_finite_ftz(Sk4h::Load(data + i));
+        const auto clamped = Sk4f::Min(Sk4f::Max(rgba, 0.f), 1.f);
+        SkNx_cast<uint16_t>(clamped*65535.f + 0.5f).store(data + i);
+    }
+}
+
+bool AutoTilesData::loadEncoded(const sk_sp<SkData>& data) {
+    const auto codec = SkCodec::MakeFromData(data);
+    if(!codec) return false;
+    const auto dims = codec->dimensions();
+    const int width = dims.width();
+    const int height = dims.height();
+    // sources deeper than 8 bits (e.g. 16 bit png) are decoded
+    // as half floats and loaded with the 16 bit converter
+    const bool deep = codec->getInfo().colorType() == kRGBA_F16_SkColorType;
+    const auto info = SkImageInfo::Make(width, height,
+                                        deep ? kRGBA_F16_SkColorType :
+                                               kRGBA_8888_SkColorType,
+                                        kUnpremul_SkAlphaType);
+    const auto result = codec->startScanlineDecode(info);
+    const bool topDown = codec->getScanlineOrder() ==
+                         SkCodec::kTopDown_SkScanlineOrder;
+    if(result != SkCodec::kSuccess || !topDown) {
+        // e.g. interlaced images, decode whole image at once
+        SkBitmap bitmap;
+        if(!bitmap.tryAllocPixels(info)) return false;
+        const auto fullResult = codec->getPixels(bitmap.pixmap());
+        if(fullResult != SkCodec::kSuccess &&
+           fullResult != SkCodec::kIncompleteInput) return false;
+        if(deep) {
+            const auto addr16 = static_cast<uint16_t*>(bitmap.getPixels());
+            halfToUnorm16(addr16, bitmap.computeByteSize()/sizeof(uint16_t));
+            loadPixmap_XXXA_16161616<RGBA_to_RGBA>(addr16, width, height,
+                                                   kUnpremul_SkAlphaType);
+        } else loadPixmap(bitmap.pixmap());
+        return true;
+    }
+    // decode one row of tiles at a time
+    const size_t rowBytes = info.minRowBytes();
+    QByteArray strip(static_cast<int>(rowBytes*TILE_SIZE), Qt::Uninitialized);
+    const auto stripData = reinterpret_cast<uint8_t*>(strip.data());
+    const auto stripData16 = reinterpret_cast<uint16_t*>(strip.data());
+    startLoading(width);
+    const int nRows = qCeil(static_cast<qreal>(height)/TILE_SIZE);
+    for(int row = 0; row < nRows; row++) {
+        const int rowHeight = qMin(TILE_SIZE, height - row*TILE_SIZE);
+        const bool lastRow = row == (nRows - 1);
+        // rows missing from truncated files are filled by the codec
+        codec->getScanlines(stripData, rowHeight, rowBytes);
+        if(deep) {
+            halfToUnorm16(stripData16, rowBytes*rowHeight/sizeof(uint16_t));
+            appendTileRow<uint16_t, unpremul_16_to_15<RGBA_to_RGBA>>(
+                        stripData16, width, rowHeight, lastRow);
+        } else {
+            appendTileRow<uint8_t, unpremul_8_to_15<RGBA_to_RGBA>>(
+                        stripData, width, rowHeight, lastRow);
+        }
+    }
+    return true;
+}
+
 AutoTilesData::~AutoTilesData() {
     clear();
 }
@@ -46,6 +46,9 @@ struct CORE_EXPORT AutoTilesData {
 
     void loadPixmap(const SkPixmap& src);
     void loadPixmap(const QImage &src);
+    //! @brief Decodes the image row by row straight into tiles,
+    //! without allocating the whole decoded image
+    bool loadEncoded(const sk_sp<SkData>& data);
 
     void clear();
 
@@ -95,6 +98,11 @@ private:
     void toBitmap(Addr * const dst, const QMargins &margin,
                   const int dstWidth, const int dstHeight) const;
 
+    void startLoading(const int width);
+    template <typename Addr, void (*To15Bit)(Addr const *& srcLine, uint16_t*& dstLine)>
+    void appendTileRow(const Addr * const src,
+                       const int width, const int height,
+                       const bool lastRow);
     template <typename Addr, void (*To15Bit)(Addr const *& srcLine, uint16_t*& dstLine)>
     void loadPixmap(const Addr * const src, const int width, const int height);
 
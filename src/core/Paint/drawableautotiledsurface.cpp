@@ -77,8 +77,13 @@ void DrawableAutoTiledSurface::write(eWriteStream &dst) {
 
 void DrawableAutoTiledSurface::read(eReadStream &src) {
     mSurface.read(src);
-    afterDataReplaced();
-    updateTileBitmaps();
+    // tile data is decompressed before the read stream done tasks
+    stdptr<DrawableAutoTiledSurface> thisP = this;
+    src.addReadStreamDoneTask([thisP](eReadStream&) {
+        if(!thisP) return;
+        thisP->afterDataReplaced();
+        thisP->updateTileBitmaps();
+    });
 }
 
 void DrawableAutoTiledSurface::loadPixmap(const SkPixmap &src) {
@@ -93,6 +98,12 @@ void DrawableAutoTiledSurface::loadPixmap(const QImage &src) {
     updateTileBitmaps();
 }
 
+void DrawableAutoTiledSurface::loadSurface(UndoableAutoTiledSurface &src) {
+    mSurface.swap(src);
+    afterDataReplaced();
+    updateTileBitmaps();
+}
+
 QImage DrawableAutoTiledSurface::toImage(const bool use16Bit,
                                          const QMargins &margin) const {
     return mSurface.toImage(use16Bit, margin);
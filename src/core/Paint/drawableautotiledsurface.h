@@ -77,6 +77,8 @@ public:
 
     void loadPixmap(const SkPixmap& src);
     void loadPixmap(const QImage &src);
+    //! @brief Takes over tiles decoded into a standalone surface
+    void loadSurface(UndoableAutoTiledSurface& src);
 
     QImage toImage(const bool use16Bit,
                    const QMargins &margin = QMargins()) const;
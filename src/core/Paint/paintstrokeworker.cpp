@@ -0,0 +1,101 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "paintstrokeworker.h"
+
+PaintStrokeWorker::PaintStrokeWorker(const Notifier& notifier) :
+    mNotifier(notifier) {
+    mThread = std::thread(&PaintStrokeWorker::run, this);
+}
+
+PaintStrokeWorker::~PaintStrokeWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQuit = true;
+    }
+    mCondition.notify_one();
+    mThread.join();
+}
+
+void PaintStrokeWorker::setTarget(
+        const UndoableAutoTiledSurface * const surface,
+        const stdsptr<SimpleBrushWrapper>& brush) {
+    finish();
+    mSurface = surface;
+    mBrush = brush;
+}
+
+void PaintStrokeWorker::addEvent(const Event& event) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mEvents << event;
+    }
+    mCondition.notify_one();
+}
+
+void PaintStrokeWorker::finish() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mFinished.wait(lock, [this]() { return mEvents.isEmpty() && !mBusy; });
+}
+
+QRect PaintStrokeWorker::takeChangedRect() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    const QRect result = mChangedRect;
+    mChangedRect = QRect();
+    return result;
+}
+
+void PaintStrokeWorker::run() {
+    while(true) {
+        QList<Event> events;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this]() {
+                return mQuit || !mEvents.isEmpty();
+            });
+            if(mQuit) return;
+            // apply everything queued since the last pass at once
+            events.swap(mEvents);
+            mBusy = true;
+        }
+        QRect changed;
+        {
+            std::lock_guard<std::mutex> lock(mSurfaceMutex);
+            for(const auto& event : events) {
+                if(!mSurface || !mBrush) break;
+                MyPaintRectangle roi;
+                if(event.fPress) {
+                    roi = mSurface->paintPressEvent(
+                                mBrush->getBrush(), event.fPos, event.fDTime,
+                                event.fPressure, event.fXTilt, event.fYTilt);
+                } else {
+                    roi = mSurface->paintMoveEvent(
+                                mBrush->getBrush(), event.fPos, event.fDTime,
+                                event.fPressure, event.fXTilt, event.fYTilt);
+                }
+                const QRect qRoi(roi.x, roi.y, roi.width, roi.height);
+                changed = changed.united(qRoi);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mChangedRect = mChangedRect.united(changed);
+            mBusy = false;
+        }
+        mFinished.notify_all();
+        if(mNotifier && !changed.isEmpty()) mNotifier();
+    }
+}
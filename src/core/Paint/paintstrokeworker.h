@@ -0,0 +1,82 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef PAINTSTROKEWORKER_H
+#define PAINTSTROKEWORKER_H
+
+#include "autotiledsurface.h"
+#include "simplebrushwrapper.h"
+
+#include <QRect>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//! @brief Applies brush stroke events to a surface on a dedicated thread.
+//! Events are queued from the GUI thread, changed pixel rects are
+//! collected for the GUI thread to convert to bitmaps.
+class CORE_EXPORT PaintStrokeWorker {
+public:
+    struct Event {
+        bool fPress;
+        QPointF fPos;
+        double fDTime;
+        qreal fPressure;
+        qreal fXTilt;
+        qreal fYTilt;
+    };
+
+    using Notifier = std::function<void()>;
+
+    //! @brief notifier is called from the worker thread
+    //! after queued events were applied
+    PaintStrokeWorker(const Notifier& notifier);
+    ~PaintStrokeWorker();
+
+    //! @brief The brush is used only by the worker thread,
+    //! pass a copy owned by the stroke
+    void setTarget(const UndoableAutoTiledSurface * const surface,
+                   const stdsptr<SimpleBrushWrapper>& brush);
+    void addEvent(const Event& event);
+    //! @brief Blocks until all queued events are applied
+    void finish();
+
+    //! @brief Returns pixels changed since the last call
+    QRect takeChangedRect();
+
+    //! @brief Held by the worker while it modifies the surface
+    std::mutex& surfaceMutex() { return mSurfaceMutex; }
+private:
+    void run();
+
+    const Notifier mNotifier;
+
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::condition_variable mFinished;
+    QList<Event> mEvents;
+    bool mBusy = false;
+    bool mQuit = false;
+    QRect mChangedRect;
+
+    std::mutex mSurfaceMutex;
+    const UndoableAutoTiledSurface * mSurface = nullptr;
+    stdsptr<SimpleBrushWrapper> mBrush;
+};
+
+#endif // PAINTSTROKEWORKER_H
@@ -18,6 +18,34 @@
 #include "canvas.h"
 #include "Private/document.h"
 
+PaintTarget::PaintTarget(Canvas* const canvas) : mCanvas(canvas),
+    mStrokeWorker(std::make_unique<PaintStrokeWorker>([this]() {
+        // coalesce repaint requests until the next draw
+        if(mUpdateRequested.exchange(true)) return;
+        QMetaObject::invokeMethod(mCanvas, [this]() {
+            emit mCanvas->requestUpdate();
+        }, Qt::QueuedConnection);
+    })) {}
+
+void PaintTarget::collectChanged() {
+    const auto changed = mStrokeWorker->takeChangedRect();
+    if(changed.isEmpty()) return;
+    mDirty += changed;
+    if(mTotalRoi.isNull()) mTotalRoi = changed;
+    else mTotalRoi = mTotalRoi.united(changed);
+}
+
+void PaintTarget::finishStroke() {
+    mStrokeWorker->finish();
+    std::lock_guard<std::mutex> lock(mStrokeWorker->surfaceMutex());
+    collectChanged();
+    if(mPaintDrawable) {
+        for(const auto& rect : mDirty)
+            mPaintDrawable->pixelRectChanged(rect);
+    }
+    mDirty = QRegion();
+}
+
 void PaintTarget::draw(SkCanvas * const canvas,
                        const QMatrix& viewTrans,
                        const SkScalar invScale,
@@ -32,7 +60,17 @@ void PaintTarget::draw(SkCanvas * const canvas,
     if(drawOnion) mPaintOnion.draw(canvas);
     SkPaint paint;
     paint.setFilterQuality(filter);
-    mPaintDrawable->drawOnCanvas(canvas, mRelDrawPos, &relDRect, &paint);
+    {
+        std::lock_guard<std::mutex> lock(mStrokeWorker->surfaceMutex());
+        mUpdateRequested = false;
+        collectChanged();
+        // convert only what is visible, the rest waits for finishStroke
+        const auto visibleDirty = mDirty.intersected(relDRect);
+        for(const auto& rect : visibleDirty)
+            mPaintDrawable->pixelRectChanged(rect);
+        mDirty -= visibleDirty;
+        mPaintDrawable->drawOnCanvas(canvas, mRelDrawPos, &relDRect, &paint);
+    }
     if(!mCropRect.isNull()) {
         paint.setStyle(SkPaint::kStroke_Style);
         paint.setAntiAlias(true);
@@ -49,9 +87,13 @@ void PaintTarget::draw(SkCanvas * const canvas,
 
 void PaintTarget::setPaintDrawable(DrawableAutoTiledSurface * const surf,
                                    const int frame) {
+    finishStroke();
     if(mPaintDrawable) {
         if(mChanged) {
-            mPaintDrawable->drawingDoneForNow();
+            {
+                std::lock_guard<std::mutex> lock(mStrokeWorker->surfaceMutex());
+                mPaintDrawable->drawingDoneForNow();
+            }
             if(mPaintAnimSurface) {
                 const auto updateRange =
                         mPaintAnimSurface->prp_getIdenticalRelRange(mLastFrame);
@@ -60,8 +102,10 @@ void PaintTarget::setPaintDrawable(DrawableAutoTiledSurface * const surf,
         }
     }
     mPaintDrawable = surf;
+    mStrokeWorker->setTarget(surf ? &surf->surface() : nullptr, nullptr);
     mLastFrame = frame;
     if(mPaintDrawable) {
+        std::lock_guard<std::mutex> lock(mStrokeWorker->surfaceMutex());
         if(mPaintDrawable->storesDataInMemory()) {
             if(!mPaintDrawable->hasTileBitmaps())
                 mPaintDrawable->updateTileBitmaps();
@@ -123,14 +167,19 @@ void PaintTarget::cropMove(const QPointF &pos) {
 
 void PaintTarget::cropRelease(const QPointF &pos) {
     cropMove(pos);
+    finishStroke();
     startTransform();
     mChanged = true;
 
     if(mPaintAnimSurface && mPaintDrawable) {
-        auto& target = mPaintDrawable->surface();
-        target.triggerAllChange();
-        const auto roi = mPaintDrawable->pixelBoundingRect();
-        mPaintDrawable->crop(mCropRect);
+        QRect roi;
+        {
+            std::lock_guard<std::mutex> lock(mStrokeWorker->surfaceMutex());
+            auto& target = mPaintDrawable->surface();
+            target.triggerAllChange();
+            roi = mPaintDrawable->pixelBoundingRect();
+            mPaintDrawable->crop(mCropRect);
+        }
         addUndoRedo("Crop", roi);
     }
     mCropRect = QRect();
@@ -151,11 +200,15 @@ void PaintTarget::moveMove(const QPointF &pos) {
 
 void PaintTarget::moveRelease(const QPointF &pos) {
     moveMove(pos);
+    finishStroke();
     const int dx = qRound(mRelDrawPos.x());
     const int dy = qRound(mRelDrawPos.y());
     mChanged = true;
     if(mPaintDrawable) {
-        mPaintDrawable->move(dx, dy);
+        {
+            std::lock_guard<std::mutex> lock(mStrokeWorker->surfaceMutex());
+            mPaintDrawable->move(dx, dy);
+        }
         if(mPaintAnimSurface) {
             mPaintAnimSurface->prp_pushUndoRedoName("Move");
             UndoRedo ur;
@@ -191,15 +244,15 @@ void PaintTarget::paintPress(const QPointF& pos,
     startTransform();
 
     if(mPaintDrawable && brush) {
-        const auto& target = mPaintDrawable->surface();
+        finishStroke();
+        // the worker strokes with its own copy, changing the brush
+        // on the gui thread does not affect the running stroke
+        mStrokeWorker->setTarget(&mPaintDrawable->surface(),
+                                 brush->createCopy());
         const auto pDrawTrans = mPaintDrawableBox->getTotalTransform();
         const auto drawPos = pDrawTrans.inverted().map(pos);
-        const auto roi =
-                target.paintPressEvent(brush->getBrush(),
-                                       drawPos, 1, pressure, xTilt, yTilt);
-        const QRect qRoi(roi.x, roi.y, roi.width, roi.height);
-        mTotalRoi = qRoi;
-        mPaintDrawable->pixelRectChanged(qRoi);
+        mTotalRoi = QRect();
+        mStrokeWorker->addEvent({true, drawPos, 1, pressure, xTilt, yTilt});
         mLastTs = ts;
         mChanged = true;
     }
@@ -210,21 +263,11 @@ void PaintTarget::paintMove(const QPointF& pos,
                             const qreal xTilt, const qreal yTilt,
                             const SimpleBrushWrapper * const brush) {
     if(mPaintDrawable && brush) {
-        const auto& target = mPaintDrawable->surface();
         const double dt = (ts - mLastTs);
         const auto pDrawTrans = mPaintDrawableBox->getTotalTransform();
         const auto drawPos = pDrawTrans.inverted().map(pos);
-        const auto roi =
-                target.paintMoveEvent(brush->getBrush(),
-                                      drawPos, dt/1000, pressure,
-                                      xTilt, yTilt);
-        const QRect qRoi(roi.x, roi.y, roi.width, roi.height);
-        mPaintDrawable->pixelRectChanged(qRoi);
-        if(mTotalRoi.isNull()) {
-            mTotalRoi = qRoi;
-        } else {
-            mTotalRoi = mTotalRoi.united(qRoi);
-        }
+        mStrokeWorker->addEvent({false, drawPos, dt/1000, pressure,
+                                 xTilt, yTilt});
     }
     mLastTs = ts;
 }
@@ -237,5 +280,6 @@ void PaintTarget::addUndoRedo(const QString& name, const QRect& roi) {
 }
 
 void PaintTarget::paintRelease() {
+    finishStroke();
     addUndoRedo("Paint", mTotalRoi);
 }
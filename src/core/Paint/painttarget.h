@@ -23,9 +23,13 @@ class Canvas;
 #include "Boxes/paintbox.h"
 #include "onionskin.h"
 #include "CacheHandlers/usepointer.h"
+#include "paintstrokeworker.h"
+
+#include <QRegion>
+#include <atomic>
 
 struct CORE_EXPORT PaintTarget {
-    PaintTarget(Canvas* const canvas) : mCanvas(canvas) {}
+    PaintTarget(Canvas* const canvas);
 
     bool needsProcessing() const { return true; }
 
@@ -72,6 +76,8 @@ struct CORE_EXPORT PaintTarget {
 
     QRect pixelBoundingRect() const {
         if(!isValid()) return QRect();
+        mStrokeWorker->finish();
+        std::lock_guard<std::mutex> lock(mStrokeWorker->surfaceMutex());
         return mPaintDrawable->pixelBoundingRect();
     }
 
@@ -86,6 +92,9 @@ struct CORE_EXPORT PaintTarget {
     void cropCancel();
 private:
     void startTransform();
+    //! @brief Waits for the painting thread and converts all dirty tiles
+    void finishStroke();
+    void collectChanged();
     void addUndoRedo(const QString &name, const QRect &roi);
 
     QPointF absPosToRelPos(const QPointF& absPos) const;
@@ -104,6 +113,11 @@ private:
     UsePointer<DrawableAutoTiledSurface> mPaintDrawable;
     bool mChanged = false;
     Canvas * const mCanvas;
+
+    //! @brief Pixels painted, but not yet converted to tile bitmaps
+    QRegion mDirty;
+    std::atomic_bool mUpdateRequested{false};
+    const std::unique_ptr<PaintStrokeWorker> mStrokeWorker;
 };
 
 #endif // PAINTTARGET_H
@@ -28,7 +28,7 @@ SimpleBrushWrapper::~SimpleBrushWrapper() {
     mypaint_brush_unref(mBrush);
 }
 
-stdsptr<SimpleBrushWrapper> SimpleBrushWrapper::createDuplicate() {
+stdsptr<SimpleBrushWrapper> SimpleBrushWrapper::createDuplicate() const {
     auto brush = mypaint_brush_new_with_buckets(256);
     const char *data = mWholeFile.constData();
 
@@ -40,3 +40,13 @@ stdsptr<SimpleBrushWrapper> SimpleBrushWrapper::createDuplicate() {
                 mCollectionName, mBrushName,
                 brush, mWholeFile);
 }
+
+stdsptr<SimpleBrushWrapper> SimpleBrushWrapper::createCopy() const {
+    const auto copy = createDuplicate();
+    if(!copy) return nullptr;
+    for(int i = 0; i < MYPAINT_BRUSH_SETTINGS_COUNT; i++) {
+        const auto id = static_cast<MyPaintBrushSetting>(i);
+        copy->setBaseValue(id, getBaseValue(id));
+    }
+    return copy;
+}
@@ -27,7 +27,9 @@ class CORE_EXPORT SimpleBrushWrapper : public StdSelfRef {
 public:
     ~SimpleBrushWrapper();
 
-    stdsptr<SimpleBrushWrapper> createDuplicate();
+    stdsptr<SimpleBrushWrapper> createDuplicate() const;
+    //! @brief Duplicate keeping the current base values, e.g. color and size
+    stdsptr<SimpleBrushWrapper> createCopy() const;
 
     MyPaintBrush * getBrush() const { return mBrush; }
 
@@ -82,9 +82,12 @@ stdsptr<Tile> Tile::sRead(eReadStream &src, const TileCreator &tileCreator) {
     if(data) {
         const auto data = result->requestData();
         if(src.evFileVersion() >= EvFormat::dataCompression) {
-            const auto readData = src.readCompressed();
-            Q_ASSERT(size*sizeof(uint16_t) == size_t(readData.size()));
-            memcpy(data, readData.data(), readData.size());
+            src.readCompressed([result, data](const QByteArray& readData) {
+                const size_t bytes = result->fSize*sizeof(uint16_t);
+                Q_ASSERT(bytes == size_t(readData.size()));
+                memcpy(data, readData.data(),
+                       qMin(bytes, size_t(readData.size())));
+            });
         } else src.read(data, size*sizeof(uint16_t));
     }
     return result;
@@ -0,0 +1,95 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "patheffectscache.h"
+
+#include "../simplemath.h"
+
+#include <QHash>
+#include <QVector>
+
+PathEffectsCache::Lookup PathEffectsCache::sLookup(
+        const stdsptr<PathEffectsCache>& cache,
+        const Stage stage, const qreal relFrame,
+        const DifferenceFunc& differs) {
+    Lookup result;
+    if(!cache) return result;
+    const int id = static_cast<int>(stage);
+    result.mCache = cache;
+    result.mStage = stage;
+    result.mRelFrame = relFrame;
+
+    std::lock_guard<std::mutex> lock(cache->mMutex);
+    result.mGeneration = cache->mGeneration[id];
+    for(const auto& entry : cache->mEntries[id]) {
+        const bool sameFrame = isZero4Dec(entry.fRelFrame - relFrame);
+        if(!sameFrame) {
+            const int prevFrame = qFloor(qMin(entry.fRelFrame, relFrame));
+            const int nextFrame = qCeil(qMax(entry.fRelFrame, relFrame));
+            if(differs(prevFrame, nextFrame)) continue;
+        }
+        result.mEntries << entry;
+    }
+    return result;
+}
+
+bool PathEffectsCache::Lookup::find(const SkPath& src, SkPath& dst) {
+    if(!mCache) return false;
+    mSrcHash = sHash(src);
+    for(const auto& entry : mEntries) {
+        if(entry.fSrcHash != mSrcHash) continue;
+        if(entry.fSrc != src) continue;
+        dst = entry.fDst;
+        return true;
+    }
+    return false;
+}
+
+void PathEffectsCache::Lookup::store(const SkPath& src,
+                                     const SkPath& dst) const {
+    if(!mCache) return;
+    mCache->store(*this, {mRelFrame, mSrcHash, src, dst});
+}
+
+void PathEffectsCache::clear(const Stage stage) {
+    const int id = static_cast<int>(stage);
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries[id].clear();
+    mGeneration[id]++;
+}
+
+uint PathEffectsCache::sHash(const SkPath& path) {
+    const int nPts = path.countPoints();
+    const int nVerbs = path.countVerbs();
+    QVector<SkPoint> pts(nPts);
+    QVector<uint8_t> verbs(nVerbs);
+    path.getPoints(pts.data(), nPts);
+    path.getVerbs(verbs.data(), nVerbs);
+    const uint fillType = static_cast<uint>(path.getFillType());
+    const uint ptsHash = qHashBits(pts.constData(),
+                                   sizeof(SkPoint)*static_cast<uint>(nPts),
+                                   fillType);
+    return qHashBits(verbs.constData(), static_cast<uint>(nVerbs), ptsHash);
+}
+
+void PathEffectsCache::store(const Lookup& lookup, Entry&& entry) {
+    const int id = static_cast<int>(lookup.mStage);
+    std::lock_guard<std::mutex> lock(mMutex);
+    if(mGeneration[id] != lookup.mGeneration) return;
+    auto& entries = mEntries[id];
+    entries.prepend(std::move(entry));
+    while(entries.count() > sMaxEntries) entries.removeLast();
+}
@@ -0,0 +1,82 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef PATHEFFECTSCACHE_H
+#define PATHEFFECTSCACHE_H
+
+#include "../skia/skiaincludes.h"
+#include "../smartPointers/stdselfref.h"
+
+#include <mutex>
+#include <functional>
+#include <QList>
+
+//! @brief Memoizes path effect results of a single box.
+//! An entry is reused for frames within the identical range
+//! of the frame it was computed at, as long as the input path is the same.
+class CORE_EXPORT PathEffectsCache {
+public:
+    enum class Stage : short {
+        base, fill, outlineBase, outline, count
+    };
+    using DifferenceFunc = std::function<bool(const int, const int)>;
+
+    struct Entry {
+        qreal fRelFrame;
+        uint fSrcHash;
+        SkPath fSrc;
+        SkPath fDst;
+    };
+
+    //! @brief Snapshot of entries compatible with a frame,
+    //! created on the main thread, used by path effect tasks
+    class CORE_EXPORT Lookup {
+        friend class PathEffectsCache;
+    public:
+        Lookup() {}
+
+        //! @brief Returns false if there is no result for src
+        bool find(const SkPath& src, SkPath& dst);
+        //! @brief Stores the result for src passed to the last find
+        void store(const SkPath& src, const SkPath& dst) const;
+    private:
+        stdsptr<PathEffectsCache> mCache;
+        Stage mStage = Stage::base;
+        qreal mRelFrame = 0;
+        int mGeneration = 0;
+        uint mSrcHash = 0;
+        QList<Entry> mEntries;
+    };
+
+    static Lookup sLookup(const stdsptr<PathEffectsCache>& cache,
+                          const Stage stage, const qreal relFrame,
+                          const DifferenceFunc& differs);
+
+    //! @brief Drops results of stage, call whenever stage parameters change
+    void clear(const Stage stage);
+
+    static uint sHash(const SkPath& path);
+private:
+    void store(const Lookup& lookup, Entry&& entry);
+
+    static const int sMaxEntries = 4;
+
+    std::mutex mMutex;
+    QList<Entry> mEntries[static_cast<int>(Stage::count)];
+    int mGeneration[static_cast<int>(Stage::count)] = {};
+};
+
+#endif // PATHEFFECTSCACHE_H
@@ -17,46 +17,117 @@
 #include "patheffectstask.h"
 
 PathEffectsTask::PathEffectsTask(PathBoxRenderData * const target,
-                                 EffectsList&& pathEffects,
-                                 EffectsList&& fillEffects,
-                                 EffectsList&& outlineBaseEffects,
-                                 EffectsList&& outlineEffects) :
-    mTarget(target), mStroker(target->fStroker),
-
-    mPathEffects(std::move(pathEffects)),
-    mFillEffects(std::move(fillEffects)),
-    mOutlineBaseEffects(std::move(outlineBaseEffects)),
+                                 const Chain chain,
+                                 EffectsList&& effects,
+                                 EffectsList&& outlineEffects,
+                                 Lookup&& lookup, Lookup&& outlineLookup,
+                                 const bool restroke) :
+    mTarget(target), mChain(chain), mStroker(target->fStroker),
+    mRestroke(restroke),
+    mEffects(std::move(effects)),
     mOutlineEffects(std::move(outlineEffects)),
+    mLookup(std::move(lookup)),
+    mOutlineLookup(std::move(outlineLookup)) {}
 
-    mPath(target->fPath), mFillPath(target->fFillPath),
-    mOutlineBasePath(target->fOutlineBasePath),
-    mOutlinePath(target->fOutlinePath) {}
+void PathEffectsTask::sQueTasks(PathBoxRenderData * const target,
+                                EffectsList&& pathEffects,
+                                EffectsList&& fillEffects,
+                                EffectsList&& outlineBaseEffects,
+                                EffectsList&& outlineEffects,
+                                PathEffectsLookups&& lookups) {
+    const bool pathReady = pathEffects.isEmpty();
+    const bool fillReady = fillEffects.isEmpty();
+    const bool restroke = !pathReady || !outlineBaseEffects.isEmpty();
+    const bool outlineReady = !restroke && outlineEffects.isEmpty();
 
-void PathEffectsTask::process() {
-    const bool pathReady = mPathEffects.isEmpty();
-    const bool fillReady = pathReady && mFillEffects.isEmpty();
-    const bool outlineBaseReady = pathReady && mOutlineBaseEffects.isEmpty();
+    stdsptr<PathEffectsTask> baseTask;
+    if(!pathReady) {
+        baseTask = enve::make_shared<PathEffectsTask>(
+                    target, Chain::base, std::move(pathEffects),
+                    EffectsList(), std::move(lookups.fBase),
+                    Lookup(), false);
+        baseTask->mFillFollowsBase = fillReady;
+    }
+    const auto queDependent = [&](const stdsptr<PathEffectsTask>& task) {
+        if(baseTask) baseTask->addDependent(task.get());
+        task->addDependent(target);
+        task->queTask();
+    };
+    if(!fillReady) {
+        queDependent(enve::make_shared<PathEffectsTask>(
+                         target, Chain::fill, std::move(fillEffects),
+                         EffectsList(), std::move(lookups.fFill),
+                         Lookup(), false));
+    }
+    if(!outlineReady) {
+        queDependent(enve::make_shared<PathEffectsTask>(
+                         target, Chain::outline, std::move(outlineBaseEffects),
+                         std::move(outlineEffects),
+                         std::move(lookups.fOutlineBase),
+                         std::move(lookups.fOutline), restroke));
+    }
+    if(baseTask) {
+        baseTask->addDependent(target);
+        baseTask->queTask();
+    }
+    target->delayDataSet();
+}
 
-    for(const auto& effect : mPathEffects) {
-        effect->apply(mPath);
+void PathEffectsTask::beforeProcessing(const Hardware) {
+    if(!mTarget) return;
+    switch(mChain) {
+    case Chain::base:
+    case Chain::fill:
+        mPath = mTarget->fPath;
+        break;
+    case Chain::outline:
+        if(mRestroke) mPath = mTarget->fPath;
+        else mOutlinePath = mTarget->fOutlinePath;
+        break;
     }
+}
 
-    if(!fillReady) {
-        mFillPath = mPath;
-        for(const auto& effect : mFillEffects) {
-            effect->apply(mFillPath);
-        }
+void PathEffectsTask::sApply(const EffectsList& effects,
+                             Lookup& lookup, SkPath& path) {
+    if(effects.isEmpty()) return;
+    const SkPath src = path;
+    if(lookup.find(src, path)) return;
+    for(const auto& effect : effects) {
+        effect->apply(path);
     }
+    lookup.store(src, path);
+}
 
-    if(!outlineBaseReady) {
-        mOutlineBasePath = mPath;
-        for(const auto& effect : mOutlineBaseEffects) {
-            effect->apply(mOutlineBasePath);
+void PathEffectsTask::process() {
+    switch(mChain) {
+    case Chain::base:
+    case Chain::fill:
+        sApply(mEffects, mLookup, mPath);
+        break;
+    case Chain::outline:
+        if(mRestroke) {
+            mOutlineBasePath = mPath;
+            sApply(mEffects, mLookup, mOutlineBasePath);
+            mStroker.strokePath(mOutlineBasePath, &mOutlinePath);
         }
-        mStroker.strokePath(mOutlineBasePath, &mOutlinePath);
+        sApply(mOutlineEffects, mOutlineLookup, mOutlinePath);
+        break;
     }
+}
 
-    for(const auto& effect : mOutlineEffects) {
-        effect->apply(mOutlinePath);
+void PathEffectsTask::afterProcessing() {
+    if(!mTarget) return;
+    switch(mChain) {
+    case Chain::base:
+        mTarget->fPath = mPath;
+        if(mFillFollowsBase) mTarget->fFillPath = mPath;
+        break;
+    case Chain::fill:
+        mTarget->fFillPath = mPath;
+        break;
+    case Chain::outline:
+        if(mRestroke) mTarget->fOutlineBasePath = mOutlineBasePath;
+        mTarget->fOutlinePath = mOutlinePath;
+        break;
     }
 }
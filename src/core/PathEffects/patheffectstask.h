@@ -20,45 +20,63 @@
 #include "../Tasks/updatable.h"
 #include "../Boxes/pathbox.h"
 #include "patheffectcaller.h"
+#include "patheffectscache.h"
+
+struct CORE_EXPORT PathEffectsLookups {
+    PathEffectsCache::Lookup fBase;
+    PathEffectsCache::Lookup fFill;
+    PathEffectsCache::Lookup fOutlineBase;
+    PathEffectsCache::Lookup fOutline;
+};
 
 class CORE_EXPORT PathEffectsTask : public eCpuTask {
+    e_OBJECT
     friend class PathBox;
 
     typedef QList<stdsptr<PathEffectCaller>> EffectsList;
+    using Lookup = PathEffectsCache::Lookup;
 public:
+    enum class Chain { base, fill, outline };
+protected:
     PathEffectsTask(PathBoxRenderData* const target,
-                    EffectsList&& pathEffects,
-                    EffectsList&& fillEffects,
-                    EffectsList&& outlineBaseEffects,
-                    EffectsList&& outlineEffects);
-
-    bool isEmpty() const {
-        return mPathEffects.isEmpty() &&
-               mFillEffects.isEmpty() &&
-               mOutlineBaseEffects.isEmpty() &&
-               mOutlineEffects.isEmpty();
-    }
+                    const Chain chain,
+                    EffectsList&& effects,
+                    EffectsList&& outlineEffects,
+                    Lookup&& lookup, Lookup&& outlineLookup,
+                    const bool restroke);
+public:
+    //! @brief Ques tasks applying effects to target paths.
+    //! Fill and outline chains are processed by separate tasks,
+    //! in parallel, after the base chain is finished.
+    static void sQueTasks(PathBoxRenderData* const target,
+                          EffectsList&& pathEffects,
+                          EffectsList&& fillEffects,
+                          EffectsList&& outlineBaseEffects,
+                          EffectsList&& outlineEffects,
+                          PathEffectsLookups&& lookups = PathEffectsLookups());
 
     void process();
-
-    void afterProcessing() {
-        if(!mTarget) return;
-        mTarget->fPath = mPath;
-        mTarget->fFillPath = mFillPath;
-        mTarget->fOutlineBasePath = mOutlineBasePath;
-        mTarget->fOutlinePath = mOutlinePath;
-    }
+protected:
+    void beforeProcessing(const Hardware);
+    void afterProcessing();
 private:
+    static void sApply(const EffectsList& effects,
+                       Lookup& lookup, SkPath& path);
+
     const stdptr<PathBoxRenderData> mTarget;
+    const Chain mChain;
     const SkStroke mStroker;
+    //! @brief Outline base path has to be recreated and stroked
+    const bool mRestroke;
+    //! @brief Fill path is the result of the base chain
+    bool mFillFollowsBase = false;
 
-    const EffectsList mPathEffects;
-    const EffectsList mFillEffects;
-    const EffectsList mOutlineBaseEffects;
+    const EffectsList mEffects;
     const EffectsList mOutlineEffects;
+    Lookup mLookup;
+    Lookup mOutlineLookup;
 
     SkPath mPath;
-    SkPath mFillPath;
     SkPath mOutlineBasePath;
     SkPath mOutlinePath;
 };
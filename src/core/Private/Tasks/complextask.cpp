@@ -22,6 +22,7 @@ ComplexTask::ComplexTask(const int finishValue, const QString &name) :
 eTask* ComplexTask::addEmptyTask() {
     const auto emptyTask = enve::make_shared<eCustomCpuTask>(
                 nullptr, nullptr, nullptr, nullptr);
+    emptyTask->setPriority(TaskPriority::background);
     emptyTask->queTask();
     addTask(emptyTask);
     return emptyTask.get();
@@ -17,7 +17,8 @@
 #include "taskque.h"
 #include "Private/esettings.h"
 
-TaskQue::TaskQue() {}
+TaskQue::TaskQue(const int targetFrame, const bool background) :
+    mTargetFrame(targetFrame), mBackground(background) {}
 
 TaskQue::~TaskQue() {
     for(const auto& task : mCpuOnly) task->cancel();
@@ -34,6 +35,7 @@ int TaskQue::countQued() const {
 bool TaskQue::allDone() const { return countQued() == 0; }
 
 void TaskQue::addTask(const stdsptr<eTask> &task) {
+    if(!task->hasTargetFrame()) task->setTargetFrame(mTargetFrame);
     const auto hwSupport = task->hardwareSupport();
     switch(eSettings::sInstance->fAccPreference) {
         case AccPreference::gpuStrongPreference:
@@ -107,40 +109,42 @@ void TaskQue::addTask(const stdsptr<eTask> &task) {
     }
 }
 
-stdsptr<eTask> TaskQue::takeQuedForCpuProcessing() {
-    for(int i = 0; i < mCpuOnly.count(); i++) {
-        const auto& task = mCpuOnly.at(i);
-        if(task->readyToBeProcessed())
-            return mCpuOnly.takeAt(i);
-    }
-    for(int i = 0; i < mCpuPreffered.count(); i++) {
-        const auto& task = mCpuPreffered.at(i);
-        if(task->readyToBeProcessed())
-            return mCpuPreffered.takeAt(i);
+void moveNonFrameTasks(QList<stdsptr<eTask>>& from,
+                       QList<stdsptr<eTask>>& to) {
+    for(int i = 0; i < from.count(); i++) {
+        if(from.at(i)->rendersFrame()) continue;
+        to << from.takeAt(i--);
     }
-    for(int i = 0; i < mGpuPreffered.count(); i++) {
-        const auto& task = mGpuPreffered.at(i);
-        if(task->readyToBeProcessed())
-            return mGpuPreffered.takeAt(i);
+}
+
+void TaskQue::takeNonFrameTasks(QList<stdsptr<eTask>>& tasks) {
+    moveNonFrameTasks(mCpuOnly, tasks);
+    moveNonFrameTasks(mCpuPreffered, tasks);
+    moveNonFrameTasks(mGpuPreffered, tasks);
+    moveNonFrameTasks(mGpuOnly, tasks);
+}
+
+stdsptr<eTask> takeReady(QList<stdsptr<eTask>>& tasks) {
+    for(int i = 0; i < tasks.count(); i++) {
+        const auto& task = tasks.at(i);
+        if(task->getState() == eTaskState::canceled) {
+            // canceled through a dependency from another que
+            tasks.removeAt(i--);
+        } else if(task->readyToBeProcessed()) {
+            return tasks.takeAt(i);
+        }
     }
     return nullptr;
 }
 
+stdsptr<eTask> TaskQue::takeQuedForCpuProcessing() {
+    if(const auto task = takeReady(mCpuOnly)) return task;
+    if(const auto task = takeReady(mCpuPreffered)) return task;
+    return takeReady(mGpuPreffered);
+}
+
 stdsptr<eTask> TaskQue::takeQuedForGpuProcessing() {
-    for(int i = 0; i < mGpuOnly.count(); i++) {
-        const auto& task = mGpuOnly.at(i);
-        if(task->readyToBeProcessed())
-            return mGpuOnly.takeAt(i);
-    }
-    for(int i = 0; i < mGpuPreffered.count(); i++) {
-        const auto& task = mGpuPreffered.at(i);
-        if(task->readyToBeProcessed())
-            return mGpuPreffered.takeAt(i);
-    }
-    for(int i = 0; i < mCpuPreffered.count(); i++) {
-        const auto& task = mCpuPreffered.at(i);
-        if(task->readyToBeProcessed())
-            return mCpuPreffered.takeAt(i);
-    }
-    return nullptr;
+    if(const auto task = takeReady(mGpuOnly)) return task;
+    if(const auto task = takeReady(mGpuPreffered)) return task;
+    return takeReady(mCpuPreffered);
 }
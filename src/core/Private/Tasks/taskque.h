@@ -21,19 +21,28 @@
 class CORE_EXPORT TaskQue {
     friend class TaskQueHandler;
 public:
-    explicit TaskQue();
+    explicit TaskQue(const int targetFrame,
+                     const bool background = false);
     TaskQue(const TaskQue&) = delete;
     TaskQue& operator=(const TaskQue&) = delete;
 
     ~TaskQue();
 protected:
+    int targetFrame() const { return mTargetFrame; }
+    bool background() const { return mBackground; }
+
     int countQued() const;
     bool allDone() const;
     void addTask(const stdsptr<eTask>& task);
+    //! @brief Moves out the tasks that do not render a frame
+    void takeNonFrameTasks(QList<stdsptr<eTask>>& tasks);
 
     stdsptr<eTask> takeQuedForCpuProcessing();
     stdsptr<eTask> takeQuedForGpuProcessing();
 private:
+    const int mTargetFrame;
+    const bool mBackground;
+
     QList<stdsptr<eTask>> mGpuOnly;
     QList<stdsptr<eTask>> mGpuPreffered;
     QList<stdsptr<eTask>> mCpuPreffered;
@@ -16,75 +16,168 @@
 
 #include "taskquehandler.h"
 
+#include <algorithm>
+
 int TaskQueHandler::countQues() const { return mQues.count(); }
 
-bool TaskQueHandler::isEmpty() const { return mQues.isEmpty(); }
+bool TaskQueHandler::isEmpty() const {
+    return mQues.isEmpty() && !mBackgroundQue;
+}
 
 void TaskQueHandler::clear() {
     mQues.clear();
+    mBackgroundQue.reset();
     mCurrentQue = nullptr;
     mTaskCount = 0;
 }
 
-stdsptr<eTask> TaskQueHandler::takeQuedForGpuProcessing() {
-    int queId = 0;
-    for(const auto& que : mQues) {
-        const auto task = que->takeQuedForGpuProcessing();
-        if(task) {
-            if(que->allDone()) queDone(que.get(), queId);
-            mTaskCount--;
-            return task;
-        }
-        queId++;
+stdsptr<eTask> TaskQueHandler::takeQued(const Taker taker) {
+    for(int queId = 0; queId < mQues.count(); queId++) {
+        const auto que = mQues.at(queId).get();
+        const int nQued = que->countQued();
+        const auto task = (que->*taker)();
+        mTaskCount -= nQued - que->countQued();
+        if(que->allDone() && que != mCurrentQue) mQues.removeAt(queId--);
+        if(task) return task;
+    }
+    if(mBackgroundQue) {
+        const int nQued = mBackgroundQue->countQued();
+        const auto task = (mBackgroundQue.get()->*taker)();
+        mTaskCount -= nQued - mBackgroundQue->countQued();
+        if(mBackgroundQue->allDone()) mBackgroundQue.reset();
+        if(task) return task;
     }
     return nullptr;
 }
 
+stdsptr<eTask> TaskQueHandler::takeQuedForGpuProcessing() {
+    return takeQued(&TaskQue::takeQuedForGpuProcessing);
+}
+
 stdsptr<eTask> TaskQueHandler::takeQuedForCpuProcessing() {
-    int queId = 0;
-    for(const auto& que : mQues) {
-        const auto task = que->takeQuedForCpuProcessing();
-        if(task) {
-            if(que->allDone()) queDone(que.get(), queId);
-            mTaskCount--;
-            return task;
-        }
-        queId++;
-    }
-    return nullptr;
+    return takeQued(&TaskQue::takeQuedForCpuProcessing);
 }
 
-void TaskQueHandler::beginQue() {
+void TaskQueHandler::beginQue(const int targetFrame) {
     if(mCurrentQue) RuntimeThrow("Previous list not ended");
-    mQues << std::make_shared<TaskQue>();
-    mCurrentQue = mQues.last().get();
+    const auto que = std::make_shared<TaskQue>(targetFrame);
+    int queId = 0;
+    for(; queId < mQues.count(); queId++) {
+        if(moreUrgent(*que, *mQues.at(queId))) break;
+    }
+    mQues.insert(queId, que);
+    mCurrentQue = que.get();
 }
 
 void TaskQueHandler::addTask(const stdsptr<eTask> &task) {
-    if(mCurrentQue) {
-        mCurrentQue->addTask(task);
+    if(task->priority() == TaskPriority::background) {
+        if(!mBackgroundQue) {
+            mBackgroundQue = std::make_shared<TaskQue>(mPlayheadFrame, true);
+        }
+        mBackgroundQue->addTask(task);
+        mTaskCount++;
+        return;
+    }
+    const auto que = queForTask(*task);
+    if(que) {
+        que->addTask(task);
         mTaskCount++;
     } else {
-        if(mQues.isEmpty()) {
-            beginQue();
-            addTask(task);
-            endQue();
-        } else {
-            const auto que = mQues.first().get();
-            que->addTask(task);
-            mTaskCount++;
-        }
+        beginQue(task->hasTargetFrame() ? task->targetFrame() :
+                                          mPlayheadFrame);
+        addTask(task);
+        endQue();
     }
 }
 
 void TaskQueHandler::endQue() {
     if(!mCurrentQue) return;
     const int count = mCurrentQue->countQued();
-    if(count == 0) mQues.removeLast();
+    if(count == 0) {
+        for(int i = 0; i < mQues.count(); i++) {
+            if(mQues.at(i).get() != mCurrentQue) continue;
+            mQues.removeAt(i);
+            break;
+        }
+    }
     mCurrentQue = nullptr;
 }
 
-void TaskQueHandler::queDone(const TaskQue * const que, const int queId) {
-    if(que == mCurrentQue) return;
-    mQues.removeAt(queId);
+void TaskQueHandler::setPlayheadFrame(const int frame, const bool keepAhead) {
+    if(frame == mPlayheadFrame) return;
+    const bool jump = frame != mPlayheadFrame + 1;
+    mPlayheadFrame = frame;
+    // destroying a que cancels the tasks it still holds,
+    // keep them alive until the remaining ques are in order
+    QList<stdsptr<TaskQue>> stale;
+    // e.g. sound and cache compression, needed regardless of the frame
+    QList<stdsptr<eTask>> kept;
+    if(jump) {
+        for(int i = mQues.count() - 1; i >= 0; i--) {
+            const auto que = mQues.at(i).get();
+            if(que == mCurrentQue) continue;
+            const int queFrame = que->targetFrame();
+            if(queFrame == frame) continue;
+            if(keepAhead && queFrame > frame) continue;
+            mTaskCount -= que->countQued();
+            que->takeNonFrameTasks(kept);
+            stale << mQues.takeAt(i);
+        }
+    }
+    std::stable_sort(mQues.begin(), mQues.end(),
+                     [this](const stdsptr<TaskQue>& que1,
+                            const stdsptr<TaskQue>& que2) {
+        return moreUrgent(*que1, *que2);
+    });
+    stale.clear();
+    // e.g. path effect tasks of the canceled render data are not needed,
+    // repeat as dropping a task can leave its own dependencies unused
+    bool dropped = true;
+    while(dropped) {
+        dropped = false;
+        for(int i = 0; i < kept.count(); i++) {
+            const auto& task = kept.at(i);
+            if(!task->allDependentCanceled()) continue;
+            task->cancel();
+            kept.removeAt(i--);
+            dropped = true;
+        }
+    }
+    for(const auto& task : kept) addTask(task);
+}
+
+TaskPriority TaskQueHandler::priority(const TaskQue& que) const {
+    if(que.background()) return TaskPriority::background;
+    if(que.targetFrame() == mPlayheadFrame) return TaskPriority::current;
+    return TaskPriority::lookahead;
+}
+
+qint64 TaskQueHandler::playbackDistance(const int frame) const {
+    const qint64 dist = static_cast<qint64>(frame) - mPlayheadFrame;
+    if(dist >= 0) return dist;
+    // frames behind the playhead are reached only after looping back
+    return dist + (static_cast<qint64>(1) << 32);
+}
+
+bool TaskQueHandler::moreUrgent(const TaskQue& que1,
+                                const TaskQue& que2) const {
+    const auto priority1 = priority(que1);
+    const auto priority2 = priority(que2);
+    if(priority1 != priority2) return priority1 < priority2;
+    return playbackDistance(que1.targetFrame()) <
+           playbackDistance(que2.targetFrame());
+}
+
+TaskQue* TaskQueHandler::queForTask(const eTask& task) const {
+    if(task.hasTargetFrame()) {
+        const int frame = task.targetFrame();
+        if(mCurrentQue && mCurrentQue->targetFrame() == frame)
+            return mCurrentQue;
+        for(const auto& que : mQues) {
+            if(que->targetFrame() == frame) return que.get();
+        }
+    }
+    if(mCurrentQue) return mCurrentQue;
+    if(mQues.isEmpty()) return nullptr;
+    return mQues.first().get();
 }
@@ -20,6 +20,7 @@
 
 class CORE_EXPORT TaskQueHandler {
 public:
+    //! @brief Number of frame ques, the background que is not counted
     int countQues() const;
     bool isEmpty() const;
 
@@ -28,18 +29,36 @@ public:
     stdsptr<eTask> takeQuedForGpuProcessing();
     stdsptr<eTask> takeQuedForCpuProcessing();
 
-    void beginQue();
+    void beginQue(const int targetFrame);
 
     void addTask(const stdsptr<eTask>& task);
 
     void endQue();
 
     int taskCount() const { return mTaskCount; }
+
+    //! @brief Ques are processed starting with the playhead frame,
+    //! followed by the other frames in playback order.
+    //! When the playhead jumps ques left behind it are canceled,
+    //! ques ahead of it are canceled too unless keepAhead is set.
+    //! Non-frame tasks of canceled ques are requeued,
+    //! unless they only fed canceled tasks.
+    void setPlayheadFrame(const int frame, const bool keepAhead);
+    int playheadFrame() const { return mPlayheadFrame; }
 private:
-    void queDone(const TaskQue * const que, const int queId);
+    using Taker = stdsptr<eTask> (TaskQue::*)();
+    stdsptr<eTask> takeQued(const Taker taker);
+
+    TaskPriority priority(const TaskQue& que) const;
+    qint64 playbackDistance(const int frame) const;
+    bool moreUrgent(const TaskQue& que1, const TaskQue& que2) const;
+
+    TaskQue* queForTask(const eTask& task) const;
 
     int mTaskCount = 0;
+    int mPlayheadFrame = 0;
     QList<stdsptr<TaskQue>> mQues;
+    stdsptr<TaskQue> mBackgroundQue;
     TaskQue * mCurrentQue = nullptr;
 };
 #endif // TASKQUEHANDLER_H
@@ -146,7 +146,10 @@ void TaskScheduler::queTasks() {
 void TaskScheduler::queScheduledCpuTasks() {
     if(!mAlwaysQue && !shouldQueMoreCpuTasks()) return;
     mCpuQueing = true;
-    mQuedCGTasks.beginQue();
+    const int frame = Document::sInstance->getActiveSceneFrame();
+    // when not rendering ahead, the ques always target the playhead
+    if(!mAlwaysQue) setPlayheadFrame(frame);
+    mQuedCGTasks.beginQue(frame);
     for(const auto& it : Document::sInstance->fVisibleScenes) {
         const auto scene = it.first;
         scene->queTasks();
@@ -278,6 +281,10 @@ void TaskScheduler::setAlwaysQue(const bool alwaysQue) {
     mAlwaysQue = alwaysQue;
 }
 
+void TaskScheduler::setPlayheadFrame(const int frame) {
+    mQuedCGTasks.setPlayheadFrame(frame, mAlwaysQue);
+}
+
 void TaskScheduler::addComplexTask(const qsptr<ComplexTask> &task) {
     if(task->done()) return;
     mComplexTasks << task;
@@ -77,6 +77,11 @@ public:
 
     void setAlwaysQue(const bool alwaysQue);
 
+    //! @brief Frame the user is looking at, it is rendered first,
+    //! jumping away cancels work left behind (and ahead when not
+    //! rendering ahead of the playhead)
+    void setPlayheadFrame(const int frame);
+
     void addComplexTask(const qsptr<ComplexTask>& task);
 
     void enterCriticalMemoryState();
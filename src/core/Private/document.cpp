@@ -164,6 +164,7 @@ int Document::getActiveSceneFrame() const {
 void Document::setActiveSceneFrame(const int frame) {
     if(!fActiveScene) return;
     if(fActiveScene->anim_getCurrentRelFrame() == frame) return;
+    TaskScheduler::instance()->setPlayheadFrame(frame);
     fActiveScene->anim_setAbsFrame(frame);
     emit activeSceneFrameSet(frame);
 }
@@ -94,6 +94,7 @@ void Document::readScenes(eReadStream& src) {
         src.readCheckpoint("Error reading scene");
     }
 
+    src.processDecompressTasks();
     SimpleTask::sProcessAll();
 }
 
@@ -166,9 +166,42 @@ eSettings::eSettings(const int cpuThreads, const intKB ramKB,
     gSettings << std::make_shared<eBoolSetting>(
                      fHddCache,
                      "hddCache", true);
+    gSettings << std::make_shared<eStringSetting>(
+                     fHddCacheFolder,
+                     "hddCacheFolder", "");
     gSettings << std::make_shared<eIntSetting>(
                      reinterpret_cast<int&>(fHddCacheMBCap),
                      "hddCacheMBCap", 0);
+    gSettings << std::make_shared<eBoolSetting>(
+                     fRamCacheCompression,
+                     "ramCacheCompression", true);
+    gSettings << std::make_shared<eBoolSetting>(
+                     fPersistentCache,
+                     "persistentCache", false);
+    gSettings << std::make_shared<eStringSetting>(
+                     fPersistentCacheFolder,
+                     "persistentCacheFolder", "");
+    gSettings << std::make_shared<eIntSetting>(
+                     reinterpret_cast<int&>(fPersistentCacheMBCap),
+                     "persistentCacheMBCap", 2048);
+
+    gSettings << std::make_shared<eIntSetting>(
+                     fAudioBlockSize,
+                     "audioBlockSize", 2048);
+    gSettings << std::make_shared<eBoolSetting>(
+                     fScrubAudio,
+                     "scrubAudio", true);
+
+    gSettings << std::make_shared<eIntSetting>(
+                     fQuickSaveCap,
+                     "quickSaveCap", 5);
+    gSettings << std::make_shared<eIntSetting>(
+                     fAutoQuickSaveMin,
+                     "autoQuickSaveMin", 5);
+    gSettings << std::make_shared<eIntSetting>(
+                     fQuickSaveTarget,
+                     "quickSaveTarget",
+                     static_cast<int>(AutosaveTarget::dedicated_folder));
 
     gSettings << std::make_shared<eQrealSetting>(
                      fInterfaceScaling,
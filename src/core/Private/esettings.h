@@ -79,6 +79,14 @@ public:
     bool fHddCache = true;
     QString fHddCacheFolder = ""; // "" - use system default temporary files folder
     intMB fHddCacheMBCap = intMB(0); // <= 0 - no cap
+    bool fRamCacheCompression = true; // keep evicted scene frames compressed
+    bool fPersistentCache = false; // keep rendered scene frames between sessions
+    QString fPersistentCacheFolder = ""; // "" - use fUserSettingsDir/FrameCache
+    intMB fPersistentCacheMBCap = intMB(2048); // <= 0 - no cap
+
+    // audio
+    int fAudioBlockSize = 2048; // samples merged per playback block
+    bool fScrubAudio = true;
 
     // history
     int fUndoCap = 25; // <= 0 - no cap
@@ -89,8 +97,11 @@ public:
     };
 
     int fQuickSaveCap = 5; // <= 0 - no cap
-    int fAutoQuickSaveMin = 0; // <= 0 - disabled
-    AutosaveTarget fQuickSaveTarget = AutosaveTarget::same_folder;
+    int fAutoQuickSaveMin = 5; // <= 0 - disabled
+    int fQuickSaveTarget = static_cast<int>(AutosaveTarget::dedicated_folder);
+
+    AutosaveTarget quickSaveTarget() const
+    { return static_cast<AutosaveTarget>(fQuickSaveTarget); }
 
     // ui settings
     qreal fInterfaceScaling;
@@ -89,6 +89,11 @@ bool BoxTargetProperty::SWT_drop(const QMimeData * const data) {
 }
 
 void BoxTargetProperty::prp_writeProperty_impl(eWriteStream& dst) const {
+    if(dst.fingerprint()) {
+        // runtime ids differ between sessions, hash the target instead
+        dst << (mTarget_d ? dst.addFingerprintDep(mTarget_d) : -1);
+        return;
+    }
     int targetWriteId = -1;
     int targetDocumentId = -1;
 
@@ -24,16 +24,21 @@
 #include "canvas.h"
 
 Property::Property(const QString& name) :
-    prp_mName(name) {
-    connect(this, &Property::prp_ancestorChanged, this, [this]() {
-        const auto newScene = mParent_k ? mParent_k->mParentScene : nullptr;
-        if(mParentScene != newScene) {
-            const auto old = mParentScene;
-            mParentScene = newScene;
-            emit prp_sceneChanged(old, newScene);
-        }
-        emit prp_pathChanged();
-    });
+    prp_mName(name) {}
+
+void Property::prp_afterAncestorChanged() {
+    const auto newScene = mParent_k ? mParent_k->mParentScene : nullptr;
+    if(mParentScene != newScene) {
+        const auto old = mParentScene;
+        mParentScene = newScene;
+        emit prp_sceneChanged(old, newScene);
+    }
+    emit prp_ancestorChanged(QPrivateSignal());
+    emit prp_pathChanged();
+}
+
+void Property::prp_afterPathChanged() {
+    emit prp_pathChanged();
 }
 
 void Property::prp_updateCanvasProps() {
@@ -67,7 +72,14 @@ void Property::prp_setupTreeViewMenu(PropertyMenu * const menu) {
 void Property::prp_afterChangedAbsRange(const FrameRange &range,
                                         const bool clip) {
     prp_afterChangedCurrent(UpdateReason::userChange);
+    prp_emitAbsFrameRangeChanged(range, clip);
+}
+
+void Property::prp_emitAbsFrameRangeChanged(const FrameRange &range,
+                                            const bool clip) {
     emit prp_absFrameRangeChanged(range, clip);
+    if(prp_mParentInfluenced && prp_mNotifiedParent)
+        prp_mNotifiedParent->prp_afterChangedAbsRange(range, clip);
 }
 
 void Property::prp_readProperty(eReadStream& src) {
@@ -243,7 +255,7 @@ void Property::prp_setName(const QString &newName) {
     if(newName == prp_mName) return;
     prp_mName = newName;
     emit prp_nameChanged(newName, QPrivateSignal());
-    emit prp_pathChanged();
+    prp_afterPathChanged();
 }
 
 bool Property::prp_differencesBetweenRelFrames(
@@ -336,15 +348,15 @@ void Property::prp_pushUndoRedoName(const QString& name) {
 void Property::setParent(ComplexAnimator * const parent) {
     if(mParent_k == parent) return;
     auto& conn = mParent_k.assign(parent);
-    if(parent) {
+    if(parent && parent != prp_mNotifiedParent) {
         conn << connect(mParent_k, &Property::prp_ancestorChanged,
-                        this, &Property::prp_ancestorChanged);
+                        this, &Property::prp_afterAncestorChanged);
         conn << connect(mParent_k, &Property::prp_pathChanged,
-                        this, &Property::prp_pathChanged);
+                        this, &Property::prp_afterPathChanged);
     }
     if(mPointsHandler) mPointsHandler->setTransform(getTransformAnimator());
     emit prp_parentChanged(parent, QPrivateSignal());
-    emit prp_ancestorChanged(QPrivateSignal());
+    prp_afterAncestorChanged();
 }
 
 bool Property::prp_isParentBoxSelected() const {
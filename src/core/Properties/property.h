@@ -69,6 +69,7 @@ class CORE_EXPORT Property : public SingleWidgetTarget {
     e_OBJECT
     e_DECLARE_TYPE(Property)
     friend class SceneParentSelfAssign;
+    friend class ComplexAnimator;
 protected:
     Property(const QString &name);
 
@@ -124,6 +125,9 @@ public:
         Q_UNUSED(absFrameRange)
         Q_UNUSED(rowHeight)
     }
+    //! @brief False if the timeline controls show state that changes
+    //! without key or frame range signals, e.g. cache progress
+    virtual bool prp_timelineControlsCachable() const { return true; }
 
     virtual void prp_drawCanvasControls(
             SkCanvas * const canvas, const CanvasMode mode,
@@ -265,6 +269,15 @@ public:
 protected:
     void setPointsHandler(const stdsptr<PointsHandler>& handler);
 
+    //! @brief Emits prp_absFrameRangeChanged and passes the range
+    //! to the parent if the parent depends on this property
+    void prp_emitAbsFrameRangeChanged(const FrameRange &range,
+                                      const bool clip);
+    //! @brief ComplexAnimator that takes notifications from
+    //! this child through direct calls instead of connections
+    ComplexAnimator* prp_notifiedParent() const
+    { return prp_mNotifiedParent; }
+
     class SceneParentSelfAssign {
         friend class Canvas;
         SceneParentSelfAssign(Canvas * const scene) {
@@ -281,8 +294,15 @@ signals:
     void prp_pathChanged();
     void prp_sceneChanged(Canvas*, Canvas*);
 private:
+    virtual void prp_afterAncestorChanged();
+    virtual void prp_afterPathChanged();
+
     bool prp_mSelected = false;
     bool mDrawOnCanvas = false;
+    //! @brief Set by ComplexAnimator::ca_insertChild for the first parent,
+    //! other parents of a shared property still use connections
+    ComplexAnimator* prp_mNotifiedParent = nullptr;
+    bool prp_mParentInfluenced = false;
     int prp_mInheritedFrameShift = 0;
     QString prp_mName;
     ConnContextQPtr<Property> mParent_k;
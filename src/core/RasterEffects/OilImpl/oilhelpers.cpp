@@ -1,5 +1,7 @@
 #include "oilhelpers.h"
 
+#include "skia/skiaincludes.h"
+
 #define OFNOISE_FASTFLOOR(x) ( ((x)>0) ? ((int)x) : (((int)x)-1) )
 
 unsigned char perm[512] = {151,160,137,91,90,15,
@@ -63,3 +65,13 @@ inline float _slang_library_noise1 (float x) {
 float OilHelpers::ofNoise(float x) {
     return _slang_library_noise1(x)*0.5f + 0.5f;
 }
+
+thread_local SkRandom gOilRandom;
+
+void OilHelpers::seedRandom(uint32_t seed) {
+    gOilRandom.setSeed(seed);
+}
+
+float OilHelpers::randF(float min, float max) {
+    return min + gOilRandom.nextF()*(max - min);
+}
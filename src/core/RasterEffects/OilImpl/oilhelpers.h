@@ -1,8 +1,14 @@
 #ifndef OILHELPERS_H
 #define OILHELPERS_H
 
+#include <cstdint>
+
 namespace OilHelpers {
     float ofNoise(float x);
+
+    // per thread generator, seeded per tile for reproducible paintings
+    void seedRandom(uint32_t seed);
+    float randF(float min, float max);
 }
 
 #endif // OILHELPERS_H
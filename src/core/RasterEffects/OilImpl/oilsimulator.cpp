@@ -1,9 +1,12 @@
 #include "oilsimulator.h"
 #include "oiltrace.h"
+#include "oilhelpers.h"
 
 #include "skia/skiahelpers.h"
 #include "simplemath.h"
 
+using namespace OilHelpers;
+
 unsigned int OilSimulator::MAX_INVALID_TRAJECTORIES = 5000;
 
 unsigned int OilSimulator::MAX_INVALID_TRAJECTORIES_FOR_SMALLER_SIZE = 10000;
@@ -104,6 +107,10 @@ void OilSimulator::setImage(const SkBitmap& imagePixels, bool clearCanvas) {
 	nTraces = 0;
 }
 
+void OilSimulator::setPaintRect(const SkIRect& rect) {
+    mPaintRect = rect;
+}
+
 void OilSimulator::update(bool stepByStep) {
 	// Don't do anything if the painting is finished
 	if (paintingIsFinised) {
@@ -115,6 +122,12 @@ void OilSimulator::update(bool stepByStep) {
 		// Update the pixel arrays
 		updatePixelArrays();
 
+        // Nothing left to paint
+        if (nBadPaintedPixels == 0) {
+            paintingIsFinised = true;
+            return;
+        }
+
 		// Get a new trace
 		getNewTrace();
 	}
@@ -167,7 +180,13 @@ void OilSimulator::updatePixelArrays() {
     const int bgGreen = SkColorGetG(BACKGROUND_COLOR);
     const int bgBlue = SkColorGetB(BACKGROUND_COLOR);
 
-    for (unsigned int pixel = 0, nPixels = mImg.width() * mImg.height(); pixel < nPixels; ++pixel) {
+    const int width = mImg.width();
+    SkIRect paintRect = SkIRect::MakeWH(width, mImg.height());
+    if(!mPaintRect.isEmpty() && !paintRect.intersect(mPaintRect)) return;
+
+    for (int y = paintRect.top(); y < paintRect.bottom(); ++y) {
+    for (int x = paintRect.left(); x < paintRect.right(); ++x) {
+        unsigned int pixel = y*width + x;
 		unsigned int imgPix = pixel * imgNumChannels;
 		unsigned int canvasPix = pixel * canvasNumChannels;
 
@@ -182,6 +201,7 @@ void OilSimulator::updatePixelArrays() {
 			++nBadPaintedPixels;
 		}
 	}
+    }
 }
 
 void OilSimulator::updateVisitedPixels() {
@@ -255,12 +275,12 @@ void OilSimulator::getNewTrace() {
 
 			// Create new traces until one of them has a valid trajectory or we exceed a number of tries
 			bool isValidTrajectory = false;
-            float brushSize = qMax(SMALLER_BRUSH_SIZE, averageBrushSize * gSkRandF(0.95, 1.05));
-            int nSteps = qMax(MIN_TRACE_LENGTH, RELATIVE_TRACE_LENGTH * brushSize * gSkRandF(0.9, 1.1)) / TRACE_SPEED;
+            float brushSize = qMax(SMALLER_BRUSH_SIZE, averageBrushSize * randF(0.95, 1.05));
+            int nSteps = qMax(MIN_TRACE_LENGTH, RELATIVE_TRACE_LENGTH * brushSize * randF(0.9, 1.1)) / TRACE_SPEED;
 
 			while (!isValidTrajectory && invalidTrajectoriesCounter % 500 != 499) {
 				// Create the trace starting from a bad painted pixel
-                unsigned int pixel = badPaintedPixels[floor(gSkRandF(0, nBadPaintedPixels))];
+                unsigned int pixel = badPaintedPixels[floor(randF(0, nBadPaintedPixels))];
                 SkPoint startingPosition = SkPoint::Make(pixel % imgWidth, pixel / imgWidth);
                 trace = OilTrace(startingPosition, nSteps, TRACE_SPEED);
 
@@ -150,6 +150,12 @@ public:
 	 */
     void setImage(const SkBitmap& image, bool clearCanvas);
 
+    /**
+     * @brief Restricts where new traces can start, traces may still extend
+     * outside of it. An empty rect means the whole image.
+     */
+    void setPaintRect(const SkIRect& rect);
+
 	/**
 	 * @brief Updates the simulation
 	 *
@@ -241,6 +247,8 @@ protected:
 	 */
     SkBitmap mImg;
 
+    SkIRect mPaintRect = SkIRect::MakeEmpty();
+
 	/**
 	 * @brief The canvas where the oil painting is done
 	 */
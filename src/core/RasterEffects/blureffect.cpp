@@ -4,6 +4,7 @@
 #include "Boxes/containerbox.h"
 #include "svgexporthelpers.h"
 #include "svgexporter.h"
+#include "cpublur.h"
 
 class BlurEffectCaller : public RasterEffectCaller {
 public:
@@ -14,8 +15,18 @@ public:
                     GpuRenderTools& renderTools);
     void processCpu(CpuRenderTools& renderTools,
                     const CpuRenderData &data);
+
+    int cpuPasses() const { return 2; }
+    CpuTileSplit cpuTileSplit(const int pass) const {
+        return pass == 0 ? CpuTileSplit::rows : CpuTileSplit::columns;
+    }
+
+    bool supportsHighBitDepth() const {
+        return fHwSupport != HardwareSupport::gpuOnly;
+    }
 private:
     const float mRadius;
+    const CpuBlur::BoxRadii mBoxRadii;
 };
 
 BlurEffect::BlurEffect() :
@@ -77,7 +88,8 @@ QDomElement BlurEffect::saveBlurSVG(
 BlurEffectCaller::BlurEffectCaller(const HardwareSupport hwSupport,
                                    const qreal radius) :
     RasterEffectCaller(hwSupport, true, radiusToMargin(radius)),
-    mRadius(static_cast<float>(radius)) {}
+    mRadius(static_cast<float>(radius)),
+    mBoxRadii(mRadius*0.3333333f) {}
 
 
 void BlurEffectCaller::processGpu(QGL33 * const gl,
@@ -102,26 +114,13 @@ void BlurEffectCaller::processGpu(QGL33 * const gl,
 
 void BlurEffectCaller::processCpu(CpuRenderTools &renderTools,
                                   const CpuRenderData &data) {
-    Q_UNUSED(data)
-
-    const float sigma = mRadius*0.3333333f;
-    const auto filter = SkBlurImageFilter::Make(sigma, sigma, nullptr);
-
-    SkPaint paint;
-    paint.setImageFilter(filter);
-
-    SkCanvas canvas(renderTools.fDstBtmp);
-    canvas.clear(SK_ColorTRANSPARENT);
-
-    const int radCeil = static_cast<int>(ceil(mRadius));
-    const auto& srcBtmp = renderTools.fSrcBtmp;
-    const auto& texTile = data.fTexTile;
-    auto srcRect = texTile.makeOutset(radCeil, radCeil);
-    if(srcRect.intersect(srcRect, srcBtmp.bounds())) {
-        SkBitmap tileSrc;
-        srcBtmp.extractSubset(&tileSrc, srcRect);
-        const int drawX = srcRect.left() - texTile.left();
-        const int drawY = srcRect.top() - texTile.top();
-        canvas.drawBitmap(tileSrc, drawX, drawY, &paint);
+    SkPixmap src;
+    SkPixmap dst;
+    renderTools.fSrcBtmp.peekPixels(&src);
+    renderTools.fDstBtmp.peekPixels(&dst);
+    if(data.fPass == 0) {
+        CpuBlur::sBlurRows(src, dst, data.fTexTile, mBoxRadii);
+    } else {
+        CpuBlur::sBlurColumns(src, dst, data.fTexTile, mBoxRadii);
     }
 }
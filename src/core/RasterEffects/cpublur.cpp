@@ -0,0 +1,166 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "cpublur.h"
+
+#include <vector>
+#include <cmath>
+
+CpuBlur::BoxRadii::BoxRadii(const float sigma) {
+    // box widths approximating gaussian with three passes
+    const float s12 = 12*sigma*sigma;
+    const int wIdeal = static_cast<int>(std::sqrt(s12/3 + 1));
+    const int wl = wIdeal % 2 == 0 ? wIdeal - 1 : wIdeal;
+    const int wu = wl + 2;
+    const float mIdeal = (s12 - 3*wl*wl - 12*wl - 9)/(-4*wl - 4);
+    const int m = qRound(mIdeal);
+    for(int i = 0; i < 3; i++) {
+        const int w = i < m ? wl : wu;
+        fRadius[i] = qMax(0, (w - 1)/2);
+    }
+}
+
+//! @brief Box blur of n elements spaced by stride
+static void boxBlur(const Sk4f* const src, Sk4f* const dst,
+                    const int n, const int stride, const int r) {
+    const Sk4f inv(1.f/(2*r + 1));
+    Sk4f sum(0.f);
+    const int pre = qMin(r, n);
+    for(int i = 0; i < pre; i++) sum += src[i*stride];
+    for(int i = 0; i < n; i++) {
+        if(i + r < n) sum += src[(i + r)*stride];
+        dst[i*stride] = sum*inv;
+        if(i - r >= 0) sum -= src[(i - r)*stride];
+    }
+}
+
+//! @brief Three box blurs, returns the buffer holding the result
+static const Sk4f* boxBlur3(Sk4f* const bufA, Sk4f* const bufB,
+                            const int n, const int stride,
+                            const CpuBlur::BoxRadii& radii) {
+    boxBlur(bufA, bufB, n, stride, radii.fRadius[0]);
+    boxBlur(bufB, bufA, n, stride, radii.fRadius[1]);
+    boxBlur(bufA, bufB, n, stride, radii.fRadius[2]);
+    return bufB;
+}
+
+//! @brief Splits shift into an integer part and
+//! the weight of the preceding pixel
+static inline int splitShift(const float shift, float& frac) {
+    const float whole = std::floor(shift);
+    frac = shift - whole;
+    return static_cast<int>(whole);
+}
+
+static inline void storePixel(const Sk4f& value, const bool half,
+                              void* const dstLine, const int i) {
+    if(half) {
+        const auto scaled = Sk4f::Max(value, 0.f)*(1.f/255);
+        const float alpha = scaled[3];
+        const auto dst = static_cast<uint64_t*>(dstLine) + i;
+        SkFloatToHalf_finite_ftz(Sk4f::Min(scaled, alpha)).store(dst);
+        return;
+    }
+    const auto rounded = Sk4f::Min(Sk4f::Max(value + 0.5f, 0.f), 255.f);
+    // keep the result premultiplied
+    const float alpha = rounded[3];
+    const auto dst = static_cast<uint32_t*>(dstLine) + i;
+    SkNx_cast<uint8_t>(Sk4f::Min(rounded, alpha)).store(dst);
+}
+
+void CpuBlur::sBlurRows(const SkPixmap& src, const SkPixmap& dst,
+                        const SkIRect& rect, const BoxRadii& radii,
+                        const float shift) {
+    const int ext = radii.extent();
+    const int width = rect.width();
+    const int len = width + 2*ext;
+    std::vector<Sk4f> bufA(static_cast<size_t>(len));
+    std::vector<Sk4f> bufB(static_cast<size_t>(len));
+    float frac;
+    const int srcX0 = rect.left() - splitShift(shift, frac) - ext;
+    const Sk4f fracV(frac);
+    const Sk4f wholeV(1.f - frac);
+    const bool half = dst.colorType() == kRGBA_F16_SkColorType;
+    for(int y = rect.top(); y < rect.bottom(); y++) {
+        if(frac > 0.f) {
+            Sk4f prev = sLoadPixel(src, srcX0 - 1, y);
+            for(int i = 0; i < len; i++) {
+                const auto curr = sLoadPixel(src, srcX0 + i, y);
+                bufA[i] = curr*wholeV + prev*fracV;
+                prev = curr;
+            }
+        } else {
+            for(int i = 0; i < len; i++) {
+                bufA[i] = sLoadPixel(src, srcX0 + i, y);
+            }
+        }
+        const auto result = boxBlur3(bufA.data(), bufB.data(), len, 1, radii);
+        const auto dstLine = dst.writable_addr(0, y - rect.top());
+        for(int i = 0; i < width; i++) {
+            storePixel(result[ext + i], half, dstLine, i);
+        }
+    }
+}
+
+void CpuBlur::sBlurColumns(const SkPixmap& src, const SkPixmap& dst,
+                           const SkIRect& rect, const BoxRadii& radii,
+                           const float shift) {
+    // columns are processed in narrow strips to stay cache friendly
+    const int strip = 16;
+    const int ext = radii.extent();
+    const int height = rect.height();
+    const int len = height + 2*ext;
+    std::vector<Sk4f> bufA(static_cast<size_t>(len*strip));
+    std::vector<Sk4f> bufB(static_cast<size_t>(len*strip));
+    float frac;
+    const int srcY0 = rect.top() - splitShift(shift, frac) - ext;
+    const Sk4f fracV(frac);
+    const Sk4f wholeV(1.f - frac);
+    const bool half = dst.colorType() == kRGBA_F16_SkColorType;
+    for(int x0 = rect.left(); x0 < rect.right(); x0 += strip) {
+        const int stripWidth = qMin(strip, rect.right() - x0);
+        for(int i = 0; i < len; i++) {
+            const auto line = bufA.data() + i*strip;
+            for(int j = 0; j < stripWidth; j++) {
+                line[j] = sLoadPixel(src, x0 + j, srcY0 + i);
+            }
+        }
+        // bottom up, so that the preceding line is not interpolated yet
+        for(int i = frac > 0.f ? len - 1 : -1; i >= 0; i--) {
+            const auto line = bufA.data() + i*strip;
+            for(int j = 0; j < stripWidth; j++) {
+                const auto prev = i == 0 ?
+                            sLoadPixel(src, x0 + j, srcY0 - 1) :
+                            line[j - strip];
+                line[j] = line[j]*wholeV + prev*fracV;
+            }
+        }
+        const Sk4f* result = nullptr;
+        for(int j = 0; j < stripWidth; j++) {
+            result = boxBlur3(bufA.data() + j, bufB.data() + j,
+                              len, strip, radii) - j;
+        }
+        const int dstX0 = x0 - rect.left();
+        for(int i = 0; i < height; i++) {
+            const auto line = result + (i + ext)*strip;
+            const auto dstLine = dst.writable_addr(dstX0, i);
+            for(int j = 0; j < stripWidth; j++) {
+                storePixel(line[j], half, dstLine, j);
+            }
+        }
+    }
+}
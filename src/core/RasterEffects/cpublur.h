@@ -0,0 +1,67 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef CPUBLUR_H
+#define CPUBLUR_H
+
+#include "skia/skiaincludes.h"
+#include "include/private/SkNx.h"
+#include "include/private/SkHalf.h"
+
+//! @brief Separable gaussian blur approximation for cpu rendering.
+//! Three successive box blurs are computed with running sums,
+//! so the cost per pixel does not depend on the blur radius.
+//! Handles 8 bit and kRGBA_F16 pixmaps.
+namespace CpuBlur {
+    struct CORE_EXPORT BoxRadii {
+        BoxRadii(const float sigma);
+
+        //! @brief Number of pixels one pass reads on each side
+        int extent() const { return fRadius[0] + fRadius[1] + fRadius[2]; }
+        bool isZero() const { return extent() == 0; }
+
+        int fRadius[3];
+    };
+
+    //! @brief Loads a premultiplied pixel scaled to the 8 bit range,
+    //! pixels outside src are transparent
+    inline Sk4f sLoadPixel(const SkPixmap& src, const int x, const int y) {
+        if(x < 0 || y < 0 || x >= src.width() || y >= src.height())
+            return Sk4f(0.f);
+        if(src.colorType() == kRGBA_F16_SkColorType)
+            return SkHalfToFloat_finite_ftz(*src.addr64(x, y))*255.f;
+        return SkNx_cast<float>(Sk4b::Load(src.addr32(x, y)));
+    }
+
+    //! @brief Horizontal pass, writes rect of the blurred src to dst.
+    //! Pixel (x, y) of rect receives blurred src (x - shift, y),
+    //! fractional shifts are interpolated linearly,
+    //! pixels outside src are treated as transparent.
+    CORE_EXPORT
+    void sBlurRows(const SkPixmap& src, const SkPixmap& dst,
+                   const SkIRect& rect, const BoxRadii& radii,
+                   const float shift = 0.f);
+
+    //! @brief Vertical pass, pixel (x, y) of rect
+    //! receives blurred src (x, y - shift), see sBlurRows
+    CORE_EXPORT
+    void sBlurColumns(const SkPixmap& src, const SkPixmap& dst,
+                      const SkIRect& rect, const BoxRadii& radii,
+                      const float shift = 0.f);
+};
+
+#endif // CPUBLUR_H
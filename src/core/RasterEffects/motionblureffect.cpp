@@ -102,7 +102,19 @@ stdsptr<RasterEffectCaller> MotionBlurEffect::getEffectCaller(
 
     const int nSamples = qCeil(sampleCount);
     if(nSamples == 0) return nullptr;
-    qreal sampleRelFrame = relFrame - nSamples*frameStep;
+    const qreal firstSampleRelFrame = relFrame - nSamples*frameStep;
+    QList<qreal> sampleAbsFrames;
+    qreal sampleRelFrame = firstSampleRelFrame;
+    for(int i = 0; i < nSamples; i++) {
+        if(!idRange.inRange(sampleRelFrame)) {
+            sampleAbsFrames << mParentBox->prp_relFrameToAbsFrameF(sampleRelFrame);
+        }
+        sampleRelFrame += frameStep;
+    }
+    // evaluate the whole hierarchy once per sample frame up front
+    mParentBox->cacheTransformsAtAbsFrames(sampleAbsFrames);
+
+    sampleRelFrame = firstSampleRelFrame;
     QList<stdsptr<BoxRenderData>> samples;
     for(int i = 0; i < nSamples; i++) {
         if(!idRange.inRange(sampleRelFrame)) {
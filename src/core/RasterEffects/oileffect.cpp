@@ -2,7 +2,12 @@
 
 #include "Animators/qrealanimator.h"
 #include "OilImpl/oilsimulator.h"
+#include "OilImpl/oilhelpers.h"
 #include "ReadWrite/evformat.h"
+#include "Properties/newproperty.h"
+#include "CacheHandlers/cachecontainer.h"
+
+#include <QWaitCondition>
 
 #define TIME_BEGIN const auto t1 = std::chrono::high_resolution_clock::now();
 #define TIME_END(name) const auto t2 = std::chrono::high_resolution_clock::now(); \
@@ -11,9 +16,116 @@
 
 //#define OilEffect_TIMING
 
+class OilCellCache : public CacheContainer {
+    e_OBJECT
+protected:
+    OilCellCache() {}
+public:
+    struct Cell {
+        uint fHash = 0;
+        SkBitmap fPainted;
+    };
+
+    bool get(const int cx, const int cy, const uint hash, SkBitmap& painted) {
+        QMutexLocker lock(&mMutex);
+        const auto it = mCells.find(sKey(cx, cy));
+        if(it == mCells.end() || it->fHash != hash) return false;
+        painted = it->fPainted;
+        return true;
+    }
+
+    void set(const int cx, const int cy, const uint hash,
+             const SkBitmap& painted) {
+        QMutexLocker lock(&mMutex);
+        auto& cell = mCells[sKey(cx, cy)];
+        mBytes -= cell.fPainted.computeByteSize();
+        cell = {hash, painted};
+        mBytes += painted.computeByteSize();
+    }
+
+    void clear() {
+        QMutexLocker lock(&mMutex);
+        mCells.clear();
+        mBytes = 0;
+    }
+
+    //! @brief Call from the main thread when the cache is about to be used
+    void markUsed() { updateInMemoryManagment(); }
+
+    int getByteCount() {
+        QMutexLocker lock(&mMutex);
+        return static_cast<int>(qMin(mBytes, size_t(INT_MAX)));
+    }
+protected:
+    void noDataLeft_k() { clear(); }
+private:
+    static quint64 sKey(const int cx, const int cy) {
+        return (quint64(uint(cx)) << 32) | uint(cy);
+    }
+
+    QMutex mMutex;
+    QHash<quint64, Cell> mCells;
+    size_t mBytes = 0;
+};
+
+//! @brief Cells painted for a single frame, shared by the threads
+//! processing its tiles, so cells reaching several tiles are painted once
+class OilFrameCells {
+public:
+    //! @brief Returns true if the cell is painted, false if the caller
+    //! has to paint it and pass it to finish, or to fail if painting threw.
+    //! A failed cell is claimed again by the next waiting thread.
+    bool claim(const int cx, const int cy, SkBitmap& painted) {
+        QMutexLocker lock(&mMutex);
+        const auto key = sKey(cx, cy);
+        auto it = mCells.find(key);
+        if(it == mCells.end()) {
+            mCells.insert(key, Cell());
+            return false;
+        }
+        while(it->fState == CellState::painting) {
+            mCellDone.wait(&mMutex);
+            it = mCells.find(key);
+        }
+        if(it->fState == CellState::failed) {
+            it->fState = CellState::painting;
+            return false;
+        }
+        painted = it->fPainted;
+        return true;
+    }
+
+    void finish(const int cx, const int cy, const SkBitmap& painted) {
+        QMutexLocker lock(&mMutex);
+        mCells[sKey(cx, cy)] = {CellState::done, painted};
+        mCellDone.wakeAll();
+    }
+
+    void fail(const int cx, const int cy) {
+        QMutexLocker lock(&mMutex);
+        mCells[sKey(cx, cy)] = {CellState::failed, SkBitmap()};
+        mCellDone.wakeAll();
+    }
+private:
+    enum class CellState { painting, done, failed };
+    struct Cell {
+        CellState fState = CellState::painting;
+        SkBitmap fPainted;
+    };
+
+    static quint64 sKey(const int cx, const int cy) {
+        return (quint64(uint(cx)) << 32) | uint(cy);
+    }
+
+    QMutex mMutex;
+    QWaitCondition mCellDone;
+    QHash<quint64, Cell> mCells;
+};
+
 OilEffect::OilEffect() :
     RasterEffect("oil painting", HardwareSupport::cpuPreffered,
-                 true, RasterEffectType::OIL) {
+                 true, RasterEffectType::OIL),
+    mCellCache(enve::make_shared<OilCellCache>()) {
     mBrushSize = enve::make_shared<QPointFAnimator>(
         QPointF{16., 64.}, QPointF{4., 4.},
         QPointF{999.999, 999.999}, QPointF{1., 1.},
@@ -42,6 +154,14 @@ OilEffect::OilEffect() :
     mBristleDensity = enve::make_shared<QrealAnimator>(
                           0.7, 0, 1, 0.01, "bristle density");
     ca_addChild(mBristleDensity);
+
+    using TemporalType = NewProperty<BoolProperty, EvFormat::oilTemporalCoherence>;
+    mTemporalCoherence = enve::make_shared<TemporalType>("temporal coherence");
+    ca_addChild(mTemporalCoherence);
+    connect(mTemporalCoherence.get(), &BoolProperty::valueChanged,
+            this, [this](const bool value) {
+        if(!value) mCellCache->clear();
+    });
 }
 
 void OilEffect::prp_readProperty_impl(eReadStream &src) {
@@ -73,7 +193,8 @@ public:
                     const qreal bristleThickness,
                     const qreal bristleDensity,
                     const QMargins& margin,
-                    const HardwareSupport hwSupport) :
+                    const HardwareSupport hwSupport,
+                    const stdsptr<OilCellCache>& cellCache) :
         RasterEffectCaller(hwSupport, false, margin),
         mMinBrushSize(brushSize.x()),
         mMaxBrushSize(brushSize.y()),
@@ -82,14 +203,17 @@ public:
         mResolution(resolution),
         mMaxStrokes(maxStrokes),
         mBristleThickness(bristleThickness),
-        mBristleDensity(bristleDensity) {}
+        mBristleDensity(bristleDensity),
+        mCellCache(cellCache),
+        mParamsHash(sParamsHash({mMinBrushSize, mMaxBrushSize, mAccuracy,
+                                 mStrokeLength, mResolution, qreal(mMaxStrokes),
+                                 mBristleThickness, mBristleDensity})) {}
 
     int cpuThreads(const int available, const int area) const {
-        Q_UNUSED(available) Q_UNUSED(area)
-        return 1;
+        return qMin(area/(sCellSize*sCellSize) + 1, available);
     }
 
-    void setupSimulator(OilSimulator& simulator) {
+    void setupSimulator(OilSimulator& simulator) const {
         simulator.SMALLER_BRUSH_SIZE = mMinBrushSize;
         simulator.BIGGER_BRUSH_SIZE = mMaxBrushSize;
         const int accVal = 100*(1 - 0.7*mAccuracy);
@@ -102,19 +226,49 @@ public:
 
     void processCpu(CpuRenderTools& renderTools,
                     const CpuRenderData &data) {
-        Q_UNUSED(data);
         if(mMaxStrokes <= 0) return;
 #ifdef OilEffect_TIMING
         TIME_BEGIN
 #endif
-        OilSimulator simulator(renderTools.fDstBtmp, false, false);
-        setupSimulator(simulator);
+        const auto& src = renderTools.fSrcBtmp;
+        const auto bounds = SkIRect::MakeWH(src.width(), src.height());
+        const auto& tile = data.fTexTile;
+        const int overlap = qCeil(mStrokeLength*mMaxBrushSize);
+        const qreal totalArea = qreal(bounds.width())*bounds.height();
 
-        simulator.setImage(renderTools.fSrcBtmp, true);
+        SkCanvas canvas(renderTools.fDstBtmp);
+        canvas.clear(SK_ColorTRANSPARENT);
+        canvas.translate(-tile.x(), -tile.y());
 
-        for(int i = 0; i < mMaxStrokes; i++) {
-            simulator.update(false);
-            if(simulator.isFinished()) break;
+        // The image is painted in fixed cells, each with its own seed.
+        // Every cell reaching the tile is painted and composed in the same
+        // order, so the result does not depend on the number of threads.
+        const auto reach = tile.makeOutset(overlap, overlap);
+        const int minCX = qMax(0, reach.left())/sCellSize;
+        const int minCY = qMax(0, reach.top())/sCellSize;
+        const int maxCX = (qMin(bounds.right(), reach.right()) - 1)/sCellSize;
+        const int maxCY = (qMin(bounds.bottom(), reach.bottom()) - 1)/sCellSize;
+        for(int cy = minCY; cy <= maxCY; cy++) {
+            for(int cx = minCX; cx <= maxCX; cx++) {
+                const auto cell = SkIRect::MakeXYWH(cx*sCellSize, cy*sCellSize,
+                                                    sCellSize, sCellSize);
+                auto region = cell.makeOutset(overlap, overlap);
+                if(!region.intersect(bounds)) continue;
+                if(!SkIRect::Intersects(region, tile)) continue;
+                SkBitmap painted;
+                if(!mFrameCells.claim(cx, cy, painted)) {
+                    try {
+                        painted = paintCell(src, cx, cy, cell,
+                                            region, totalArea);
+                    } catch(...) {
+                        // do not leave other tiles waiting for this cell
+                        mFrameCells.fail(cx, cy);
+                        throw;
+                    }
+                    mFrameCells.finish(cx, cy, painted);
+                }
+                canvas.drawBitmap(painted, region.x(), region.y());
+            }
         }
 #ifdef OilEffect_TIMING
         TIME_END("CPU Oil Painting")
@@ -148,6 +302,7 @@ public:
 
         OilSimulator simulator(*canvas, false, false);
         setupSimulator(simulator);
+        OilHelpers::seedRandom(sCellSeed(0, 0));
 
         simulator.setImage(srcBtmp, true);
 
@@ -163,6 +318,59 @@ public:
 #endif
     }
 private:
+    //! @brief Side of the cells painted independently, in pixels
+    static const int sCellSize = 256;
+
+    static uint32_t sCellSeed(const int cx, const int cy) {
+        return uint32_t(cx)*73856093u ^ uint32_t(cy)*19349663u;
+    }
+
+    static uint sParamsHash(const std::initializer_list<qreal>& params) {
+        uint hash = 0;
+        for(const qreal param : params) hash = 31*hash + qHash(param);
+        return hash;
+    }
+
+    //! @brief Paints strokes starting within the cell,
+    //! they can extend over the whole region
+    SkBitmap paintCell(const SkBitmap& src, const int cx, const int cy,
+                       const SkIRect& cell, const SkIRect& region,
+                       const qreal totalArea) const {
+        const auto info = src.info().makeWH(region.width(), region.height());
+        SkBitmap cellSrc;
+        cellSrc.allocPixels(info);
+        src.readPixels(cellSrc.pixmap(), region.x(), region.y());
+
+        uint hash = 0;
+        if(mCellCache) {
+            hash = qHashBits(cellSrc.getPixels(), cellSrc.computeByteSize(),
+                             mParamsHash);
+            SkBitmap cached;
+            if(mCellCache->get(cx, cy, hash, cached)) return cached;
+        }
+
+        SkBitmap painted;
+        painted.allocPixels(info);
+        OilSimulator simulator(painted, false, false);
+        setupSimulator(simulator);
+        simulator.setImage(cellSrc, true);
+        simulator.setPaintRect(cell.makeOffset(-region.x(), -region.y()));
+        OilHelpers::seedRandom(sCellSeed(cx, cy));
+
+        // keep the stroke budget proportional to the cell area
+        auto inside = cell;
+        inside.intersect(region);
+        const qreal cellArea = qreal(inside.width())*inside.height();
+        const int maxStrokes = qCeil(mMaxStrokes*cellArea/totalArea);
+        for(int i = 0; i < maxStrokes; i++) {
+            simulator.update(false);
+            if(simulator.isFinished()) break;
+        }
+
+        if(mCellCache) mCellCache->set(cx, cy, hash, painted);
+        return painted;
+    }
+
     const qreal mMinBrushSize;
     const qreal mMaxBrushSize;
     const qreal mAccuracy;
@@ -171,6 +379,9 @@ private:
     const int mMaxStrokes;
     const qreal mBristleThickness;
     const qreal mBristleDensity;
+    const stdsptr<OilCellCache> mCellCache;
+    const uint mParamsHash;
+    OilFrameCells mFrameCells;
 };
 
 stdsptr<RasterEffectCaller> OilEffect::getEffectCaller(
@@ -185,7 +396,10 @@ stdsptr<RasterEffectCaller> OilEffect::getEffectCaller(
     const qreal thick = mBristleThickness->getEffectiveValue(relFrame)*resolution;
     const qreal den = mBristleDensity->getEffectiveValue(relFrame)/resolution;
     const QMargins margin = oilEffectMargin(len, size.y());
+    const bool temporal = mTemporalCoherence->getValue();
+    if(temporal) mCellCache->markUsed();
     return enve::make_shared<OilEffectCaller>(size, acc, len, resolution,
                                               maxStrokes, thick, den,
-                                              margin, instanceHwSupport());
+                                              margin, instanceHwSupport(),
+                                              temporal ? mCellCache : nullptr);
 }
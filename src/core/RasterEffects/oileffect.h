@@ -4,6 +4,9 @@
 #include "rastereffect.h"
 
 #include "Animators/qpointfanimator.h"
+#include "Properties/boolproperty.h"
+
+class OilCellCache;
 
 class CORE_EXPORT OilEffect : public RasterEffect {
     e_OBJECT
@@ -24,6 +27,11 @@ private:
     qsptr<QrealAnimator> mMaxStrokes;
     qsptr<QrealAnimator> mBristleThickness;
     qsptr<QrealAnimator> mBristleDensity;
+    qsptr<BoolProperty> mTemporalCoherence;
+
+    //! @brief Cells painted for the previous frame, reused
+    //! where the source pixels did not change
+    const stdsptr<OilCellCache> mCellCache;
 };
 
 #endif // OILEFFECT_H
@@ -24,6 +24,12 @@
 
 enum class HardwareSupport : short;
 
+enum class CpuTileSplit : short {
+    any,
+    rows, // tiles span whole rows
+    columns // tiles span whole columns
+};
+
 class CORE_EXPORT RasterEffectCaller : public StdSelfRef {
     e_OBJECT
 public:
@@ -45,8 +51,20 @@ public:
 
     virtual int cpuThreads(const int available, const int area) const;
 
+    //! @brief Number of cpu passes, each pass processes
+    //! the result of the previous one
+    virtual int cpuPasses() const { return 1; }
+    virtual CpuTileSplit cpuTileSplit(const int pass) const {
+        Q_UNUSED(pass)
+        return CpuTileSplit::any;
+    }
+
     virtual bool srcDstSeparation() const { return true; }
 
+    //! @brief Whether processCpu handles kRGBA_F16 pixels,
+    //! gpu textures are always 8 bit
+    virtual bool supportsHighBitDepth() const { return false; }
+
     HardwareSupport hardwareSupport() const {
         return fHwSupport;
     }
@@ -3,6 +3,7 @@
 #include "Boxes/containerbox.h"
 #include "svgexporter.h"
 #include "svgexporthelpers.h"
+#include "cpublur.h"
 
 class ShadowEffectCaller : public RasterEffectCaller {
 public:
@@ -16,19 +17,32 @@ public:
         mRadius(static_cast<float>(radius)),
         mColor(toSkColor(color)),
         mTranslation(toSkPoint(translation)),
-        mOpacity(static_cast<float>(opacity)) {}
+        mOpacity(static_cast<float>(opacity)),
+        mBoxRadii(mRadius*0.3333333f) {}
 
     void processGpu(QGL33 * const gl,
                     GpuRenderTools& renderTools);
     void processCpu(CpuRenderTools& renderTools,
                     const CpuRenderData &data);
+
+    int cpuPasses() const { return 2; }
+    CpuTileSplit cpuTileSplit(const int pass) const {
+        return pass == 0 ? CpuTileSplit::rows : CpuTileSplit::columns;
+    }
+
+    bool supportsHighBitDepth() const {
+        return fHwSupport != HardwareSupport::gpuOnly;
+    }
 private:
     void setupPaint(SkPaint& paint) const;
+    void drawShadowUnder(const SkPixmap& base, const SkPixmap& dst,
+                         const SkIRect& rect) const;
 
     const float mRadius;
     const SkColor mColor;
     const SkPoint mTranslation;
     const SkScalar mOpacity;
+    const CpuBlur::BoxRadii mBoxRadii;
 };
 
 ShadowEffect::ShadowEffect() :
@@ -146,31 +160,60 @@ void ShadowEffectCaller::processGpu(QGL33 * const gl,
     renderTools.swapTextures();
 }
 
+void ShadowEffectCaller::drawShadowUnder(const SkPixmap& base,
+                                         const SkPixmap& dst,
+                                         const SkIRect& rect) const {
+    const float a = SkColorGetA(mColor)/255.f;
+    const float r = SkColorGetR(mColor)*a;
+    const float g = SkColorGetG(mColor)*a;
+    const float b = SkColorGetB(mColor)*a;
+    const bool bgra = base.colorType() == kBGRA_8888_SkColorType;
+    const Sk4f color = (bgra ? Sk4f(b, g, r, 255*a) :
+                               Sk4f(r, g, b, 255*a))*(mOpacity/255.f);
+    const int aId = 3;
+    if(dst.colorType() == kRGBA_F16_SkColorType) {
+        const Sk4f colorF = color*(1.f/255);
+        for(int y = 0; y < rect.height(); y++) {
+            const auto baseLine = base.addr64(rect.left(), rect.top() + y);
+            const auto dstLine = dst.writable_addr64(0, y);
+            for(int x = 0; x < rect.width(); x++) {
+                const auto basePx = SkHalfToFloat_finite_ftz(baseLine[x]);
+                const auto shadowA = SkHalfToFloat_finite_ftz(dstLine[x])[aId];
+                const float baseInvA = 1.f - basePx[aId];
+                const auto result = basePx + colorF*(shadowA*baseInvA);
+                SkFloatToHalf_finite_ftz(result).store(dstLine + x);
+            }
+        }
+        return;
+    }
+    for(int y = 0; y < rect.height(); y++) {
+        const auto baseLine = base.addr32(rect.left(), rect.top() + y);
+        const auto dstLine = dst.writable_addr32(0, y);
+        for(int x = 0; x < rect.width(); x++) {
+            const auto basePx = SkNx_cast<float>(Sk4b::Load(baseLine + x));
+            const auto shadowA = SkNx_cast<float>(Sk4b::Load(dstLine + x))[aId];
+            const float baseInvA = 1.f - basePx[aId]/255.f;
+            const auto result = basePx + color*(shadowA*baseInvA);
+            const auto clamped = Sk4f::Min(result + 0.5f, 255.f);
+            SkNx_cast<uint8_t>(clamped).store(dstLine + x);
+        }
+    }
+}
+
 void ShadowEffectCaller::processCpu(CpuRenderTools &renderTools,
                                     const CpuRenderData &data) {
-    Q_UNUSED(data)
-    SkCanvas canvas(renderTools.fDstBtmp);
-    canvas.clear(SK_ColorTRANSPARENT);
-
-    const int radCeil = static_cast<int>(ceil(mRadius));
-    const auto& srcBtmp = renderTools.fSrcBtmp;
+    SkPixmap src;
+    SkPixmap dst;
+    renderTools.fSrcBtmp.peekPixels(&src);
+    renderTools.fDstBtmp.peekPixels(&dst);
     const auto& texTile = data.fTexTile;
-    auto srcRect = texTile.makeOutset(radCeil, radCeil);
-    const SkScalar dx = mTranslation.x();
-    const SkScalar dy = mTranslation.y();
-    const int ceilDX = isZero4Dec(dx) ? 0 : (dx > 0 ? qCeil(dx) : qFloor(dx));
-    const int ceilDY = isZero4Dec(dy) ? 0 : (dy > 0 ? qCeil(dy) : qFloor(dy));
-    srcRect.adjust(-ceilDX, -ceilDY, 0, 0);
-    if(srcRect.intersect(srcRect, srcBtmp.bounds())) {
-        SkBitmap tileSrc;
-        srcBtmp.extractSubset(&tileSrc, srcRect);
-        const int drawX = srcRect.left() - texTile.left();
-        const int drawY = srcRect.top() - texTile.top();
-
-        SkPaint paint;
-        setupPaint(paint);
-        canvas.drawBitmap(tileSrc, mTranslation.x() + drawX,
-                          mTranslation.y() + drawY, &paint);
-        canvas.drawBitmap(tileSrc, drawX, drawY);
+    // each pass shifts along its own axis, keeping the subpixel offset
+    if(data.fPass == 0) {
+        CpuBlur::sBlurRows(src, dst, texTile, mBoxRadii, mTranslation.x());
+    } else {
+        CpuBlur::sBlurColumns(src, dst, texTile, mBoxRadii, mTranslation.y());
+        SkPixmap base;
+        renderTools.fBaseBtmp.peekPixels(&base);
+        drawShadowUnder(base, dst, texTile);
     }
 }
@@ -6,6 +6,8 @@
 #include "evformat.h"
 #include "Boxes/boundingbox.h"
 
+#include <QtConcurrent/QtConcurrentMap>
+
 eReadFutureTable::eReadFutureTable(QIODevice * const main) : mMain(main) {}
 
 void eReadFutureTable::read() {
@@ -29,6 +31,7 @@ eReadStream::eReadStream(QIODevice * const src) :
     eReadStream(EvFormat::version, src) {}
 
 eReadStream::~eReadStream() {
+    processDecompressTasks();
     for(const auto& task : mDoneTasks) task(*this);
 }
 
@@ -72,6 +75,21 @@ QByteArray eReadStream::readCompressed() {
     return qUncompress(compressed);
 }
 
+void eReadStream::readCompressed(const DecompressTask& task) {
+    QByteArray compressed; *this >> compressed;
+    mDecompressJobs.append({compressed, task});
+}
+
+void eReadStream::processDecompressTasks() {
+    if(mDecompressJobs.isEmpty()) return;
+    auto jobs = mDecompressJobs;
+    mDecompressJobs.clear();
+    QtConcurrent::blockingMap(jobs, [](DecompressJob& job) {
+        job.fTask(qUncompress(job.fCompressed));
+        job.fCompressed.clear();
+    });
+}
+
 QString eReadStream::readFilePath() {
     QString readAbsPath; *this >> readAbsPath;
     if(mEvFileVersion < EvFormat::relativeFilePathSave) {
@@ -61,6 +61,12 @@ public:
     }
 
     QByteArray readCompressed();
+    using DecompressTask = std::function<void(const QByteArray&)>;
+    //! @brief Reads compressed data, decompression is deferred until
+    //! processDecompressTasks, where all pending data is decompressed
+    //! in parallel and passed to the corresponding task
+    void readCompressed(const DecompressTask& task);
+    void processDecompressTasks();
 
     eReadStream& operator>>(bool &val);
     eReadStream& operator>>(int &val);
@@ -86,8 +92,14 @@ public:
 
     int evFileVersion() const;
 private:
+    struct DecompressJob {
+        QByteArray fCompressed;
+        DecompressTask fTask;
+    };
+
     std::map<int, BoundingBox*> mReadBoxes;
     QList<ReadStreamDoneTask> mDoneTasks;
+    QList<DecompressJob> mDecompressJobs;
 
     const int mEvFileVersion;
     QIODevice* const mSrc;
@@ -29,6 +29,7 @@ namespace EvFormat {
         colorizeInfluence = 23,
         transformEffects = 24,
         transformEffects2 = 25,
+        oilTemporalCoherence = 26,
 
         nextVersion
     };
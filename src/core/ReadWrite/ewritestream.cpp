@@ -6,6 +6,9 @@
 #include "filefooter.h"
 #include "framerange.h"
 
+#include <QVector>
+#include <cstring>
+
 void eWriteFutureTable::write(eWriteStream &dst) {
     for(const auto& future : mFutures) {
         dst.write(&future, sizeof(eFuturePos));
@@ -13,6 +16,37 @@ void eWriteFutureTable::write(eWriteStream &dst) {
     dst << mFutures.count();
 }
 
+QByteArray eWriteDeferred::finish(const QByteArray& raw) const {
+    QList<QByteArray> compressed;
+    // number of bytes inserted by the first i blocks
+    QVector<qint64> shift{0};
+    for(const auto& block : mBlocks) {
+        compressed << qCompress(block.fData);
+        const qint64 size = compressed.last().size();
+        shift << shift.last() + static_cast<qint64>(sizeof(int)) + size;
+    }
+    QByteArray result;
+    result.reserve(static_cast<int>(raw.size() + shift.last()));
+    qint64 rawPos = 0;
+    for(int i = 0; i < mBlocks.count(); i++) {
+        const qint64 pos = mBlocks.at(i).fPos;
+        result.append(raw.constData() + rawPos, static_cast<int>(pos - rawPos));
+        const auto& block = compressed.at(i);
+        const int size = block.size();
+        result.append(reinterpret_cast<const char*>(&size), sizeof(int));
+        result.append(block);
+        rawPos = pos;
+    }
+    result.append(raw.constData() + rawPos,
+                  static_cast<int>(raw.size() - rawPos));
+    for(const auto& pos : mPositions) {
+        const qint64 value = pos.fValue + shift.at(pos.fValueBlocks);
+        const qint64 slot = pos.fSlot + shift.at(pos.fSlotBlocks);
+        std::memcpy(result.data() + slot, &value, sizeof(qint64));
+    }
+    return result;
+}
+
 eWriteStream::eWriteStream(QIODevice * const dst) : mDst(dst), mFutureTable(dst) {}
 
 void eWriteStream::setPath(const QString& path) {
@@ -20,19 +54,36 @@ void eWriteStream::setPath(const QString& path) {
 }
 
 void eWriteStream::writeFutureTable() {
+    if(mDeferred) {
+        const int nBlocks = mDeferred->mBlocks.count();
+        const auto& futures = mFutureTable.mFutures;
+        for(int i = 0; i < futures.count(); i++) {
+            const qint64 value = futures.at(i).fMain;
+            if(value < 0) continue;
+            const qint64 slot = mDst->pos() + i*qint64(sizeof(eFuturePos));
+            mDeferred->mPositions.append({slot, nBlocks,
+                                          value, mFutureBlocks.at(i)});
+        }
+    }
     mFutureTable.write(*this);
 }
 
 eWriteStream::FuturePosId eWriteStream::planFuturePos() {
+    mFutureBlocks << 0;
     return mFutureTable.planFuturePos();
 }
 
 void eWriteStream::assignFuturePos(const eWriteStream::FuturePosId id) {
     mFutureTable.assignFuturePos(id.fId);
+    if(mDeferred) mFutureBlocks[id.fId] = mDeferred->mBlocks.count();
 }
 
 void eWriteStream::writeCheckpoint() {
     const qint64 pos = mDst->pos();
+    if(mDeferred) {
+        const int nBlocks = mDeferred->mBlocks.count();
+        mDeferred->mPositions.append({pos, nBlocks, pos, nBlocks});
+    }
     write(&pos, sizeof(qint64));
 }
 
@@ -59,6 +110,11 @@ qint64 eWriteStream::writeFile(QFile * const file) {
 
 qint64 eWriteStream::writeCompressed(const void* const data, const qint64 len) {
     const auto charData = reinterpret_cast<const char*>(data);
+    if(mDeferred) {
+        const QByteArray copy(charData, static_cast<int>(len));
+        mDeferred->mBlocks.append({mDst->pos(), copy});
+        return len;
+    }
     const auto ba = QByteArray::fromRawData(charData, len);
     const auto compressed = qCompress(ba);
     *this << compressed;
@@ -8,6 +8,7 @@
 #include "../XML/runtimewriteid.h"
 
 class SimpleBrushWrapper;
+class BoundingBox;
 struct iValueRange;
 class eWriteStream;
 
@@ -33,6 +34,34 @@ private:
     QIODevice* const mMain;
 };
 
+//! @brief Lets the main thread take a quick snapshot of the document,
+//! blocks passed to writeCompressed are copied instead of compressed
+//! and finish inserts them later, e.g., from a background task
+class CORE_EXPORT eWriteDeferred {
+    friend class eWriteStream;
+public:
+    //! @brief Returns raw with compressed blocks inserted
+    //! and stored stream positions adjusted accordingly
+    QByteArray finish(const QByteArray& raw) const;
+private:
+    struct Block {
+        qint64 fPos;
+        QByteArray fData;
+    };
+
+    //! @brief Position fValue written at fSlot, both are raw positions
+    //! preceded by fValueBlocks and fSlotBlocks deferred blocks
+    struct Pos {
+        qint64 fSlot;
+        int fSlotBlocks;
+        qint64 fValue;
+        int fValueBlocks;
+    };
+
+    QList<Block> mBlocks;
+    QList<Pos> mPositions;
+};
+
 class CORE_EXPORT eWriteStream {
     friend class MainWindow;
 public:
@@ -46,6 +75,24 @@ public:
 
     void setPath(const QString& path);
 
+    //! @brief Defers compression, written data has to be passed
+    //! through eWriteDeferred::finish before it can be read
+    void setDeferred(eWriteDeferred* const deferred) { mDeferred = deferred; }
+
+    //! @brief Content is written only to be hashed, animators skip
+    //! current values derived from keys so the result is frame independent
+    void setFingerprint(const bool fingerprint) { mFingerprint = fingerprint; }
+    bool fingerprint() const { return mFingerprint; }
+    //! @brief Boxes (children, link targets) the fingerprint depends on,
+    //! their own fingerprints are appended by BoundingBox::fingerprint.
+    //! Returns the index to be written in place of the box.
+    int addFingerprintDep(BoundingBox* const box) {
+        mFingerprintDeps << box;
+        return mFingerprintDeps.count() - 1;
+    }
+    const QList<BoundingBox*>& fingerprintDeps() const
+    { return mFingerprintDeps; }
+
     RuntimeIdToWriteId& objListIdConv() { return mObjectListIdConv; }
 
     void writeFutureTable();
@@ -92,6 +139,10 @@ private:
     QDir mDir;
     eWriteFutureTable mFutureTable;
     RuntimeIdToWriteId mObjectListIdConv;
+    bool mFingerprint = false;
+    QList<BoundingBox*> mFingerprintDeps;
+    eWriteDeferred* mDeferred = nullptr;
+    QList<int> mFutureBlocks;
 };
 
 #endif // EWRITESTREAM_H
@@ -0,0 +1,152 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "arclengthtable.h"
+
+#include "cubiclist.h"
+
+#include <algorithm>
+
+static QPointF derivativeAt(const qCubicSegment2D& seg, const qreal t) {
+    const qreal oneMinusT = 1 - t;
+    return 3*(oneMinusT*oneMinusT*(seg.c1() - seg.p0()) +
+              2*oneMinusT*t*(seg.c2() - seg.c1()) +
+              t*t*(seg.p3() - seg.c2()));
+}
+
+static qreal speedAt(const qCubicSegment2D& seg, const qreal t) {
+    return pointToLen(derivativeAt(seg, t));
+}
+
+//! @brief Five point Gauss-Legendre integral of speed over [t0, t1]
+static qreal lengthBetween(const qCubicSegment2D& seg,
+                           const qreal t0, const qreal t1) {
+    static const qreal sX[] = { 0, 0.5384693101056831, 0.9061798459386640 };
+    static const qreal sW[] = { 0.5688888888888889,
+                                0.4786286704993665, 0.2369268850561891 };
+    const qreal half = 0.5*(t1 - t0);
+    const qreal mid = 0.5*(t0 + t1);
+    qreal sum = sW[0]*speedAt(seg, mid);
+    for(int i = 1; i < 3; i++) {
+        sum += sW[i]*(speedAt(seg, mid - half*sX[i]) +
+                      speedAt(seg, mid + half*sX[i]));
+    }
+    return sum*half;
+}
+
+ArcLengthTable::ArcLengthTable(const SkPath& path) {
+    QList<qCubicSegment2D> segs;
+    for(const auto& list : CubicList::sMakeFromSkPath(path)) {
+        segs << list.getSegments();
+    }
+    build(segs);
+}
+
+ArcLengthTable::ArcLengthTable(const QList<qCubicSegment2D>& segs) {
+    build(segs);
+}
+
+void ArcLengthTable::build(const QList<qCubicSegment2D>& segs) {
+    mSegments = segs;
+    mSegmentEnds.reserve(segs.count());
+    mSamples.reserve(segs.count()*sSamples);
+    qreal total = 0;
+    for(const auto& seg : segs) {
+        qreal segLen = 0;
+        for(int i = 0; i < sSamples; i++) {
+            segLen += lengthBetween(seg, qreal(i)/sSamples,
+                                    qreal(i + 1)/sSamples);
+            mSamples << segLen;
+        }
+        total += segLen;
+        mSegmentEnds << total;
+    }
+    mTotalLength = total;
+}
+
+qreal ArcLengthTable::lengthAtSegmentT(const int seg, const qreal t) const {
+    const int sample = qBound(0, static_cast<int>(t*sSamples), sSamples - 1);
+    const int id0 = seg*sSamples;
+    const qreal base = sample == 0 ? 0 : mSamples.at(id0 + sample - 1);
+    const qreal t0 = qreal(sample)/sSamples;
+    return base + lengthBetween(mSegments.at(seg), t0, t);
+}
+
+qreal ArcLengthTable::tAtSegmentLength(const int seg, const qreal len) const {
+    const int id0 = seg*sSamples;
+    const auto begin = mSamples.begin() + id0;
+    const auto end = begin + sSamples;
+    const int sample = qMin(sSamples - 1, static_cast<int>(
+                                std::lower_bound(begin, end, len) - begin));
+    const qreal len0 = sample == 0 ? 0 : mSamples.at(id0 + sample - 1);
+    const qreal len1 = mSamples.at(id0 + sample);
+    const qreal t0 = qreal(sample)/sSamples;
+    const qreal t1 = qreal(sample + 1)/sSamples;
+    if(isZero6Dec(len1 - len0)) return t0;
+    const qreal guess = t0 + (len - len0)/(len1 - len0)*(t1 - t0);
+    const auto& cubic = mSegments.at(seg);
+    const qreal speed = speedAt(cubic, guess);
+    if(isZero6Dec(speed)) return guess;
+    const qreal err = len0 + lengthBetween(cubic, t0, guess) - len;
+    return qBound(t0, guess - err/speed, t1);
+}
+
+int ArcLengthTable::segmentAtLength(const qreal len, qreal& t) const {
+    if(len <= 0) {
+        t = 0;
+        return 0;
+    }
+    const auto it = std::lower_bound(mSegmentEnds.begin(),
+                                     mSegmentEnds.end(), len);
+    if(it == mSegmentEnds.end()) {
+        t = 1;
+        return mSegments.count() - 1;
+    }
+    const int seg = static_cast<int>(it - mSegmentEnds.begin());
+    const qreal segStart = seg == 0 ? 0 : mSegmentEnds.at(seg - 1);
+    t = tAtSegmentLength(seg, len - segStart);
+    return seg;
+}
+
+qreal ArcLengthTable::lengthAtPercent(const qreal per) const {
+    if(isEmpty() || per <= 0) return 0;
+    if(per >= 1) return mTotalLength;
+    const qreal len = per*mTotalLength;
+    const auto it = std::lower_bound(mSegmentEnds.begin(),
+                                     mSegmentEnds.end(), len);
+    if(it == mSegmentEnds.end()) return mTotalLength;
+    const int seg = static_cast<int>(it - mSegmentEnds.begin());
+    const qreal segStart = seg == 0 ? 0 : mSegmentEnds.at(seg - 1);
+    const qreal segLen = mSegmentEnds.at(seg) - segStart;
+    if(isZero6Dec(segLen)) return segStart;
+    // percent is linear in t within a segment
+    const qreal t = (len - segStart)/segLen;
+    return segStart + lengthAtSegmentT(seg, t);
+}
+
+QPointF ArcLengthTable::posAtLength(const qreal len) const {
+    if(isEmpty()) return QPointF(0, 0);
+    qreal t;
+    const int seg = segmentAtLength(len, t);
+    return mSegments.at(seg).posAtT(t);
+}
+
+PosAndTan ArcLengthTable::posAndTanAtLength(const qreal len) const {
+    if(isEmpty()) return { QPointF(0, 0), QPointF(0, 0) };
+    qreal t;
+    const int seg = segmentAtLength(len, t);
+    return mSegments.at(seg).posAndTanAtT(t);
+}
@@ -0,0 +1,61 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef ARCLENGTHTABLE_H
+#define ARCLENGTHTABLE_H
+
+#include "qcubicsegment2d.h"
+
+#include <QList>
+#include <QVector>
+
+//! @brief Cumulative arc lengths of a path with fast inverse lookup.
+//! Each segment is split into sSamples intervals measured with
+//! Gauss-Legendre quadrature, lookups use binary search and
+//! a single Newton refinement within the interval.
+class CORE_EXPORT ArcLengthTable {
+public:
+    ArcLengthTable() {}
+    ArcLengthTable(const SkPath& path);
+    ArcLengthTable(const QList<qCubicSegment2D>& segs);
+
+    bool isEmpty() const { return mSegments.isEmpty(); }
+    qreal totalLength() const { return mTotalLength; }
+
+    //! @brief Maps QPainterPath::pointAtPercent percent to arc length
+    qreal lengthAtPercent(const qreal per) const;
+
+    QPointF posAtLength(const qreal len) const;
+    PosAndTan posAndTanAtLength(const qreal len) const;
+private:
+    void build(const QList<qCubicSegment2D>& segs);
+
+    //! @brief Finds segment and its t at arc length len
+    int segmentAtLength(const qreal len, qreal& t) const;
+    qreal tAtSegmentLength(const int seg, const qreal len) const;
+    qreal lengthAtSegmentT(const int seg, const qreal t) const;
+
+    static const int sSamples = 16;
+
+    qreal mTotalLength = 0;
+    QList<qCubicSegment2D> mSegments;
+    //! @brief Path length at the end of each segment
+    QVector<qreal> mSegmentEnds;
+    //! @brief Segment length at the end of each sample interval
+    QVector<qreal> mSamples;
+};
+
+#endif // ARCLENGTHTABLE_H
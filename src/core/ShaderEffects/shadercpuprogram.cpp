@@ -0,0 +1,1593 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "shadercpuprogram.h"
+
+#include "exceptions.h"
+
+#include <QFile>
+
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using Value = ShaderCpuValue;
+using Kind = ShaderCpuValue::Kind;
+
+namespace {
+
+struct Type {
+    Kind fKind;
+    int fSize;
+};
+
+Value convert(const Value& value, const Type& type) {
+    Value result = value;
+    result.fKind = type.fKind;
+    result.fSize = static_cast<short>(type.fSize);
+    if(value.fSize == 1) {
+        for(int i = 1; i < type.fSize; i++) result.fV[i] = value.fV[0];
+    }
+    for(int i = 0; i < type.fSize; i++) {
+        float& v = result.fV[i];
+        if(type.fKind == Kind::Int) v = std::trunc(v);
+        else if(type.fKind == Kind::Bool) v = v != 0.f ? 1.f : 0.f;
+    }
+    return result;
+}
+
+struct Context {
+    std::vector<Value> fSlots;
+    const SkPixmap* fSrc = nullptr;
+    Value fReturn;
+    bool fDiscarded = false;
+};
+
+// Expressions
+
+struct Expr {
+    virtual ~Expr() {}
+    virtual Value eval(Context& ctx) const = 0;
+    virtual bool isLValue() const { return false; }
+    virtual void assign(Context& ctx, const Value& value) const {
+        Q_UNUSED(ctx) Q_UNUSED(value)
+    }
+};
+using ExprPtr = std::unique_ptr<Expr>;
+
+struct Literal : public Expr {
+    Literal(const Value& value) : fValue(value) {}
+    Value eval(Context&) const { return fValue; }
+    const Value fValue;
+};
+
+struct VarRef : public Expr {
+    VarRef(const int slot, const Type& type, const bool constant) :
+        fSlot(slot), fType(type), fConst(constant) {}
+    Value eval(Context& ctx) const { return ctx.fSlots[fSlot]; }
+    bool isLValue() const { return !fConst; }
+    void assign(Context& ctx, const Value& value) const {
+        ctx.fSlots[fSlot] = convert(value, fType);
+    }
+    const int fSlot;
+    const Type fType;
+    const bool fConst;
+};
+
+struct Swizzle : public Expr {
+    Swizzle(ExprPtr&& base, const std::vector<int>& ids) :
+        fBase(std::move(base)), fIds(ids) {}
+    Value eval(Context& ctx) const {
+        const Value base = fBase->eval(ctx);
+        Value result(base.fKind, static_cast<int>(fIds.size()));
+        for(uint i = 0; i < fIds.size(); i++) result.fV[i] = base.fV[fIds[i]];
+        return result;
+    }
+    bool isLValue() const { return fBase->isLValue(); }
+    void assign(Context& ctx, const Value& value) const {
+        Value base = fBase->eval(ctx);
+        const bool scalar = value.fSize == 1;
+        for(uint i = 0; i < fIds.size(); i++) {
+            base.fV[fIds[i]] = value.fV[scalar ? 0 : i];
+        }
+        fBase->assign(ctx, base);
+    }
+    const ExprPtr fBase;
+    const std::vector<int> fIds;
+};
+
+struct Index : public Expr {
+    Index(ExprPtr&& base, ExprPtr&& index) :
+        fBase(std::move(base)), fIndex(std::move(index)) {}
+    int index(Context& ctx, const Value& base) const {
+        const int id = static_cast<int>(fIndex->eval(ctx).fV[0]);
+        if(id < 0 || id >= base.fSize) RuntimeThrow("Index out of range");
+        return id;
+    }
+    Value eval(Context& ctx) const {
+        const Value base = fBase->eval(ctx);
+        return Value(base.fKind, 1, base.fV[index(ctx, base)]);
+    }
+    bool isLValue() const { return fBase->isLValue(); }
+    void assign(Context& ctx, const Value& value) const {
+        Value base = fBase->eval(ctx);
+        base.fV[index(ctx, base)] = value.fV[0];
+        fBase->assign(ctx, base);
+    }
+    const ExprPtr fBase;
+    const ExprPtr fIndex;
+};
+
+Kind arithmeticKind(const Value& a, const Value& b) {
+    if(a.fKind == Kind::Float || b.fKind == Kind::Float) return Kind::Float;
+    return Kind::Int;
+}
+
+enum class Op {
+    add, sub, mul, div, mod,
+    lt, gt, le, ge, eq, ne,
+    land, lor, lxor
+};
+
+Value arithmetic(const Op op, const Value& a, const Value& b) {
+    const Kind kind = arithmeticKind(a, b);
+    const int size = qMax(a.fSize, b.fSize);
+    Value result(kind, size);
+    for(int i = 0; i < size; i++) {
+        const float x = a.fV[a.fSize == 1 ? 0 : i];
+        const float y = b.fV[b.fSize == 1 ? 0 : i];
+        float& r = result.fV[i];
+        switch(op) {
+        case Op::add: r = x + y; break;
+        case Op::sub: r = x - y; break;
+        case Op::mul: r = x*y; break;
+        case Op::div:
+            if(kind == Kind::Int) r = y == 0.f ? 0.f : std::trunc(x/y);
+            else r = x/y;
+            break;
+        case Op::mod:
+            if(y == 0.f) r = 0.f;
+            else r = static_cast<float>(static_cast<int>(x) % static_cast<int>(y));
+            break;
+        default: break;
+        }
+    }
+    return result;
+}
+
+bool equal(const Value& a, const Value& b) {
+    const int size = qMax(a.fSize, b.fSize);
+    for(int i = 0; i < size; i++) {
+        if(a.fV[a.fSize == 1 ? 0 : i] != b.fV[b.fSize == 1 ? 0 : i])
+            return false;
+    }
+    return true;
+}
+
+Value boolValue(const bool value) {
+    return Value(Kind::Bool, 1, value ? 1.f : 0.f);
+}
+
+struct Binary : public Expr {
+    Binary(const Op op, ExprPtr&& left, ExprPtr&& right) :
+        fOp(op), fLeft(std::move(left)), fRight(std::move(right)) {}
+    Value eval(Context& ctx) const {
+        switch(fOp) {
+        case Op::land:
+            if(!fLeft->eval(ctx).isTrue()) return boolValue(false);
+            return boolValue(fRight->eval(ctx).isTrue());
+        case Op::lor:
+            if(fLeft->eval(ctx).isTrue()) return boolValue(true);
+            return boolValue(fRight->eval(ctx).isTrue());
+        default: break;
+        }
+        const Value a = fLeft->eval(ctx);
+        const Value b = fRight->eval(ctx);
+        switch(fOp) {
+        case Op::lt: return boolValue(a.fV[0] < b.fV[0]);
+        case Op::gt: return boolValue(a.fV[0] > b.fV[0]);
+        case Op::le: return boolValue(a.fV[0] <= b.fV[0]);
+        case Op::ge: return boolValue(a.fV[0] >= b.fV[0]);
+        case Op::eq: return boolValue(equal(a, b));
+        case Op::ne: return boolValue(!equal(a, b));
+        case Op::lxor: return boolValue(a.isTrue() != b.isTrue());
+        default: return arithmetic(fOp, a, b);
+        }
+    }
+    const Op fOp;
+    const ExprPtr fLeft;
+    const ExprPtr fRight;
+};
+
+struct Negate : public Expr {
+    Negate(ExprPtr&& expr) : fExpr(std::move(expr)) {}
+    Value eval(Context& ctx) const {
+        Value value = fExpr->eval(ctx);
+        for(int i = 0; i < value.fSize; i++) value.fV[i] = -value.fV[i];
+        return value;
+    }
+    const ExprPtr fExpr;
+};
+
+struct Not : public Expr {
+    Not(ExprPtr&& expr) : fExpr(std::move(expr)) {}
+    Value eval(Context& ctx) const {
+        return boolValue(!fExpr->eval(ctx).isTrue());
+    }
+    const ExprPtr fExpr;
+};
+
+struct Ternary : public Expr {
+    Ternary(ExprPtr&& cond, ExprPtr&& a, ExprPtr&& b) :
+        fCond(std::move(cond)), fA(std::move(a)), fB(std::move(b)) {}
+    Value eval(Context& ctx) const {
+        return fCond->eval(ctx).isTrue() ? fA->eval(ctx) : fB->eval(ctx);
+    }
+    const ExprPtr fCond;
+    const ExprPtr fA;
+    const ExprPtr fB;
+};
+
+struct Assign : public Expr {
+    //! @brief op is one of add, sub, mul, div, mod for compound assignment
+    Assign(ExprPtr&& target, ExprPtr&& value,
+           const bool compound, const Op op) :
+        fTarget(std::move(target)), fValue(std::move(value)),
+        fCompound(compound), fOp(op) {}
+    Value eval(Context& ctx) const {
+        Value value = fValue->eval(ctx);
+        if(fCompound) value = arithmetic(fOp, fTarget->eval(ctx), value);
+        fTarget->assign(ctx, value);
+        return fTarget->eval(ctx);
+    }
+    const ExprPtr fTarget;
+    const ExprPtr fValue;
+    const bool fCompound;
+    const Op fOp;
+};
+
+struct IncDec : public Expr {
+    IncDec(ExprPtr&& target, const float delta, const bool prefix) :
+        fTarget(std::move(target)), fDelta(delta), fPrefix(prefix) {}
+    Value eval(Context& ctx) const {
+        const Value old = fTarget->eval(ctx);
+        Value value = old;
+        for(int i = 0; i < value.fSize; i++) value.fV[i] += fDelta;
+        fTarget->assign(ctx, value);
+        return fPrefix ? fTarget->eval(ctx) : old;
+    }
+    const ExprPtr fTarget;
+    const float fDelta;
+    const bool fPrefix;
+};
+
+struct Constructor : public Expr {
+    Constructor(const Type& type, std::vector<ExprPtr>&& args) :
+        fType(type), fArgs(std::move(args)) {}
+    Value eval(Context& ctx) const {
+        if(fArgs.size() == 1) {
+            const Value arg = fArgs.front()->eval(ctx);
+            if(arg.fSize == 1 || arg.fSize >= fType.fSize) {
+                Value trimmed = arg;
+                trimmed.fSize = static_cast<short>(qMin<int>(arg.fSize, fType.fSize));
+                return convert(trimmed, fType);
+            }
+        }
+        Value result(fType.fKind, fType.fSize);
+        int n = 0;
+        for(const auto& argExpr : fArgs) {
+            const Value arg = argExpr->eval(ctx);
+            for(int i = 0; i < arg.fSize && n < fType.fSize; i++) {
+                result.fV[n++] = arg.fV[i];
+            }
+        }
+        return convert(result, fType);
+    }
+    const Type fType;
+    const std::vector<ExprPtr> fArgs;
+};
+
+// Statements
+
+enum class Flow { next, brk, cont, ret };
+
+struct Stmt {
+    virtual ~Stmt() {}
+    virtual Flow exec(Context& ctx) const = 0;
+};
+using StmtPtr = std::unique_ptr<Stmt>;
+
+struct ExprStmt : public Stmt {
+    ExprStmt(ExprPtr&& expr) : fExpr(std::move(expr)) {}
+    Flow exec(Context& ctx) const {
+        fExpr->eval(ctx);
+        return Flow::next;
+    }
+    const ExprPtr fExpr;
+};
+
+struct DeclStmt : public Stmt {
+    DeclStmt(const int slot, const Type& type, ExprPtr&& init) :
+        fSlot(slot), fType(type), fInit(std::move(init)) {}
+    Flow exec(Context& ctx) const {
+        const Value value = fInit ? fInit->eval(ctx) :
+                                    Value(fType.fKind, fType.fSize);
+        ctx.fSlots[fSlot] = convert(value, fType);
+        return Flow::next;
+    }
+    const int fSlot;
+    const Type fType;
+    const ExprPtr fInit;
+};
+
+struct Block : public Stmt {
+    Flow exec(Context& ctx) const {
+        for(const auto& stmt : fStmts) {
+            const Flow flow = stmt->exec(ctx);
+            if(flow != Flow::next) return flow;
+        }
+        return Flow::next;
+    }
+    std::vector<StmtPtr> fStmts;
+};
+
+struct If : public Stmt {
+    If(ExprPtr&& cond, StmtPtr&& a, StmtPtr&& b) :
+        fCond(std::move(cond)), fA(std::move(a)), fB(std::move(b)) {}
+    Flow exec(Context& ctx) const {
+        if(fCond->eval(ctx).isTrue()) return fA->exec(ctx);
+        if(fB) return fB->exec(ctx);
+        return Flow::next;
+    }
+    const ExprPtr fCond;
+    const StmtPtr fA;
+    const StmtPtr fB;
+};
+
+//! @brief Guards worker threads against shaders that never finish
+const int sMaxLoopIterations = 1 << 20;
+
+struct Loop : public Stmt {
+    Loop(StmtPtr&& init, ExprPtr&& cond, ExprPtr&& step,
+         StmtPtr&& body, const bool checkFirst) :
+        fInit(std::move(init)), fCond(std::move(cond)),
+        fStep(std::move(step)), fBody(std::move(body)),
+        fCheckFirst(checkFirst) {}
+    Flow exec(Context& ctx) const {
+        if(fInit) fInit->exec(ctx);
+        for(int i = 0;; i++) {
+            if(i >= sMaxLoopIterations) RuntimeThrow("Loop limit exceeded");
+            if((fCheckFirst || i > 0) && fCond && !fCond->eval(ctx).isTrue())
+                break;
+            const Flow flow = fBody->exec(ctx);
+            if(flow == Flow::brk) break;
+            if(flow == Flow::ret) return flow;
+            if(fStep) fStep->eval(ctx);
+        }
+        return Flow::next;
+    }
+    const StmtPtr fInit;
+    const ExprPtr fCond;
+    const ExprPtr fStep;
+    const StmtPtr fBody;
+    const bool fCheckFirst;
+};
+
+struct Jump : public Stmt {
+    Jump(const Flow flow) : fFlow(flow) {}
+    Flow exec(Context&) const { return fFlow; }
+    const Flow fFlow;
+};
+
+struct Return : public Stmt {
+    Return(ExprPtr&& expr) : fExpr(std::move(expr)) {}
+    Flow exec(Context& ctx) const {
+        if(fExpr) ctx.fReturn = fExpr->eval(ctx);
+        return Flow::ret;
+    }
+    const ExprPtr fExpr;
+};
+
+struct Discard : public Stmt {
+    Flow exec(Context& ctx) const {
+        ctx.fDiscarded = true;
+        return Flow::ret;
+    }
+};
+
+// Functions
+
+enum class ParamQualifier { in, out, inout };
+
+struct Param {
+    int fSlot;
+    Type fType;
+    ParamQualifier fQualifier;
+};
+
+struct Function {
+    std::string fName;
+    Type fReturnType;
+    std::vector<Param> fParams;
+    std::unique_ptr<Block> fBody;
+};
+
+const uint sMaxParams = 16;
+
+struct Call : public Expr {
+    Call(const Function* const func, std::vector<ExprPtr>&& args) :
+        fFunc(func), fArgs(std::move(args)) {}
+    Value eval(Context& ctx) const {
+        const auto& params = fFunc->fParams;
+        Value args[sMaxParams];
+        for(uint i = 0; i < params.size(); i++) {
+            if(params[i].fQualifier != ParamQualifier::out)
+                args[i] = fArgs[i]->eval(ctx);
+            else args[i] = Value(params[i].fType.fKind, params[i].fType.fSize);
+        }
+        for(uint i = 0; i < params.size(); i++) {
+            ctx.fSlots[params[i].fSlot] = convert(args[i], params[i].fType);
+        }
+        if(!fFunc->fBody) RuntimeThrow("'" + fFunc->fName + "' is not defined");
+        ctx.fReturn = Value(fFunc->fReturnType.fKind, fFunc->fReturnType.fSize);
+        fFunc->fBody->exec(ctx);
+        const Value result = ctx.fReturn;
+        for(uint i = 0; i < params.size(); i++) {
+            if(params[i].fQualifier == ParamQualifier::in) continue;
+            fArgs[i]->assign(ctx, ctx.fSlots[params[i].fSlot]);
+        }
+        return result;
+    }
+    const Function* const fFunc;
+    const std::vector<ExprPtr> fArgs;
+};
+
+// Built-in functions
+
+typedef float (*Func1)(float);
+typedef float (*Func2)(float, float);
+typedef float (*Func3)(float, float, float);
+
+float fSign(float x) { return x > 0 ? 1.f : (x < 0 ? -1.f : 0.f); }
+float fFract(float x) { return x - std::floor(x); }
+float fInvSqrt(float x) { return 1.f/std::sqrt(x); }
+float fRadians(float x) { return x*0.01745329251f; }
+float fDegrees(float x) { return x*57.2957795131f; }
+float fRound(float x) { return std::round(x); }
+float fMod(float x, float y) { return x - y*std::floor(x/y); }
+float fMin(float x, float y) { return y < x ? y : x; }
+float fMax(float x, float y) { return x < y ? y : x; }
+float fStep(float edge, float x) { return x < edge ? 0.f : 1.f; }
+float fClamp(float x, float a, float b) { return fMin(fMax(x, a), b); }
+float fMix(float x, float y, float a) { return x*(1 - a) + y*a; }
+float fSmoothstep(float e0, float e1, float x) {
+    const float t = fClamp((x - e0)/(e1 - e0), 0.f, 1.f);
+    return t*t*(3 - 2*t);
+}
+
+float cAbs(float x) { return std::abs(x); }
+float cFloor(float x) { return std::floor(x); }
+float cCeil(float x) { return std::ceil(x); }
+float cTrunc(float x) { return std::trunc(x); }
+float cSqrt(float x) { return std::sqrt(x); }
+float cExp(float x) { return std::exp(x); }
+float cExp2(float x) { return std::exp2(x); }
+float cLog(float x) { return std::log(x); }
+float cLog2(float x) { return std::log2(x); }
+float cSin(float x) { return std::sin(x); }
+float cCos(float x) { return std::cos(x); }
+float cTan(float x) { return std::tan(x); }
+float cAsin(float x) { return std::asin(x); }
+float cAcos(float x) { return std::acos(x); }
+float cAtan(float x) { return std::atan(x); }
+float cAtan2(float y, float x) { return std::atan2(y, x); }
+float cPow(float x, float y) { return std::pow(x, y); }
+
+struct Builtin1 : public Expr {
+    Builtin1(const Func1 func, ExprPtr&& a, const bool keepInt) :
+        fFunc(func), fA(std::move(a)), fKeepInt(keepInt) {}
+    Value eval(Context& ctx) const {
+        Value value = fA->eval(ctx);
+        if(!fKeepInt) value.fKind = Kind::Float;
+        for(int i = 0; i < value.fSize; i++) value.fV[i] = fFunc(value.fV[i]);
+        return value;
+    }
+    const Func1 fFunc;
+    const ExprPtr fA;
+    const bool fKeepInt;
+};
+
+struct Builtin2 : public Expr {
+    Builtin2(const Func2 func, ExprPtr&& a, ExprPtr&& b, const bool keepInt) :
+        fFunc(func), fA(std::move(a)), fB(std::move(b)), fKeepInt(keepInt) {}
+    Value eval(Context& ctx) const {
+        const Value a = fA->eval(ctx);
+        const Value b = fB->eval(ctx);
+        const Kind kind = fKeepInt ? arithmeticKind(a, b) : Kind::Float;
+        Value result(kind, qMax(a.fSize, b.fSize));
+        for(int i = 0; i < result.fSize; i++) {
+            result.fV[i] = fFunc(a.fV[a.fSize == 1 ? 0 : i],
+                                 b.fV[b.fSize == 1 ? 0 : i]);
+        }
+        return result;
+    }
+    const Func2 fFunc;
+    const ExprPtr fA;
+    const ExprPtr fB;
+    const bool fKeepInt;
+};
+
+struct Builtin3 : public Expr {
+    Builtin3(const Func3 func, ExprPtr&& a, ExprPtr&& b, ExprPtr&& c,
+             const bool keepInt) :
+        fFunc(func), fA(std::move(a)), fB(std::move(b)), fC(std::move(c)),
+        fKeepInt(keepInt) {}
+    Value eval(Context& ctx) const {
+        const Value a = fA->eval(ctx);
+        const Value b = fB->eval(ctx);
+        const Value c = fC->eval(ctx);
+        const bool isInt = fKeepInt && arithmeticKind(a, b) == Kind::Int &&
+                           c.fKind != Kind::Float;
+        const int size = qMax(a.fSize, qMax(b.fSize, c.fSize));
+        Value result(isInt ? Kind::Int : Kind::Float, size);
+        for(int i = 0; i < size; i++) {
+            result.fV[i] = fFunc(a.fV[a.fSize == 1 ? 0 : i],
+                                 b.fV[b.fSize == 1 ? 0 : i],
+                                 c.fV[c.fSize == 1 ? 0 : i]);
+        }
+        return result;
+    }
+    const Func3 fFunc;
+    const ExprPtr fA;
+    const ExprPtr fB;
+    const ExprPtr fC;
+    const bool fKeepInt;
+};
+
+enum class Geometric { length, distance, dot, cross, normalize };
+
+struct GeometricFunc : public Expr {
+    GeometricFunc(const Geometric func, ExprPtr&& a, ExprPtr&& b) :
+        fFunc(func), fA(std::move(a)), fB(std::move(b)) {}
+    static float sDot(const Value& a, const Value& b) {
+        float result = 0;
+        for(int i = 0; i < a.fSize; i++) result += a.fV[i]*b.fV[i];
+        return result;
+    }
+    Value eval(Context& ctx) const {
+        const Value a = fA->eval(ctx);
+        switch(fFunc) {
+        case Geometric::length:
+            return Value(Kind::Float, 1, std::sqrt(sDot(a, a)));
+        case Geometric::normalize: {
+            Value result = a;
+            result.fKind = Kind::Float;
+            const float invLen = 1.f/std::sqrt(sDot(a, a));
+            for(int i = 0; i < a.fSize; i++) result.fV[i] *= invLen;
+            return result;
+        }
+        default: break;
+        }
+        const Value b = fB->eval(ctx);
+        switch(fFunc) {
+        case Geometric::distance: {
+            const Value diff = arithmetic(Op::sub, a, b);
+            return Value(Kind::Float, 1, std::sqrt(sDot(diff, diff)));
+        }
+        case Geometric::dot:
+            return Value(Kind::Float, 1, sDot(a, b));
+        default:
+            return Value(Kind::Float, 3,
+                         a.fV[1]*b.fV[2] - b.fV[1]*a.fV[2],
+                         a.fV[2]*b.fV[0] - b.fV[2]*a.fV[0],
+                         a.fV[0]*b.fV[1] - b.fV[0]*a.fV[1]);
+        }
+    }
+    const Geometric fFunc;
+    const ExprPtr fA;
+    const ExprPtr fB;
+};
+
+inline Value readPixel(const SkPixmap& src, const int x, const int y) {
+    const auto px = static_cast<const uint8_t*>(src.addr(x, y));
+    const bool bgra = src.colorType() == kBGRA_8888_SkColorType;
+    const float inv = 1.f/255;
+    return Value(Kind::Float, 4,
+                 px[bgra ? 2 : 0]*inv, px[1]*inv,
+                 px[bgra ? 0 : 2]*inv, px[3]*inv);
+}
+
+//! @brief Bilinear sampling with clamp to edge
+struct Texture : public Expr {
+    Texture(ExprPtr&& sampler, ExprPtr&& coord) :
+        fSampler(std::move(sampler)), fCoord(std::move(coord)) {}
+    Value eval(Context& ctx) const {
+        const auto& src = *ctx.fSrc;
+        const Value coord = fCoord->eval(ctx);
+        const int w = src.width();
+        const int h = src.height();
+        const float fx = coord.fV[0]*w - 0.5f;
+        const float fy = coord.fV[1]*h - 0.5f;
+        const float flX = std::floor(fx);
+        const float flY = std::floor(fy);
+        const float tx = fx - flX;
+        const float ty = fy - flY;
+        const int x0 = qBound(0, static_cast<int>(flX), w - 1);
+        const int y0 = qBound(0, static_cast<int>(flY), h - 1);
+        const int x1 = qBound(0, static_cast<int>(flX) + 1, w - 1);
+        const int y1 = qBound(0, static_cast<int>(flY) + 1, h - 1);
+        const Value p00 = readPixel(src, x0, y0);
+        const Value p10 = readPixel(src, x1, y0);
+        const Value p01 = readPixel(src, x0, y1);
+        const Value p11 = readPixel(src, x1, y1);
+        Value result(Kind::Float, 4);
+        for(int i = 0; i < 4; i++) {
+            const float top = fMix(p00.fV[i], p10.fV[i], tx);
+            const float bottom = fMix(p01.fV[i], p11.fV[i], tx);
+            result.fV[i] = fMix(top, bottom, ty);
+        }
+        return result;
+    }
+    const ExprPtr fSampler;
+    const ExprPtr fCoord;
+};
+
+// Tokenizer
+
+enum class TokenType { identifier, number, punct, end };
+
+struct Token {
+    TokenType fType;
+    std::string fText;
+    int fLine;
+};
+
+bool isIdStart(const char c) {
+    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool isIdChar(const char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+class Tokenizer {
+public:
+    Tokenizer(const std::string& src) : mSrc(src) {}
+
+    std::vector<Token> tokenize() {
+        std::vector<Token> tokens;
+        while(true) {
+            skipSpaceAndComments();
+            if(mPos >= mSrc.size()) break;
+            const char c = mSrc[mPos];
+            if(c == '#' && mLineStart) {
+                directive(tokens);
+                continue;
+            }
+            mLineStart = false;
+            if(isIdStart(c)) {
+                const size_t start = mPos;
+                while(mPos < mSrc.size() && isIdChar(mSrc[mPos])) mPos++;
+                const std::string id = mSrc.substr(start, mPos - start);
+                const auto define = mDefines.find(id);
+                if(define == mDefines.end()) {
+                    tokens.push_back({TokenType::identifier, id, mLine});
+                } else {
+                    for(auto token : define->second) {
+                        token.fLine = mLine;
+                        tokens.push_back(token);
+                    }
+                }
+            } else if(std::isdigit(static_cast<unsigned char>(c)) ||
+                      (c == '.' && mPos + 1 < mSrc.size() &&
+                       std::isdigit(static_cast<unsigned char>(mSrc[mPos + 1])))) {
+                tokens.push_back({TokenType::number, number(), mLine});
+            } else {
+                tokens.push_back({TokenType::punct, punct(), mLine});
+            }
+        }
+        tokens.push_back({TokenType::end, "", mLine});
+        return tokens;
+    }
+private:
+    void skipSpaceAndComments() {
+        while(mPos < mSrc.size()) {
+            const char c = mSrc[mPos];
+            if(c == '\n') {
+                mLine++;
+                mLineStart = true;
+                mPos++;
+            } else if(std::isspace(static_cast<unsigned char>(c))) {
+                mPos++;
+            } else if(mSrc.compare(mPos, 2, "//") == 0) {
+                while(mPos < mSrc.size() && mSrc[mPos] != '\n') mPos++;
+            } else if(mSrc.compare(mPos, 2, "/*") == 0) {
+                const size_t end = mSrc.find("*/", mPos + 2);
+                const size_t stop = end == std::string::npos ?
+                            mSrc.size() : end + 2;
+                for(size_t i = mPos; i < stop; i++) {
+                    if(mSrc[i] == '\n') mLine++;
+                }
+                mPos = stop;
+            } else break;
+        }
+    }
+
+    void directive(std::vector<Token>& tokens) {
+        Q_UNUSED(tokens)
+        size_t end = mSrc.find('\n', mPos);
+        if(end == std::string::npos) end = mSrc.size();
+        const std::string line = mSrc.substr(mPos + 1, end - mPos - 1);
+        mPos = end;
+        Tokenizer lineTokenizer(line);
+        auto lineTokens = lineTokenizer.tokenize();
+        lineTokens.pop_back();
+        if(lineTokens.empty()) return;
+        const std::string& name = lineTokens.front().fText;
+        if(name == "version" || name == "extension" ||
+           name == "line" || name == "pragma") return;
+        if(name == "define" && lineTokens.size() >= 2) {
+            const bool funcLike = lineTokens.size() > 2 &&
+                    lineTokens[2].fText == "(" &&
+                    line.find(lineTokens[1].fText + "(") != std::string::npos;
+            if(funcLike) RuntimeThrow("Function-like macros are not supported");
+            mDefines[lineTokens[1].fText] =
+                    std::vector<Token>(lineTokens.begin() + 2, lineTokens.end());
+            return;
+        }
+        RuntimeThrow("Unsupported preprocessor directive '#" + name + "'");
+    }
+
+    std::string number() {
+        const size_t start = mPos;
+        if(mSrc.compare(mPos, 2, "0x") == 0 || mSrc.compare(mPos, 2, "0X") == 0) {
+            mPos += 2;
+            while(mPos < mSrc.size() &&
+                  std::isxdigit(static_cast<unsigned char>(mSrc[mPos]))) mPos++;
+        } else {
+            while(mPos < mSrc.size()) {
+                const char c = mSrc[mPos];
+                if(std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+                    mPos++;
+                } else if((c == 'e' || c == 'E')) {
+                    mPos++;
+                    if(mPos < mSrc.size() && (mSrc[mPos] == '-' || mSrc[mPos] == '+'))
+                        mPos++;
+                } else break;
+            }
+        }
+        if(mPos < mSrc.size() && (mSrc[mPos] == 'f' || mSrc[mPos] == 'F' ||
+                                  mSrc[mPos] == 'u' || mSrc[mPos] == 'U')) {
+            mPos++;
+        }
+        return mSrc.substr(start, mPos - start);
+    }
+
+    std::string punct() {
+        static const char* const sMulti[] = {
+            "++", "--", "+=", "-=", "*=", "/=", "%=",
+            "==", "!=", "<=", ">=", "&&", "||", "^^"
+        };
+        for(const auto op : sMulti) {
+            if(mSrc.compare(mPos, 2, op) == 0) {
+                mPos += 2;
+                return op;
+            }
+        }
+        return std::string(1, mSrc[mPos++]);
+    }
+
+    const std::string mSrc;
+    size_t mPos = 0;
+    int mLine = 1;
+    bool mLineStart = true;
+    std::map<std::string, std::vector<Token>> mDefines;
+};
+
+}
+
+// Program
+
+class ShaderCpuProgram_priv {
+public:
+    void parse(const std::string& src);
+
+    int uniformLocation(const std::string& name) const {
+        for(uint i = 0; i < mUniforms.size(); i++) {
+            if(mUniforms[i].fName == name) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    int uniformCount() const { return static_cast<int>(mUniforms.size()); }
+
+    void process(const SkPixmap& src, const SkPixmap& dst,
+                 const SkIRect& dstRect,
+                 const ShaderCpuUniforms& uniforms) const;
+private:
+    struct Variable {
+        int fSlot;
+        Type fType;
+        bool fConst;
+    };
+
+    struct Uniform {
+        std::string fName;
+        int fSlot;
+        Type fType;
+    };
+
+    [[noreturn]] void error(const std::string& msg) const {
+        RuntimeThrow("GLSL line " + std::to_string(peek().fLine) + ": " + msg);
+    }
+
+    const Token& peek(const int offset = 0) const {
+        const size_t id = qMin(mPos + offset, mTokens.size() - 1);
+        return mTokens[id];
+    }
+    bool check(const std::string& text) const {
+        const auto& token = peek();
+        return token.fType != TokenType::number && token.fText == text;
+    }
+    bool accept(const std::string& text) {
+        if(!check(text)) return false;
+        mPos++;
+        return true;
+    }
+    void expect(const std::string& text) {
+        if(!accept(text)) error("Expected '" + text + "', got '" +
+                                peek().fText + "'");
+    }
+    std::string identifier() {
+        const auto& token = peek();
+        if(token.fType != TokenType::identifier) {
+            error("Expected identifier, got '" + token.fText + "'");
+        }
+        mPos++;
+        return token.fText;
+    }
+
+    static bool sTypeFromName(const std::string& name, Type& type);
+    bool peekType() const;
+    Type parseType();
+    void skipQualifiers();
+    void skipLayout();
+
+    int addVariable(const std::string& name, const Type& type,
+                    const bool constant);
+    const Variable* findVariable(const std::string& name) const;
+
+    void parseGlobal();
+    void parseFunction(const Type& returnType, const std::string& name);
+
+    StmtPtr parseStatement();
+    StmtPtr parseDeclaration();
+    std::unique_ptr<Block> parseBlock();
+
+    ExprPtr parseExpression();
+    ExprPtr parseAssignment();
+    ExprPtr parseTernary();
+    ExprPtr parseBinary(const int level);
+    ExprPtr parseUnary();
+    ExprPtr parsePostfix(ExprPtr&& expr);
+    ExprPtr parsePrimary();
+    ExprPtr parseCall(const std::string& name);
+    std::vector<ExprPtr> parseArguments();
+    ExprPtr makeBuiltin(const std::string& name, std::vector<ExprPtr>& args);
+    ExprPtr requireLValue(ExprPtr&& expr) const;
+
+    std::vector<Token> mTokens;
+    size_t mPos = 0;
+
+    std::vector<std::map<std::string, Variable>> mScopes;
+    std::vector<Type> mSlotTypes;
+    std::map<std::string, std::unique_ptr<Function>> mFunctions;
+    std::vector<Uniform> mUniforms;
+    Block mGlobalInit;
+
+    int mTexCoordSlot = -1;
+    int mFragCoordSlot = -1;
+    int mFragColorSlot = -1;
+    int mGlFragColorSlot = -1;
+    bool mPixelCenterInteger = false;
+    bool mOriginUpperLeft = false;
+    bool mLayoutPixelCenterInteger = false;
+    bool mLayoutOriginUpperLeft = false;
+    const Function* mMain = nullptr;
+};
+
+bool ShaderCpuProgram_priv::sTypeFromName(const std::string& name, Type& type) {
+    static const std::map<std::string, Type> sTypes = {
+        {"void", {Kind::Float, 0}},
+        {"float", {Kind::Float, 1}}, {"vec2", {Kind::Float, 2}},
+        {"vec3", {Kind::Float, 3}}, {"vec4", {Kind::Float, 4}},
+        {"int", {Kind::Int, 1}}, {"ivec2", {Kind::Int, 2}},
+        {"ivec3", {Kind::Int, 3}}, {"ivec4", {Kind::Int, 4}},
+        {"uint", {Kind::Int, 1}}, {"uvec2", {Kind::Int, 2}},
+        {"uvec3", {Kind::Int, 3}}, {"uvec4", {Kind::Int, 4}},
+        {"bool", {Kind::Bool, 1}}, {"bvec2", {Kind::Bool, 2}},
+        {"bvec3", {Kind::Bool, 3}}, {"bvec4", {Kind::Bool, 4}},
+        {"sampler2D", {Kind::Sampler, 1}}
+    };
+    const auto it = sTypes.find(name);
+    if(it == sTypes.end()) return false;
+    type = it->second;
+    return true;
+}
+
+static bool isUnsupportedType(const std::string& name) {
+    return name.compare(0, 3, "mat") == 0 || name.compare(0, 4, "dmat") == 0 ||
+           name == "struct" || name == "double" ||
+           (name.compare(0, 7, "sampler") == 0 && name != "sampler2D");
+}
+
+static bool isQualifier(const std::string& name) {
+    return name == "const" || name == "highp" || name == "mediump" ||
+           name == "lowp" || name == "smooth" || name == "flat" ||
+           name == "noperspective" || name == "invariant" ||
+           name == "centroid";
+}
+
+bool ShaderCpuProgram_priv::peekType() const {
+    const auto& token = peek();
+    if(token.fType != TokenType::identifier) return false;
+    Type type;
+    return sTypeFromName(token.fText, type) || isQualifier(token.fText) ||
+           isUnsupportedType(token.fText);
+}
+
+Type ShaderCpuProgram_priv::parseType() {
+    const std::string name = identifier();
+    Type type;
+    if(!sTypeFromName(name, type)) {
+        if(isUnsupportedType(name)) error("Unsupported type '" + name + "'");
+        error("Unknown type '" + name + "'");
+    }
+    return type;
+}
+
+void ShaderCpuProgram_priv::skipQualifiers() {
+    while(peek().fType == TokenType::identifier &&
+          isQualifier(peek().fText) && peek().fText != "const") mPos++;
+}
+
+void ShaderCpuProgram_priv::skipLayout() {
+    expect("(");
+    while(!accept(")")) {
+        const auto& token = peek();
+        if(token.fType == TokenType::end) error("Unterminated layout");
+        if(token.fText == "pixel_center_integer")
+            mLayoutPixelCenterInteger = true;
+        else if(token.fText == "origin_upper_left")
+            mLayoutOriginUpperLeft = true;
+        mPos++;
+    }
+}
+
+int ShaderCpuProgram_priv::addVariable(const std::string& name,
+                                       const Type& type,
+                                       const bool constant) {
+    const int slot = static_cast<int>(mSlotTypes.size());
+    mSlotTypes.push_back(type);
+    mScopes.back()[name] = {slot, type, constant};
+    return slot;
+}
+
+const ShaderCpuProgram_priv::Variable*
+ShaderCpuProgram_priv::findVariable(const std::string& name) const {
+    for(auto it = mScopes.rbegin(); it != mScopes.rend(); it++) {
+        const auto var = it->find(name);
+        if(var != it->end()) return &var->second;
+    }
+    return nullptr;
+}
+
+void ShaderCpuProgram_priv::parse(const std::string& src) {
+    Tokenizer tokenizer(src);
+    mTokens = tokenizer.tokenize();
+    mScopes.emplace_back();
+    mFragCoordSlot = addVariable("gl_FragCoord", {Kind::Float, 4}, true);
+    mGlFragColorSlot = addVariable("gl_FragColor", {Kind::Float, 4}, false);
+    while(peek().fType != TokenType::end) parseGlobal();
+    if(!mMain || !mMain->fBody) error("No main function");
+    if(mFragColorSlot < 0) mFragColorSlot = mGlFragColorSlot;
+}
+
+void ShaderCpuProgram_priv::parseGlobal() {
+    if(accept(";")) return;
+    if(accept("precision")) {
+        while(!accept(";")) {
+            if(peek().fType == TokenType::end) error("Unexpected end");
+            mPos++;
+        }
+        return;
+    }
+    mLayoutPixelCenterInteger = false;
+    mLayoutOriginUpperLeft = false;
+    bool constant = false;
+    bool uniform = false;
+    bool input = false;
+    bool output = false;
+    while(true) {
+        if(accept("layout")) skipLayout();
+        else if(accept("const")) constant = true;
+        else if(accept("uniform")) uniform = true;
+        else if(accept("in") || accept("varying")) input = true;
+        else if(accept("out")) output = true;
+        else if(check("attribute") || check("buffer") || check("inout"))
+            error("Unsupported qualifier '" + peek().fText + "'");
+        else if(peek().fType == TokenType::identifier &&
+                isQualifier(peek().fText)) mPos++;
+        else break;
+    }
+    const Type type = parseType();
+    const std::string name = identifier();
+    if(check("(")) {
+        if(uniform || input || output || constant) error("Invalid function");
+        return parseFunction(type, name);
+    }
+    if(input) {
+        if(name == "gl_FragCoord") {
+            mPixelCenterInteger = mLayoutPixelCenterInteger;
+            mOriginUpperLeft = mLayoutOriginUpperLeft;
+        } else if(name == "texCoord" && type.fKind == Kind::Float &&
+                  type.fSize == 2) {
+            mTexCoordSlot = addVariable(name, type, true);
+        } else error("Unsupported input '" + name + "'");
+        expect(";");
+        return;
+    }
+    if(output) {
+        if(type.fKind != Kind::Float || type.fSize != 4 || mFragColorSlot >= 0)
+            error("Unsupported output '" + name + "'");
+        mFragColorSlot = addVariable(name, type, false);
+        expect(";");
+        return;
+    }
+    std::string varName = name;
+    while(true) {
+        if(check("[")) error("Arrays are not supported");
+        if(uniform) {
+            const int slot = addVariable(varName, type, true);
+            mUniforms.push_back({varName, slot, type});
+        } else {
+            ExprPtr init;
+            if(accept("=")) init = parseAssignment();
+            else if(constant) error("Missing const initializer");
+            const int slot = addVariable(varName, type, constant);
+            mGlobalInit.fStmts.emplace_back(
+                        new DeclStmt(slot, type, std::move(init)));
+        }
+        if(!accept(",")) break;
+        varName = identifier();
+    }
+    expect(";");
+}
+
+void ShaderCpuProgram_priv::parseFunction(const Type& returnType,
+                                          const std::string& name) {
+    expect("(");
+    auto& func = mFunctions[name];
+    const bool declared = func.get();
+    if(!declared) {
+        func.reset(new Function);
+        func->fName = name;
+        func->fReturnType = returnType;
+    }
+    mScopes.emplace_back();
+    std::vector<Param> params;
+    if(!(check("void") && peek(1).fText == ")")) {
+        while(!check(")")) {
+            ParamQualifier qualifier = ParamQualifier::in;
+            while(true) {
+                if(accept("in")) qualifier = ParamQualifier::in;
+                else if(accept("out")) qualifier = ParamQualifier::out;
+                else if(accept("inout")) qualifier = ParamQualifier::inout;
+                else if(peek().fType == TokenType::identifier &&
+                        isQualifier(peek().fText)) mPos++;
+                else break;
+            }
+            const Type type = parseType();
+            std::string paramName;
+            if(peek().fType == TokenType::identifier) paramName = identifier();
+            if(check("[")) error("Arrays are not supported");
+            const int slot = addVariable(paramName, type, false);
+            params.push_back({slot, type, qualifier});
+            if(!accept(",")) break;
+        }
+    } else mPos++;
+    expect(")");
+    if(params.size() > sMaxParams) error("Too many parameters");
+    if(declared && func->fParams.size() != params.size())
+        error("Overloaded functions are not supported");
+    if(accept(";")) {
+        if(!declared) func->fParams = params;
+        mScopes.pop_back();
+        return;
+    }
+    if(func->fBody) error("Redefinition of '" + name + "'");
+    func->fParams = params;
+    func->fBody = parseBlock();
+    mScopes.pop_back();
+    if(name == "main") mMain = func.get();
+}
+
+std::unique_ptr<Block> ShaderCpuProgram_priv::parseBlock() {
+    expect("{");
+    mScopes.emplace_back();
+    std::unique_ptr<Block> block(new Block);
+    while(!accept("}")) {
+        if(peek().fType == TokenType::end) error("Unexpected end");
+        block->fStmts.push_back(parseStatement());
+    }
+    mScopes.pop_back();
+    return block;
+}
+
+StmtPtr ShaderCpuProgram_priv::parseDeclaration() {
+    bool constant = false;
+    while(true) {
+        if(accept("const")) constant = true;
+        else if(peek().fType == TokenType::identifier &&
+                isQualifier(peek().fText)) mPos++;
+        else break;
+    }
+    const Type type = parseType();
+    std::unique_ptr<Block> decls(new Block);
+    do {
+        const std::string name = identifier();
+        if(check("[")) error("Arrays are not supported");
+        ExprPtr init;
+        if(accept("=")) init = parseAssignment();
+        const int slot = addVariable(name, type, constant);
+        decls->fStmts.emplace_back(new DeclStmt(slot, type, std::move(init)));
+    } while(accept(","));
+    expect(";");
+    if(decls->fStmts.size() == 1) return std::move(decls->fStmts.front());
+    return StmtPtr(std::move(decls));
+}
+
+StmtPtr ShaderCpuProgram_priv::parseStatement() {
+    if(check("{")) return parseBlock();
+    if(accept(";")) return StmtPtr(new Block);
+    if(accept("if")) {
+        expect("(");
+        auto cond = parseExpression();
+        expect(")");
+        mScopes.emplace_back();
+        auto a = parseStatement();
+        mScopes.pop_back();
+        StmtPtr b;
+        if(accept("else")) {
+            mScopes.emplace_back();
+            b = parseStatement();
+            mScopes.pop_back();
+        }
+        return StmtPtr(new If(std::move(cond), std::move(a), std::move(b)));
+    }
+    if(accept("for")) {
+        expect("(");
+        mScopes.emplace_back();
+        StmtPtr init;
+        if(!accept(";")) {
+            if(peekType()) init = parseDeclaration();
+            else {
+                init.reset(new ExprStmt(parseExpression()));
+                expect(";");
+            }
+        }
+        ExprPtr cond;
+        if(!check(";")) cond = parseExpression();
+        expect(";");
+        ExprPtr step;
+        if(!check(")")) step = parseExpression();
+        expect(")");
+        auto body = parseStatement();
+        mScopes.pop_back();
+        return StmtPtr(new Loop(std::move(init), std::move(cond),
+                                std::move(step), std::move(body), true));
+    }
+    if(accept("while")) {
+        expect("(");
+        auto cond = parseExpression();
+        expect(")");
+        mScopes.emplace_back();
+        auto body = parseStatement();
+        mScopes.pop_back();
+        return StmtPtr(new Loop(nullptr, std::move(cond), nullptr,
+                                std::move(body), true));
+    }
+    if(accept("do")) {
+        mScopes.emplace_back();
+        auto body = parseStatement();
+        mScopes.pop_back();
+        expect("while");
+        expect("(");
+        auto cond = parseExpression();
+        expect(")");
+        expect(";");
+        return StmtPtr(new Loop(nullptr, std::move(cond), nullptr,
+                                std::move(body), false));
+    }
+    if(accept("return")) {
+        ExprPtr expr;
+        if(!check(";")) expr = parseExpression();
+        expect(";");
+        return StmtPtr(new Return(std::move(expr)));
+    }
+    if(accept("break")) {
+        expect(";");
+        return StmtPtr(new Jump(Flow::brk));
+    }
+    if(accept("continue")) {
+        expect(";");
+        return StmtPtr(new Jump(Flow::cont));
+    }
+    if(accept("discard")) {
+        expect(";");
+        return StmtPtr(new Discard);
+    }
+    if(check("switch")) error("'switch' is not supported");
+    if(peekType() && peek(1).fText != "(") return parseDeclaration();
+    auto expr = parseExpression();
+    expect(";");
+    return StmtPtr(new ExprStmt(std::move(expr)));
+}
+
+ExprPtr ShaderCpuProgram_priv::parseExpression() {
+    auto expr = parseAssignment();
+    if(check(",")) error("Comma operator is not supported");
+    return expr;
+}
+
+ExprPtr ShaderCpuProgram_priv::requireLValue(ExprPtr&& expr) const {
+    if(!expr->isLValue()) error("Assignment to a non l-value");
+    return std::move(expr);
+}
+
+ExprPtr ShaderCpuProgram_priv::parseAssignment() {
+    auto expr = parseTernary();
+    static const std::map<std::string, Op> sCompound = {
+        {"+=", Op::add}, {"-=", Op::sub}, {"*=", Op::mul},
+        {"/=", Op::div}, {"%=", Op::mod}
+    };
+    if(accept("=")) {
+        auto target = requireLValue(std::move(expr));
+        auto value = parseAssignment();
+        return ExprPtr(new Assign(std::move(target), std::move(value),
+                                  false, Op::add));
+    }
+    const auto compound = sCompound.find(peek().fText);
+    if(peek().fType == TokenType::punct && compound != sCompound.end()) {
+        mPos++;
+        auto target = requireLValue(std::move(expr));
+        auto value = parseAssignment();
+        return ExprPtr(new Assign(std::move(target), std::move(value),
+                                  true, compound->second));
+    }
+    return expr;
+}
+
+ExprPtr ShaderCpuProgram_priv::parseTernary() {
+    auto cond = parseBinary(0);
+    if(!accept("?")) return cond;
+    auto a = parseAssignment();
+    expect(":");
+    auto b = parseAssignment();
+    return ExprPtr(new Ternary(std::move(cond), std::move(a), std::move(b)));
+}
+
+ExprPtr ShaderCpuProgram_priv::parseBinary(const int level) {
+    struct Level { std::vector<std::pair<std::string, Op>> fOps; };
+    static const std::vector<Level> sLevels = {
+        {{{"||", Op::lor}}},
+        {{{"^^", Op::lxor}}},
+        {{{"&&", Op::land}}},
+        {{{"==", Op::eq}, {"!=", Op::ne}}},
+        {{{"<", Op::lt}, {">", Op::gt}, {"<=", Op::le}, {">=", Op::ge}}},
+        {{{"+", Op::add}, {"-", Op::sub}}},
+        {{{"*", Op::mul}, {"/", Op::div}, {"%", Op::mod}}}
+    };
+    if(level >= static_cast<int>(sLevels.size())) return parseUnary();
+    auto left = parseBinary(level + 1);
+    while(true) {
+        const auto& token = peek();
+        if(token.fType != TokenType::punct) break;
+        bool found = false;
+        for(const auto& op : sLevels[level].fOps) {
+            if(token.fText != op.first) continue;
+            mPos++;
+            auto right = parseBinary(level + 1);
+            left.reset(new Binary(op.second, std::move(left), std::move(right)));
+            found = true;
+            break;
+        }
+        if(!found) break;
+    }
+    return left;
+}
+
+ExprPtr ShaderCpuProgram_priv::parseUnary() {
+    if(accept("-")) return ExprPtr(new Negate(parseUnary()));
+    if(accept("+")) return parseUnary();
+    if(accept("!")) return ExprPtr(new Not(parseUnary()));
+    if(check("~")) error("Bitwise operators are not supported");
+    if(accept("++")) {
+        return ExprPtr(new IncDec(requireLValue(parseUnary()), 1, true));
+    }
+    if(accept("--")) {
+        return ExprPtr(new IncDec(requireLValue(parseUnary()), -1, true));
+    }
+    return parsePostfix(parsePrimary());
+}
+
+static bool swizzleIds(const std::string& text, std::vector<int>& ids) {
+    static const char* const sSets[] = { "xyzw", "rgba", "stpq" };
+    if(text.empty() || text.size() > 4) return false;
+    for(const auto set : sSets) {
+        ids.clear();
+        for(const char c : text) {
+            const char* const pos = std::strchr(set, c);
+            if(!pos) break;
+            ids.push_back(static_cast<int>(pos - set));
+        }
+        if(ids.size() == text.size()) return true;
+    }
+    return false;
+}
+
+ExprPtr ShaderCpuProgram_priv::parsePostfix(ExprPtr&& expr) {
+    ExprPtr result = std::move(expr);
+    while(true) {
+        if(accept(".")) {
+            const std::string field = identifier();
+            std::vector<int> ids;
+            if(!swizzleIds(field, ids)) error("Invalid swizzle '" + field + "'");
+            result.reset(new Swizzle(std::move(result), ids));
+        } else if(accept("[")) {
+            auto index = parseExpression();
+            expect("]");
+            result.reset(new Index(std::move(result), std::move(index)));
+        } else if(accept("++")) {
+            result.reset(new IncDec(requireLValue(std::move(result)), 1, false));
+        } else if(accept("--")) {
+            result.reset(new IncDec(requireLValue(std::move(result)), -1, false));
+        } else break;
+    }
+    return result;
+}
+
+ExprPtr ShaderCpuProgram_priv::parsePrimary() {
+    const Token token = peek();
+    if(token.fType == TokenType::number) {
+        mPos++;
+        std::string text = token.fText;
+        const bool isHex = text.size() > 1 && (text[1] == 'x' || text[1] == 'X');
+        const char last = text.back();
+        const bool floatSuffix = !isHex && (last == 'f' || last == 'F');
+        if(floatSuffix || last == 'u' || last == 'U') text.pop_back();
+        const bool isFloat = floatSuffix || (!isHex &&
+                text.find_first_of(".eE") != std::string::npos);
+        if(isFloat) {
+            return ExprPtr(new Literal(Value(Kind::Float, 1,
+                                             std::stof(text))));
+        }
+        const float value = static_cast<float>(std::stoll(text, nullptr, 0));
+        return ExprPtr(new Literal(Value(Kind::Int, 1, value)));
+    }
+    if(accept("(")) {
+        auto expr = parseExpression();
+        expect(")");
+        return expr;
+    }
+    const std::string name = identifier();
+    if(name == "true") return ExprPtr(new Literal(boolValue(true)));
+    if(name == "false") return ExprPtr(new Literal(boolValue(false)));
+    if(check("(")) return parseCall(name);
+    const auto var = findVariable(name);
+    if(!var) error("Undeclared identifier '" + name + "'");
+    return ExprPtr(new VarRef(var->fSlot, var->fType, var->fConst));
+}
+
+std::vector<ExprPtr> ShaderCpuProgram_priv::parseArguments() {
+    expect("(");
+    std::vector<ExprPtr> args;
+    if(check("void") && peek(1).fText == ")") mPos++;
+    while(!check(")")) {
+        args.push_back(parseAssignment());
+        if(!accept(",")) break;
+    }
+    expect(")");
+    return args;
+}
+
+ExprPtr ShaderCpuProgram_priv::parseCall(const std::string& name) {
+    auto args = parseArguments();
+    Type type;
+    if(sTypeFromName(name, type) && type.fSize > 0 &&
+       type.fKind != Kind::Sampler) {
+        if(args.empty()) error("Empty constructor");
+        return ExprPtr(new Constructor(type, std::move(args)));
+    }
+    if(isUnsupportedType(name)) error("Unsupported type '" + name + "'");
+    const auto func = mFunctions.find(name);
+    if(func != mFunctions.end()) {
+        const auto& params = func->second->fParams;
+        if(params.size() != args.size())
+            error("Wrong number of arguments for '" + name + "'");
+        for(uint i = 0; i < params.size(); i++) {
+            if(params[i].fQualifier == ParamQualifier::in) continue;
+            if(!args[i]->isLValue()) error("Expected l-value argument");
+        }
+        return ExprPtr(new Call(func->second.get(), std::move(args)));
+    }
+    return makeBuiltin(name, args);
+}
+
+ExprPtr ShaderCpuProgram_priv::makeBuiltin(const std::string& name,
+                                           std::vector<ExprPtr>& args) {
+    static const std::map<std::string, std::pair<Func1, bool>> sFuncs1 = {
+        {"abs", {cAbs, true}}, {"sign", {fSign, true}},
+        {"floor", {cFloor, false}}, {"ceil", {cCeil, false}},
+        {"trunc", {cTrunc, false}}, {"round", {fRound, false}},
+        {"fract", {fFract, false}}, {"sqrt", {cSqrt, false}},
+        {"inversesqrt", {fInvSqrt, false}},
+        {"exp", {cExp, false}}, {"exp2", {cExp2, false}},
+        {"log", {cLog, false}}, {"log2", {cLog2, false}},
+        {"sin", {cSin, false}}, {"cos", {cCos, false}},
+        {"tan", {cTan, false}}, {"asin", {cAsin, false}},
+        {"acos", {cAcos, false}}, {"atan", {cAtan, false}},
+        {"radians", {fRadians, false}}, {"degrees", {fDegrees, false}}
+    };
+    static const std::map<std::string, std::pair<Func2, bool>> sFuncs2 = {
+        {"mod", {fMod, false}}, {"min", {fMin, true}},
+        {"max", {fMax, true}}, {"step", {fStep, false}},
+        {"pow", {cPow, false}}, {"atan", {cAtan2, false}}
+    };
+    static const std::map<std::string, std::pair<Func3, bool>> sFuncs3 = {
+        {"clamp", {fClamp, true}}, {"mix", {fMix, false}},
+        {"smoothstep", {fSmoothstep, false}}
+    };
+    static const std::map<std::string, std::pair<Geometric, int>> sGeometric = {
+        {"length", {Geometric::length, 1}},
+        {"normalize", {Geometric::normalize, 1}},
+        {"distance", {Geometric::distance, 2}},
+        {"dot", {Geometric::dot, 2}},
+        {"cross", {Geometric::cross, 2}}
+    };
+    const size_t n = args.size();
+    if(name == "texture2D" || name == "texture") {
+        if(n != 2) error("Unsupported '" + name + "' overload");
+        return ExprPtr(new Texture(std::move(args[0]), std::move(args[1])));
+    }
+    if(n == 1) {
+        const auto it = sFuncs1.find(name);
+        if(it != sFuncs1.end()) {
+            return ExprPtr(new Builtin1(it->second.first, std::move(args[0]),
+                                        it->second.second));
+        }
+    } else if(n == 2) {
+        const auto it = sFuncs2.find(name);
+        if(it != sFuncs2.end()) {
+            return ExprPtr(new Builtin2(it->second.first, std::move(args[0]),
+                                        std::move(args[1]), it->second.second));
+        }
+    } else if(n == 3) {
+        const auto it = sFuncs3.find(name);
+        if(it != sFuncs3.end()) {
+            return ExprPtr(new Builtin3(it->second.first, std::move(args[0]),
+                                        std::move(args[1]), std::move(args[2]),
+                                        it->second.second));
+        }
+    }
+    const auto geo = sGeometric.find(name);
+    if(geo != sGeometric.end() && static_cast<int>(n) == geo->second.second) {
+        ExprPtr b = n == 2 ? std::move(args[1]) : nullptr;
+        return ExprPtr(new GeometricFunc(geo->second.first,
+                                         std::move(args[0]), std::move(b)));
+    }
+    error("Unsupported function '" + name + "'");
+}
+
+void ShaderCpuProgram_priv::process(const SkPixmap& src, const SkPixmap& dst,
+                                    const SkIRect& dstRect,
+                                    const ShaderCpuUniforms& uniforms) const {
+    Context ctx;
+    ctx.fSrc = &src;
+    ctx.fSlots.resize(mSlotTypes.size());
+    for(uint i = 0; i < mSlotTypes.size(); i++) {
+        const auto& type = mSlotTypes[i];
+        ctx.fSlots[i] = Value(type.fKind, type.fSize);
+    }
+    for(uint i = 0; i < mUniforms.size(); i++) {
+        const auto& uni = mUniforms[i];
+        if(static_cast<int>(i) >= uniforms.count()) break;
+        ctx.fSlots[uni.fSlot] = convert(uniforms.at(static_cast<int>(i)),
+                                        uni.fType);
+    }
+    const float invWidth = 1.f/src.width();
+    const float invHeight = 1.f/src.height();
+    const float center = mPixelCenterInteger ? 0.f : 0.5f;
+    const bool bgra = dst.colorType() == kBGRA_8888_SkColorType;
+    for(int y = dstRect.top(); y < dstRect.bottom(); y++) {
+        const auto dstLine = static_cast<uint8_t*>(
+                    dst.writable_addr(0, y - dstRect.top()));
+        const float fragY = mOriginUpperLeft ?
+                    src.height() - 1 - y + center : y + center;
+        for(int x = dstRect.left(); x < dstRect.right(); x++) {
+            auto& fragCoord = ctx.fSlots[mFragCoordSlot];
+            fragCoord = Value(Kind::Float, 4, x + center, fragY, 0.5f, 1.f);
+            if(mTexCoordSlot >= 0) {
+                ctx.fSlots[mTexCoordSlot] = Value(Kind::Float, 2,
+                                                  (x + 0.5f)*invWidth,
+                                                  (y + 0.5f)*invHeight);
+            }
+            ctx.fSlots[mFragColorSlot] = Value(Kind::Float, 4);
+            ctx.fDiscarded = false;
+            mGlobalInit.exec(ctx);
+            mMain->fBody->exec(ctx);
+            const auto px = dstLine + 4*(x - dstRect.left());
+            if(ctx.fDiscarded) {
+                px[0] = px[1] = px[2] = px[3] = 0;
+                continue;
+            }
+            const Value& color = ctx.fSlots[mFragColorSlot];
+            uint8_t rgba[4];
+            for(int i = 0; i < 4; i++) {
+                const float v = fClamp(color.fV[i], 0.f, 1.f);
+                rgba[i] = static_cast<uint8_t>(v*255 + 0.5f);
+            }
+            px[0] = rgba[bgra ? 2 : 0];
+            px[1] = rgba[1];
+            px[2] = rgba[bgra ? 0 : 2];
+            px[3] = rgba[3];
+        }
+    }
+}
+
+ShaderCpuProgram::ShaderCpuProgram(
+        std::unique_ptr<ShaderCpuProgram_priv>&& priv) :
+    mPriv(std::move(priv)) {}
+
+ShaderCpuProgram::~ShaderCpuProgram() {}
+
+std::shared_ptr<ShaderCpuProgram> ShaderCpuProgram::sCreate(
+        const QString& fragPath) {
+    QFile file(fragPath);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        RuntimeThrow("Failed to open '" + fragPath + "'");
+    const std::string src = file.readAll().toStdString();
+    std::unique_ptr<ShaderCpuProgram_priv> priv(new ShaderCpuProgram_priv);
+    priv->parse(src);
+    return std::make_shared<ShaderCpuProgram>(std::move(priv));
+}
+
+int ShaderCpuProgram::uniformLocation(const QString& name) const {
+    return mPriv->uniformLocation(name.toStdString());
+}
+
+int ShaderCpuProgram::uniformCount() const {
+    return mPriv->uniformCount();
+}
+
+void ShaderCpuProgram::process(const SkPixmap& src, const SkPixmap& dst,
+                               const SkIRect& dstRect,
+                               const ShaderCpuUniforms& uniforms) const {
+    mPriv->process(src, dst, dstRect, uniforms);
+}
@@ -0,0 +1,80 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef SHADERCPUPROGRAM_H
+#define SHADERCPUPROGRAM_H
+
+#include "core_global.h"
+#include "skia/skiaincludes.h"
+
+#include <memory>
+#include <functional>
+#include <QVector>
+#include <QList>
+
+struct CORE_EXPORT ShaderCpuValue {
+    enum class Kind : short { Float, Int, Bool, Sampler };
+
+    ShaderCpuValue() {}
+    ShaderCpuValue(const Kind kind, const int size,
+                   const float v0 = 0, const float v1 = 0,
+                   const float v2 = 0, const float v3 = 0) :
+        fKind(kind), fSize(static_cast<short>(size)) {
+        fV[0] = v0; fV[1] = v1; fV[2] = v2; fV[3] = v3;
+    }
+
+    bool isTrue() const { return fV[0] != 0.f; }
+
+    float fV[4] = {0.f, 0.f, 0.f, 0.f};
+    Kind fKind = Kind::Float;
+    short fSize = 1;
+};
+
+//! @brief Uniform values, indexed by ShaderCpuProgram::uniformLocation
+typedef QVector<ShaderCpuValue> ShaderCpuUniforms;
+typedef std::function<void(ShaderCpuUniforms&)> CpuUniformSpecifier;
+typedef QList<CpuUniformSpecifier> CpuUniformSpecifiers;
+
+class ShaderCpuProgram_priv;
+
+//! @brief Cpu backend for GLSL fragment shaders used by ShaderEffect.
+//! The fragment shader source is parsed once into a tree of
+//! precompiled nodes, which is then interpreted for every pixel.
+//! Supports the scalar/vector subset of GLSL 330 used by enve effects:
+//! functions, control flow, swizzles, texture2D and common built-ins.
+class CORE_EXPORT ShaderCpuProgram {
+public:
+    ShaderCpuProgram(std::unique_ptr<ShaderCpuProgram_priv>&& priv);
+    ~ShaderCpuProgram();
+
+    //! @brief Throws if the shader uses unsupported GLSL features
+    static std::shared_ptr<ShaderCpuProgram> sCreate(const QString& fragPath);
+
+    //! @brief Returns -1 if there is no such uniform
+    int uniformLocation(const QString& name) const;
+    int uniformCount() const;
+
+    //! @brief Renders dstRect (in src coordinates) into dst,
+    //! texture2D samples src, both are premultiplied 8888 pixmaps
+    void process(const SkPixmap& src, const SkPixmap& dst,
+                 const SkIRect& dstRect,
+                 const ShaderCpuUniforms& uniforms) const;
+private:
+    const std::unique_ptr<ShaderCpuProgram_priv> mPriv;
+};
+
+#endif // SHADERCPUPROGRAM_H
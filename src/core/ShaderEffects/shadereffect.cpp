@@ -22,8 +22,10 @@ ShaderEffect::ShaderEffect(const QString& name,
                            const ShaderEffectCreator * const creator,
                            const ShaderEffectProgram * const program,
                            const QList<stdsptr<ShaderPropertyCreator>> &props) :
-    RasterEffect(name, HardwareSupport::gpuOnly, false,
-                 RasterEffectType::CUSTOM_SHADER),
+    RasterEffect(name, !program->fCpuProgram ? HardwareSupport::gpuOnly :
+                       (program->fId ? HardwareSupport::gpuPreffered :
+                                       HardwareSupport::cpuOnly),
+                 false, RasterEffectType::CUSTOM_SHADER),
     mProgram(program), mCreator(creator) {
     for(const auto& propC : props)
         ca_addChild(propC->create());
@@ -46,26 +48,40 @@ stdsptr<RasterEffectCaller> ShaderEffect::getEffectCaller(
     std::unique_ptr<ShaderEffectJS> engineUPtr;
     takeJSEngine(engineUPtr);
     ShaderEffectJS& engine = *engineUPtr;
+    const bool cpu = mProgram->fCpuProgram.get();
+    const bool gpu = mProgram->fId != 0;
+    HardwareSupport hwSupport;
+    if(!cpu) hwSupport = HardwareSupport::gpuOnly;
+    else if(!gpu) hwSupport = HardwareSupport::cpuOnly;
+    else hwSupport = instanceHwSupport();
     const auto effect = enve::make_shared<ShaderEffectCaller>(
-                            std::move(engineUPtr), *mProgram);
+                            hwSupport, std::move(engineUPtr), *mProgram);
 
     QJSValueList setterArgs;
     UniformSpecifiers& uniSpecs = effect->mUniformSpecifiers;
-    const int argsCount = mProgram->fPropUniLocs.count();
+    CpuUniformSpecifiers& cpuUniSpecs = effect->mCpuUniformSpecifiers;
+    const int argsCount = mProgram->fPropUniCreators.count();
     for(int i = 0; i < argsCount; i++) {
-        const GLint loc = mProgram->fPropUniLocs.at(i);
+        const GLint loc = gpu ? mProgram->fPropUniLocs.at(i) : -1;
+        const int cpuLoc = cpu ? mProgram->fPropCpuLocs.at(i) : -1;
         const auto prop = ca_getChildAt(i);
         const auto& uniformC = mProgram->fPropUniCreators.at(i);
-        uniformC->create(engine, loc, prop, relFrame,
+        uniformC->create(engine, loc, cpuLoc, prop, relFrame,
                          resolution, influence,
-                         setterArgs, uniSpecs);
+                         setterArgs, uniSpecs, cpuUniSpecs);
     }
     engine.setValues(setterArgs);
     const int valsCount = mProgram->fValueHandlers.count();
     for(int i = 0; i < valsCount; i++) {
-        const GLint loc = mProgram->fValueLocs.at(i);
         const auto& value = mProgram->fValueHandlers.at(i);
-        uniSpecs << value->create(loc, &engine.getGlValueGetter(i));
+        QJSValue * const getter = &engine.getGlValueGetter(i);
+        if(gpu) {
+            const GLint loc = mProgram->fValueLocs.at(i);
+            uniSpecs << value->create(loc, getter);
+        }
+        if(!cpu) continue;
+        const int cpuLoc = mProgram->fValueCpuLocs.at(i);
+        cpuUniSpecs << value->createCpu(cpuLoc, getter);
     }
     return effect;
 }
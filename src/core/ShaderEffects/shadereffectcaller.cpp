@@ -18,10 +18,12 @@
 
 #include "shadereffectprogram.h"
 
-ShaderEffectCaller::ShaderEffectCaller(std::unique_ptr<ShaderEffectJS>&& engine,
+ShaderEffectCaller::ShaderEffectCaller(const HardwareSupport hwSupport,
+                                       std::unique_ptr<ShaderEffectJS>&& engine,
                                        const ShaderEffectProgram &program) :
-    RasterEffectCaller(HardwareSupport::gpuOnly, false, QMargins()),
-    mEngine(std::move(engine)), mProgramId(program.fId), mProgram(program) {
+    RasterEffectCaller(hwSupport, false, QMargins()),
+    mEngine(std::move(engine)), mProgramId(program.fId), mProgram(program),
+    mCpuProgram(program.fCpuProgram) {
     Q_ASSERT(mEngine.get());
 }
 
@@ -48,9 +50,34 @@ void ShaderEffectCaller::processGpu(QGL33 * const gl,
     renderTools.swapTextures();
 }
 
+void ShaderEffectCaller::processCpu(CpuRenderTools &renderTools,
+                                    const CpuRenderData &data) {
+    if(!mCpuProgram) RuntimeThrow("No cpu program for shader effect");
+    SkPixmap src;
+    SkPixmap dst;
+    renderTools.fSrcBtmp.peekPixels(&src);
+    renderTools.fDstBtmp.peekPixels(&dst);
+    mCpuProgram->process(src, dst, data.fTexTile, mCpuUniforms);
+}
+
 QMargins ShaderEffectCaller::getMargin(const SkIRect &srcRect) {
+    if(!mEvaluated || mEvaluatedRect != srcRect) evaluate(srcRect);
+    return mMargin;
+}
+
+void ShaderEffectCaller::evaluate(const SkIRect &srcRect) {
     mEngine->setSceneRect(srcRect);
     mEngine->evaluate();
+    mMargin = evaluateMargin();
+    if(mCpuProgram) {
+        mCpuUniforms.resize(mCpuProgram->uniformCount());
+        for(const auto& uni : mCpuUniformSpecifiers) uni(mCpuUniforms);
+    }
+    mEvaluatedRect = srcRect;
+    mEvaluated = true;
+}
+
+QMargins ShaderEffectCaller::evaluateMargin() {
     const auto jsVal = mEngine->getMarginValue();
     if(jsVal.isNumber()) {
         return QMargins() + qCeil(jsVal.toNumber());
@@ -24,25 +24,39 @@
 class CORE_EXPORT ShaderEffectCaller : public RasterEffectCaller {
     e_OBJECT
 public:
-    ShaderEffectCaller(std::unique_ptr<ShaderEffectJS>&& engine,
+    ShaderEffectCaller(const HardwareSupport hwSupport,
+                       std::unique_ptr<ShaderEffectJS>&& engine,
                        const ShaderEffectProgram& program);
     ~ShaderEffectCaller();
 
     void processGpu(QGL33 * const gl,
                     GpuRenderTools& renderTools);
+    void processCpu(CpuRenderTools& renderTools,
+                    const CpuRenderData& data);
 
     ShaderEffectJS& getJSEngine()
     { return *mEngine; }
 
     UniformSpecifiers mUniformSpecifiers;
+    CpuUniformSpecifiers mCpuUniformSpecifiers;
 protected:
     QMargins getMargin(const SkIRect &srcRect);
 private:
+    //! @brief Runs the scripts and stores the cpu uniforms as plain values
+    void evaluate(const SkIRect &srcRect);
+    QMargins evaluateMargin();
     void setupProgram(QGL33 * const gl);
 
     std::unique_ptr<ShaderEffectJS> mEngine;
     const GLuint mProgramId;
     const ShaderEffectProgram &mProgram;
+    const std::shared_ptr<ShaderCpuProgram> mCpuProgram;
+    //! @brief The engine belongs to the gui thread, scripts are evaluated
+    //! there by BoxRenderData::beforeProcessing, processCpu only reads
+    bool mEvaluated = false;
+    SkIRect mEvaluatedRect;
+    QMargins mMargin;
+    ShaderCpuUniforms mCpuUniforms;
 };
 
 
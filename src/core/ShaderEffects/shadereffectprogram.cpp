@@ -26,6 +26,28 @@ void ShaderEffectProgram::reloadFragmentShader(
     if(!QFile(fragPath).exists())
         RuntimeThrow("Failed to open '" + fragPath + "'");
 
+    // both programs are swapped together, so that a failed reload
+    // does not leave the cpu and gpu versions out of sync
+    std::shared_ptr<ShaderCpuProgram> cpuProgram;
+    QList<int> propCpuLocs;
+    QList<int> valueCpuLocs;
+    try {
+        createCpuProgram(fragPath, cpuProgram, propCpuLocs, valueCpuLocs);
+    } catch(...) {
+        // shaders outside of the supported GLSL subset stay gpu only
+        if(!gl) RuntimeThrow("No OpenGL context and no cpu program for '" +
+                             fragPath + "'");
+        cpuProgram.reset();
+        propCpuLocs.clear();
+        valueCpuLocs.clear();
+    }
+    if(!gl) {
+        fCpuProgram = cpuProgram;
+        fPropCpuLocs = propCpuLocs;
+        fValueCpuLocs = valueCpuLocs;
+        return;
+    }
+
     try {
         gIniProgram(gl, newProgram, GL_TEXTURED_VERT, fragPath);
     } catch(...) {
@@ -68,6 +90,32 @@ void ShaderEffectProgram::reloadFragmentShader(
     fPropUniLocs = propUniLocs;
     fValueLocs = valueLocs;
     fTexLocation = texLocation;
+
+    fCpuProgram = cpuProgram;
+    fPropCpuLocs = propCpuLocs;
+    fValueCpuLocs = valueCpuLocs;
+}
+
+void ShaderEffectProgram::createCpuProgram(
+        const QString &fragPath,
+        std::shared_ptr<ShaderCpuProgram>& cpuProgram,
+        QList<int>& propCpuLocs, QList<int>& valueCpuLocs) const {
+    cpuProgram = ShaderCpuProgram::sCreate(fragPath);
+
+    for(const auto& propC : fProperties) {
+        if(propC->fGLValue) {
+            const int loc = cpuProgram->uniformLocation(propC->fName);
+            if(loc < 0) RuntimeThrow("'" + propC->fName +
+                                     "' is not a cpu program uniform.");
+            propCpuLocs.append(loc);
+        } else propCpuLocs.append(-1);
+    }
+    for(const auto& value : fValueHandlers) {
+        const int loc = cpuProgram->uniformLocation(value->fName);
+        if(loc < 0) RuntimeThrow("'" + value->fName +
+                                 "' is not a cpu program uniform.");
+        valueCpuLocs.append(loc);
+    }
 }
 
 std::unique_ptr<ShaderEffectProgram>
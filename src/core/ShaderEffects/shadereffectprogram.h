@@ -19,6 +19,7 @@
 #include "uniformspecifiercreator.h"
 #include "shadervaluehandler.h"
 #include "shadereffectjs.h"
+#include "shadercpuprogram.h"
 
 typedef QList<stdsptr<UniformSpecifierCreator>> UniformSpecifierCreators;
 struct CORE_EXPORT ShaderEffectProgram {
@@ -37,7 +38,20 @@ struct CORE_EXPORT ShaderEffectProgram {
     mutable std::vector<std::unique_ptr<ShaderEffectJS>> fEngines;
     const QList<stdsptr<ShaderPropertyCreator>> fProperties;
 
+    //! @brief Null if the shader is not supported by ShaderCpuProgram
+    std::shared_ptr<ShaderCpuProgram> fCpuProgram;
+    QList<int> fPropCpuLocs;
+    QList<int> fValueCpuLocs;
+
+    //! @brief Without gl (no usable OpenGL context) only the cpu program
+    //! is created, throws if neither program could be created
     void reloadFragmentShader(QGL33 * const gl, const QString &fragPath);
+    //! @brief Throws if the shader is not supported by ShaderCpuProgram,
+    //! does not modify the current programs
+    void createCpuProgram(const QString &fragPath,
+                          std::shared_ptr<ShaderCpuProgram>& cpuProgram,
+                          QList<int>& propCpuLocs,
+                          QList<int>& valueCpuLocs) const;
 
     static std::unique_ptr<ShaderEffectProgram> sCreateProgram(
             QGL33 * const gl, const QString &fragPath,
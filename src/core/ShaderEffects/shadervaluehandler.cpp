@@ -161,3 +161,43 @@ UniformSpecifier ShaderValueHandler::create(const GLint loc, QJSValue* getter) c
         };
     } else RuntimeThrow("Unsupported type for " + fName);
 }
+
+CpuUniformSpecifier ShaderValueHandler::createCpu(const int loc,
+                                                  QJSValue* getter) const {
+    Q_ASSERT(loc >= 0);
+    bool isInt;
+    int size;
+    switch(mType) {
+    case GLValueType::Float: isInt = false; size = 1; break;
+    case GLValueType::Vec2: isInt = false; size = 2; break;
+    case GLValueType::Vec3: isInt = false; size = 3; break;
+    case GLValueType::Vec4: isInt = false; size = 4; break;
+    case GLValueType::Int: isInt = true; size = 1; break;
+    case GLValueType::iVec2: isInt = true; size = 2; break;
+    case GLValueType::iVec3: isInt = true; size = 3; break;
+    case GLValueType::iVec4: isInt = true; size = 4; break;
+    default: RuntimeThrow("Unsupported type for " + fName);
+    }
+    const QString name = fName;
+    return [loc, getter, isInt, size, name](ShaderCpuUniforms& uniforms) {
+        const QJSValue jsVal = getter->call();
+        ShaderCpuValue value(isInt ? ShaderCpuValue::Kind::Int :
+                                     ShaderCpuValue::Kind::Float, size);
+        if(size == 1) {
+            if(!jsVal.isNumber()) RuntimeThrow("Invalid value for " + name);
+            value.fV[0] = static_cast<float>(jsVal.toNumber());
+        } else {
+            const int len = jsVal.property("length").toInt();
+            if(!jsVal.isArray() || len != size)
+                RuntimeThrow("Invalid value for " + name);
+            for(int i = 0; i < size; i++) {
+                const qreal val = jsVal.property(static_cast<quint32>(i)).toNumber();
+                value.fV[i] = static_cast<float>(val);
+            }
+        }
+        if(isInt) {
+            for(int i = 0; i < size; i++) value.fV[i] = qRound(value.fV[i]);
+        }
+        uniforms[loc] = value;
+    };
+}
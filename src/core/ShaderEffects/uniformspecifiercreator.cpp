@@ -21,12 +21,14 @@
 void qrealAnimatorCreate(
         const bool glValue,
         const GLint loc,
+        const int cpuLoc,
         Property * const property,
         const qreal relFrame,
         const qreal resolution,
         const qreal influence,
         QJSValueList& setterArgs,
-        UniformSpecifiers& uniSpec) {
+        UniformSpecifiers& uniSpec,
+        CpuUniformSpecifiers& cpuUniSpec) {
     const auto anim = static_cast<QrealAnimator*>(property);
     const qreal val = anim->getEffectiveValue(relFrame)*resolution*influence;
     const QString propName = anim->prp_getName();
@@ -34,31 +36,40 @@ void qrealAnimatorCreate(
     setterArgs << val;
 
     if(!glValue) return;
-    Q_ASSERT(loc >= 0);
-    uniSpec << [loc, val, valScript](QGL33 * const gl) {
+    if(loc >= 0) uniSpec << [loc, val, valScript](QGL33 * const gl) {
         gl->glUniform1f(loc, static_cast<GLfloat>(val));
     };
+    if(cpuLoc < 0) return;
+    cpuUniSpec << [cpuLoc, val](ShaderCpuUniforms& uniforms) {
+        uniforms[cpuLoc] = ShaderCpuValue(ShaderCpuValue::Kind::Float, 1,
+                                          static_cast<float>(val));
+    };
 }
 
 void intAnimatorCreate(
         const bool glValue,
         const GLint loc,
+        const int cpuLoc,
         Property * const property,
         const qreal relFrame,
         const qreal resolution,
         const qreal influence,
         QJSValueList& setterArgs,
-        UniformSpecifiers& uniSpec) {
+        UniformSpecifiers& uniSpec,
+        CpuUniformSpecifiers& cpuUniSpec) {
     const auto anim = static_cast<IntAnimator*>(property);
     const int val = qRound(anim->getEffectiveIntValue(relFrame)*resolution*influence);
     const QString valScript = anim->prp_getName() + " = " + QString::number(val);
     setterArgs << val;
 
     if(!glValue) return;
-    Q_ASSERT(loc >= 0);
-    uniSpec << [loc, val, valScript](QGL33 * const gl) {
+    if(loc >= 0) uniSpec << [loc, val, valScript](QGL33 * const gl) {
         gl->glUniform1i(loc, val);
     };
+    if(cpuLoc < 0) return;
+    cpuUniSpec << [cpuLoc, val](ShaderCpuUniforms& uniforms) {
+        uniforms[cpuLoc] = ShaderCpuValue(ShaderCpuValue::Kind::Int, 1, val);
+    };
 }
 
 QString vec2ValScript(const QString& name, const QPointF& value) {
@@ -70,22 +81,29 @@ void qPointFAnimatorCreate(
         ShaderEffectJS &engine,
         const bool glValue,
         const GLint loc,
+        const int cpuLoc,
         Property * const property,
         const qreal relFrame,
         const qreal resolution,
         const qreal influence,
         QJSValueList& setterArgs,
-        UniformSpecifiers& uniSpec) {
+        UniformSpecifiers& uniSpec,
+        CpuUniformSpecifiers& cpuUniSpec) {
     const auto anim = static_cast<QPointFAnimator*>(property);
     const QPointF val = anim->getEffectiveValue(relFrame)*resolution*influence;
     const QString valScript = vec2ValScript(anim->prp_getName(), val);
     setterArgs << engine.toValue(val);
 
     if(!glValue) return;
-    Q_ASSERT(loc >= 0);
-    uniSpec << [loc, val, valScript](QGL33 * const gl) {
+    if(loc >= 0) uniSpec << [loc, val, valScript](QGL33 * const gl) {
         gl->glUniform2f(loc, val.x(), val.y());
     };
+    if(cpuLoc < 0) return;
+    cpuUniSpec << [cpuLoc, val](ShaderCpuUniforms& uniforms) {
+        uniforms[cpuLoc] = ShaderCpuValue(ShaderCpuValue::Kind::Float, 2,
+                                          static_cast<float>(val.x()),
+                                          static_cast<float>(val.y()));
+    };
 }
 
 QString colorValScript(const QString& name, const QColor& value) {
@@ -99,50 +117,63 @@ void colorAnimatorCreate(
         ShaderEffectJS &engine,
         const bool glValue,
         const GLint loc,
+        const int cpuLoc,
         Property * const property,
         const qreal relFrame,
         QJSValueList& setterArgs,
-        UniformSpecifiers& uniSpec) {
+        UniformSpecifiers& uniSpec,
+        CpuUniformSpecifiers& cpuUniSpec) {
     const auto anim = static_cast<ColorAnimator*>(property);
     const QColor val = anim->getColor(relFrame);
     const QString valScript = colorValScript(anim->prp_getName(), val);
     setterArgs << engine.toValue(val);
 
     if(!glValue) return;
-    Q_ASSERT(loc >= 0);
-    uniSpec << [loc, val, valScript](QGL33 * const gl) {
+    if(loc >= 0) uniSpec << [loc, val, valScript](QGL33 * const gl) {
         gl->glUniform4f(loc, val.redF(), val.greenF(), val.blueF(),
                         val.alphaF());
     };
+    if(cpuLoc < 0) return;
+    cpuUniSpec << [cpuLoc, val](ShaderCpuUniforms& uniforms) {
+        uniforms[cpuLoc] = ShaderCpuValue(ShaderCpuValue::Kind::Float, 4,
+                                          static_cast<float>(val.redF()),
+                                          static_cast<float>(val.greenF()),
+                                          static_cast<float>(val.blueF()),
+                                          static_cast<float>(val.alphaF()));
+    };
 }
 
 void UniformSpecifierCreator::create(ShaderEffectJS &engine,
                                      const GLint loc,
+                                     const int cpuLoc,
                                      Property * const property,
                                      const qreal relFrame,
                                      const qreal resolution,
                                      const qreal influence,
                                      QJSValueList& setterArgs,
-                                     UniformSpecifiers& uniSpec) const {
+                                     UniformSpecifiers& uniSpec,
+                                     CpuUniformSpecifiers& cpuUniSpec) const {
     switch(mType) {
     case ShaderPropertyType::floatProperty:
-        return qrealAnimatorCreate(fGLValue, loc, property, relFrame,
+        return qrealAnimatorCreate(fGLValue, loc, cpuLoc, property, relFrame,
                                    mResolutionScaled ? resolution : 1,
                                    mInfluenceScaled ? influence : 1,
-                                   setterArgs, uniSpec);
+                                   setterArgs, uniSpec, cpuUniSpec);
     case ShaderPropertyType::intProperty:
-        return intAnimatorCreate(fGLValue, loc, property, relFrame,
+        return intAnimatorCreate(fGLValue, loc, cpuLoc, property, relFrame,
                                  mResolutionScaled ? resolution : 1,
                                  mInfluenceScaled ? influence : 1,
-                                 setterArgs, uniSpec);
+                                 setterArgs, uniSpec, cpuUniSpec);
     case ShaderPropertyType::vec2Property:
-        return qPointFAnimatorCreate(engine, fGLValue, loc, property, relFrame,
+        return qPointFAnimatorCreate(engine, fGLValue, loc, cpuLoc,
+                                     property, relFrame,
                                      mResolutionScaled ? resolution : 1,
                                      mInfluenceScaled ? influence : 1,
-                                     setterArgs, uniSpec);
+                                     setterArgs, uniSpec, cpuUniSpec);
     case ShaderPropertyType::colorProperty:
-        return colorAnimatorCreate(engine, fGLValue, loc, property, relFrame,
-                                   setterArgs, uniSpec);
+        return colorAnimatorCreate(engine, fGLValue, loc, cpuLoc,
+                                   property, relFrame,
+                                   setterArgs, uniSpec, cpuUniSpec);
     default: RuntimeThrow("Unsupported type");
     }
 }
@@ -24,6 +24,7 @@
 #include "PropertyCreators/qpointfanimatorcreator.h"
 #include "PropertyCreators/coloranimatorcreator.h"
 #include "glhelpers.h"
+#include "shadercpuprogram.h"
 
 class ShaderEffectJS;
 
@@ -48,12 +49,14 @@ struct CORE_EXPORT UniformSpecifierCreator : public StdSelfRef {
 
     void create(ShaderEffectJS &engine,
                 const GLint loc,
+                const int cpuLoc,
                 Property * const property,
                 const qreal relFrame,
                 const qreal resolution,
                 const qreal influence,
                 QJSValueList& setterArgs,
-                UniformSpecifiers& uniSpec) const;
+                UniformSpecifiers& uniSpec,
+                CpuUniformSpecifiers& cpuUniSpec) const;
 
     const ShaderPropertyType mType;
     const bool fGLValue;
@@ -0,0 +1,83 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "audiochunkqueue.h"
+
+#include <cstring>
+
+bool AudioChunkQueue::push(const AudioChunk& chunk) {
+    if(chunk.bytes() <= 0) return true;
+    if(full()) return false;
+    const quint64 head = mHead.load(std::memory_order_relaxed);
+    auto& slot = mSlots[head % sCapacity];
+    slot.fChunk = chunk;
+    slot.fStart = mPushedBytes;
+    mPushedBytes += chunk.bytes();
+    mHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool AudioChunkQueue::full() {
+    releasePlayed();
+    const quint64 head = mHead.load(std::memory_order_relaxed);
+    return head - mReleased >= sCapacity;
+}
+
+void AudioChunkQueue::clear() {
+    mDropUntil.store(mHead.load(std::memory_order_relaxed),
+                     std::memory_order_release);
+    mDroppedBytes = mPushedBytes;
+    releasePlayed();
+}
+
+qint64 AudioChunkQueue::queuedBytes() const {
+    const qint64 read = mReadBytes.load(std::memory_order_acquire);
+    return mPushedBytes - qMax(read, mDroppedBytes);
+}
+
+void AudioChunkQueue::releasePlayed() {
+    const quint64 tail = mTail.load(std::memory_order_acquire);
+    for(; mReleased < tail; mReleased++) {
+        mSlots[mReleased % sCapacity].fChunk.fSamples.reset();
+    }
+}
+
+qint64 AudioChunkQueue::read(char * const data, const qint64 len) {
+    const quint64 head = mHead.load(std::memory_order_acquire);
+    quint64 tail = mTail.load(std::memory_order_relaxed);
+    qint64 readBytes = mReadBytes.load(std::memory_order_relaxed);
+    const quint64 dropUntil = mDropUntil.load(std::memory_order_acquire);
+    if(dropUntil > tail) {
+        const auto& last = mSlots[(dropUntil - 1) % sCapacity];
+        readBytes = last.fStart + last.fChunk.bytes();
+        tail = dropUntil;
+    }
+    qint64 total = 0;
+    while(total < len && tail < head) {
+        const auto& slot = mSlots[tail % sCapacity];
+        const auto& chunk = slot.fChunk;
+        const qint64 offset = readBytes - slot.fStart;
+        const qint64 n = qMin(len - total, chunk.bytes() - offset);
+        const auto src = chunk.fSamples->fData[0] + chunk.fBegin + offset;
+        memcpy(data + total, src, static_cast<size_t>(n));
+        readBytes += n;
+        total += n;
+        if(offset + n >= chunk.bytes()) tail++;
+    }
+    mReadBytes.store(readBytes, std::memory_order_release);
+    mTail.store(tail, std::memory_order_release);
+    return total;
+}
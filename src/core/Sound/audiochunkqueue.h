@@ -0,0 +1,79 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AUDIOCHUNKQUEUE_H
+#define AUDIOCHUNKQUEUE_H
+
+#include <atomic>
+
+#include "CacheHandlers/samples.h"
+
+//! @brief Interleaved bytes [fBegin, fEnd) of merged samples
+struct CORE_EXPORT AudioChunk {
+    stdsptr<Samples> fSamples;
+    qint64 fBegin = 0;
+    qint64 fEnd = 0;
+
+    qint64 bytes() const { return fEnd - fBegin; }
+};
+
+//! @brief Lock-free single producer, single consumer ring of chunks
+//! handed from the GUI thread to the audio output thread.
+//! The audio thread copies from the shared samples itself, so playback
+//! survives GUI stalls as long as chunks are queued. It never allocates,
+//! frees or waits, played chunks are released back on the GUI thread.
+class CORE_EXPORT AudioChunkQueue {
+public:
+    // GUI thread
+    //! @brief False if all slots are taken
+    bool push(const AudioChunk& chunk);
+    bool full();
+    //! @brief Requests dropping everything queued so far,
+    //! the audio thread skips it on its next read
+    void clear();
+
+    qint64 queuedBytes() const;
+
+    // audio thread
+    qint64 read(char * const data, const qint64 len);
+private:
+    //! @brief Releases the samples of chunks the audio thread is done with
+    void releasePlayed();
+
+    static const quint64 sCapacity = 256;
+    struct Slot {
+        AudioChunk fChunk;
+        //! @brief Total bytes pushed before this chunk
+        qint64 fStart = 0;
+    };
+    Slot mSlots[sCapacity];
+
+    //! @brief Slots before mHead are published (written by GUI thread)
+    std::atomic<quint64> mHead{0};
+    //! @brief Slots before mTail are played (written by audio thread)
+    std::atomic<quint64> mTail{0};
+    //! @brief Chunks before mDropUntil are not to be played
+    std::atomic<quint64> mDropUntil{0};
+    //! @brief Bytes played or skipped (written by audio thread)
+    std::atomic<qint64> mReadBytes{0};
+
+    // GUI thread only
+    quint64 mReleased = 0;
+    qint64 mPushedBytes = 0;
+    qint64 mDroppedBytes = 0;
+};
+
+#endif // AUDIOCHUNKQUEUE_H
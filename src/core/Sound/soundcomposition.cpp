@@ -20,6 +20,12 @@
 #include "CacheHandlers/soundcachecontainer.h"
 #include "soundmerger.h"
 #include "FileCacheHandlers/soundreaderformerger.h"
+#include "Private/esettings.h"
+
+int floorDiv(const qint64 value, const int divisor) {
+    const qint64 result = value/divisor;
+    return static_cast<int>(value % divisor < 0 ? result - 1 : result);
+}
 
 SoundComposition::SoundComposition(Canvas * const parent) :
     QIODevice(parent), mParent(parent) {
@@ -27,17 +33,33 @@ SoundComposition::SoundComposition(Canvas * const parent) :
             this, [this]() {
         mSettings = eSoundSettings::sData();
         mSecondsCache.clear();
+        mBlocks.clear();
     });
 }
 
 void SoundComposition::start(const int startFrame) {
     mPos = qRound(startFrame*mSettings.fSampleRate/mParent->getFps());
-    open(QIODevice::ReadOnly);
+    mEndPos = -1;
+    const int blockSize = eSettings::instance().fAudioBlockSize;
+    const int newBlockSize = qBound(256, blockSize, mSettings.fSampleRate);
+    if(newBlockSize != mBlockSize) {
+        mBlockSize = newBlockSize;
+        mBlocks.clear();
+    }
+    // unbuffered, seeking only moves mPos
+    if(!isOpen()) open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+void SoundComposition::startScrub(const int frame, const int nFrames) {
+    start(frame);
+    const qreal fps = mParent->getFps();
+    mEndPos = mPos + qRound(nFrames*mSettings.fSampleRate/fps);
 }
 
 void SoundComposition::stop() {
     close();
     clearUseRange();
+    mBlocks.clear();
 }
 
 void SoundComposition::addSound(const qsptr<eSound>& sound) {
@@ -61,6 +83,13 @@ void SoundComposition::secondFinished(const int secondId,
     mSecondsCache.add(sCont);
 }
 
+void SoundComposition::blockFinished(const int blockId,
+                                     const stdsptr<Samples> &samples) {
+    mProcessingBlocks.removeOne(blockId);
+    if(!samples || !isOpen()) return;
+    mBlocks[blockId] = samples;
+}
+
 void SoundComposition::setMinFrameUseRange(const int frame) {
     const qreal fps = mParent->getFps();
     const int sec = qFloor(frame/fps);
@@ -97,24 +126,48 @@ SoundMerger *SoundComposition::scheduleSecond(const int secondId) {
     const int sampleRate = mSettings.fSampleRate;
     const SampleRange sampleRange = {secondId*sampleRate,
                                      (secondId + 1)*sampleRate - 1};
+    return scheduleMerger(secondId, sampleRange, false);
+}
+
+SoundMerger *SoundComposition::scheduleBlock(const int blockId) {
+    if(mSounds.isEmpty()) return nullptr;
+    if(mProcessingBlocks.contains(blockId)) return nullptr;
+    if(mBlocks.find(blockId) != mBlocks.end()) return nullptr;
+    mProcessingBlocks.append(blockId);
+    const SampleRange sampleRange = {blockId*mBlockSize,
+                                     (blockId + 1)*mBlockSize - 1};
+    return scheduleMerger(blockId, sampleRange, true);
+}
+
+SoundMerger *SoundComposition::scheduleMerger(const int id,
+                                              const SampleRange& sampleRange,
+                                              const bool block) {
+    const int sampleRate = mSettings.fSampleRate;
+    const iValueRange absSecRange{floorDiv(sampleRange.fMin, sampleRate),
+                                  floorDiv(sampleRange.fMax, sampleRate)};
     const qreal fps = mParent->getFps();
 
-    const auto task = enve::make_shared<SoundMerger>(secondId, sampleRange, this);
+    const auto task = enve::make_shared<SoundMerger>(id, sampleRange,
+                                                     this, block);
     for(const auto &sound : mSounds) {
         if(!sound->isVisible()) continue;
         const auto enabledFrameRange = sound->prp_absInfluenceRange();
         const iValueRange enabledSecRange{qFloor(enabledFrameRange.fMin/fps),
                                           qFloor(enabledFrameRange.fMax/fps)};
-        if(!enabledSecRange.inRange(secondId)) continue;
-        const auto secs = sound->absSecondToRelSeconds(secondId);
-        for(int i = secs.fMin; i <= secs.fMax; i++) {
+        if(!enabledSecRange.overlaps(absSecRange)) continue;
+        // blocks can span two seconds
+        const auto firstSecs = sound->absSecondToRelSeconds(absSecRange.fMin);
+        const auto lastSecs = sound->absSecondToRelSeconds(absSecRange.fMax);
+        const int minSec = qMin(firstSecs.fMin, lastSecs.fMin);
+        const int maxSec = qMax(firstSecs.fMax, lastSecs.fMax);
+        for(int i = minSec; i <= maxSec; i++) {
             const auto samples = sound->getSamplesForSecond(i);
             if(samples) {
                 task->addSoundToMerge({sound->getSampleShift(),
                                        sound->absSampleRange(),
                                        sound->getVolumeSnap(),
                                        sound->getStretch(),
-                                       enve::make_shared<Samples>(samples)});
+                                       samples});
             } else {
                 const auto reader = sound->getSecondReader(i);
                 if(!reader) continue;
@@ -132,38 +185,70 @@ SoundMerger *SoundComposition::scheduleSecond(const int secondId) {
     return task.get();
 }
 
+stdsptr<Samples> SoundComposition::samplesAt(const qint64 sample) {
+    const int secondId = floorDiv(sample, mSettings.fSampleRate);
+    const auto cont = mSecondsCache.atFrame<SoundCacheContainer>(secondId);
+    if(cont) {
+        const auto samples = cont->getSamples();
+        if(samples && samples->fData) return samples;
+    }
+    const int blockId = floorDiv(sample, mBlockSize);
+    const auto it = mBlocks.find(blockId);
+    if(it == mBlocks.end()) {
+        // the whole second is merged by scheduleFrameRange
+        scheduleBlock(blockId);
+        return nullptr;
+    }
+    // keep one block ahead of playback
+    const qint64 nextBlockSample = qint64(blockId + 1)*mBlockSize;
+    const int nextSecondId = floorDiv(nextBlockSample, mSettings.fSampleRate);
+    if(!mSecondsCache.atFrame(nextSecondId)) scheduleBlock(blockId + 1);
+    return it->second;
+}
+
 void SoundComposition::frameRangeChanged(const FrameRange &range) {
     const qreal fps = mParent->getFps();
     secondRangeChanged({qFloor(range.fMin/fps), qCeil(range.fMax/fps)});
 }
 
-qint64 SoundComposition::readData(char *data, qint64 maxLen) {
-    const int sampleRate = mSettings.fSampleRate;
-    const int bytesPerSample = mSettings.bytesPerSample();
-    const int nChannels = mSettings.channelCount();
-    const int bytesPerSampleFrame = nChannels * bytesPerSample;
-
-    qint64 total = 0;
+bool SoundComposition::nextChunk(const qint64 maxBytes, AudioChunk& chunk) {
+    const int bytesPerSampleFrame = mSettings.channelCount()*
+                                    mSettings.bytesPerSample();
+    qint64 maxSamples = maxBytes/bytesPerSampleFrame;
+    if(mEndPos >= 0) maxSamples = qMin(maxSamples, mEndPos - mPos);
+    if(maxSamples <= 0) return false;
+    auto samples = samplesAt(mPos);
+    if(!samples) return false;
     const SampleRange readSamples{static_cast<int>(mPos),
-                                  static_cast<int>(mPos + maxLen/bytesPerSampleFrame)};
-    while(maxLen > total) {
-        const int secondId = static_cast<int>(mPos/sampleRate + (mPos >= 0 ? 0 : -1));
-        const auto cont = mSecondsCache.atFrame<SoundCacheContainer>(secondId);
-        if(!cont) break;
-        const auto samples = cont->getSamples();
-        const auto contSampleRange = samples->fSampleRange;
-        const auto secondData = samples->fData;
-        if(!secondData) break;
-        const SampleRange samplesToRead = readSamples*contSampleRange;
-        const SampleRange contRelRange = samplesToRead.shifted(-contSampleRange.fMin);
-        const qint64 nSamples = contRelRange.span();
-        const qint64 chunk = qMin(maxLen - total, nSamples*bytesPerSampleFrame);
-        const auto src = secondData[0] + contRelRange.fMin*bytesPerSampleFrame;
-        memcpy(data + total, src, static_cast<size_t>(chunk));
-        mPos += nSamples;
-        total += chunk;
+                                  static_cast<int>(mPos + maxSamples - 1)};
+    const auto contSampleRange = samples->fSampleRange;
+    const SampleRange contRelRange =
+            (readSamples*contSampleRange).shifted(-contSampleRange.fMin);
+    const qint64 nSamples = contRelRange.span();
+    if(nSamples <= 0) return false;
+    chunk.fSamples = std::move(samples);
+    chunk.fBegin = contRelRange.fMin*bytesPerSampleFrame;
+    chunk.fEnd = chunk.fBegin + nSamples*bytesPerSampleFrame;
+    mPos += nSamples;
+    releasePlayedBlocks();
+    return true;
+}
+
+void SoundComposition::releasePlayedBlocks() {
+    const int playedBlock = floorDiv(mPos, mBlockSize) - 1;
+    while(!mBlocks.empty() && mBlocks.begin()->first < playedBlock) {
+        mBlocks.erase(mBlocks.begin());
     }
+}
 
+qint64 SoundComposition::readData(char *data, qint64 maxLen) {
+    qint64 total = 0;
+    AudioChunk chunk;
+    while(maxLen > total && nextChunk(maxLen - total, chunk)) {
+        const auto src = chunk.fSamples->fData[0] + chunk.fBegin;
+        memcpy(data + total, src, static_cast<size_t>(chunk.bytes()));
+        total += chunk.bytes();
+    }
     return total;
 }
 
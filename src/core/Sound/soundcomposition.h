@@ -22,7 +22,9 @@
 #include "CacheHandlers/samples.h"
 #include "esound.h"
 #include "esoundsettings.h"
+#include "audiochunkqueue.h"
 #include <math.h>
+#include <map>
 
 #include <QAudioOutput>
 #include <QByteArray>
@@ -42,8 +44,14 @@ public:
     SoundComposition(Canvas * const parent);
 
     void start(const int startFrame);
+    //! @brief Starts playback limited to nFrames, used for scrubbing
+    void startScrub(const int frame, const int nFrames);
     void stop();
 
+    //! @brief Next merged samples from the playback position, at most
+    //! maxBytes, advances the position, false if nothing is ready yet
+    bool nextChunk(const qint64 maxBytes, AudioChunk& chunk);
+
     qint64 readData(char *data, qint64 maxLen);
     qint64 writeData(const char *data, qint64 len);
 
@@ -52,6 +60,8 @@ public:
 
     void secondFinished(const int secondId,
                         const stdsptr<Samples>& samples);
+    void blockFinished(const int blockId,
+                       const stdsptr<Samples>& samples);
 
     void setMinFrameUseRange(const int frame);
     void setMaxFrameUseRange(const int frame);
@@ -67,17 +77,30 @@ public:
     bool hasAnySounds() const { return !mSounds.isEmpty(); }
 private:
     SoundMerger * scheduleSecond(const int secondId);
+    SoundMerger * scheduleBlock(const int blockId);
+    SoundMerger * scheduleMerger(const int id, const SampleRange& sampleRange,
+                                 const bool block);
+    //! @brief Merged samples containing the sample, either a whole cached
+    //! second or a playback block, schedules the block if neither is ready
+    stdsptr<Samples> samplesAt(const qint64 sample);
+    void releasePlayedBlocks();
 
     void frameRangeChanged(const FrameRange &range);
 
     void secondRangeChanged(const iValueRange &range) {
         mSecondsCache.remove(range);
+        mBlocks.clear();
     }
 
     eSoundSettingsData mSettings;
     QList<int> mProcessingSeconds;
+    QList<int> mProcessingBlocks;
+    //! @brief Sub-second blocks merged for playback before their second
+    std::map<int, stdsptr<Samples>> mBlocks;
+    int mBlockSize = 2048;
     const Canvas * const mParent;
     qint64 mPos;
+    qint64 mEndPos = -1;
     ConnContextObjList<qsptr<eSound>> mSounds;
     HddCachableCacheHandler mSecondsCache;
 };
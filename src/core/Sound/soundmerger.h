@@ -36,16 +36,23 @@ struct CORE_EXPORT SingleSoundData {
 class CORE_EXPORT SoundMerger : public eCpuTask {
     e_OBJECT
 protected:
-    SoundMerger(const int secondId, const SampleRange& sampleRange,
-                SoundComposition* const composition) :
-        mSecondId(secondId), mSampleRange(sampleRange),
+    //! @param id Second id, or block id for playback blocks
+    SoundMerger(const int id, const SampleRange& sampleRange,
+                SoundComposition* const composition,
+                const bool block = false) :
+        mId(id), mBlock(block), mSampleRange(sampleRange),
         mComposition(composition), mSettings(eSoundSettings::sData()) {
 
     }
 
     void afterProcessing() {
-        if(mComposition)
-            mComposition->secondFinished(mSecondId, mSamples);
+        if(!mComposition) return;
+        if(mBlock) mComposition->blockFinished(mId, mSamples);
+        else mComposition->secondFinished(mId, mSamples);
+    }
+
+    void afterCanceled() {
+        afterProcessing();
     }
 public:
     void process();
@@ -54,7 +61,8 @@ public:
         mSounds << data;
     }
 private:
-    const int mSecondId;
+    const int mId;
+    const bool mBlock;
     const SampleRange mSampleRange;
     const qptr<SoundComposition> mComposition;
     const eSoundSettingsData mSettings;
@@ -27,3 +27,8 @@ void eTask::aboutToProcess(const Hardware hw) {
     mState = eTaskState::processing;
     beforeProcessing(hw);
 }
+
+void eTask::setTargetFrame(const int frame) {
+    mHasTargetFrame = true;
+    mTargetFrame = frame;
+}
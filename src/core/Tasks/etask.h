@@ -23,6 +23,12 @@
 #include "../ReadWrite/basicreadwrite.h"
 #include "etaskbase.h"
 
+enum class TaskPriority : short {
+    current, // frame displayed at the playhead
+    lookahead, // frame rendered ahead of the playhead
+    background // nothing is waiting for the result
+};
+
 class CORE_EXPORT eTask : public StdSelfRef, public eTaskBase {
     friend class TaskScheduler;
     friend class Que;
@@ -45,6 +51,24 @@ public:
     bool queTask();
 
     void aboutToProcess(const Hardware hw);
+
+    //! @brief Only background has to be requested explicitly (before queing),
+    //! current and lookahead are derived from the target frame.
+    void setPriority(const TaskPriority priority) { mPriority = priority; }
+    TaskPriority priority() const { return mPriority; }
+
+    //! @brief Frame render tasks are canceled once the playhead
+    //! jumps away from their frame, other tasks are always kept
+    virtual bool rendersFrame() const { return false; }
+
+    //! @brief Frame the result is needed for, assigned when first qued
+    void setTargetFrame(const int frame);
+    bool hasTargetFrame() const { return mHasTargetFrame; }
+    int targetFrame() const { return mTargetFrame; }
+private:
+    TaskPriority mPriority = TaskPriority::current;
+    bool mHasTargetFrame = false;
+    int mTargetFrame = 0;
 };
 
 Q_DECLARE_METATYPE(stdsptr<eTask>);
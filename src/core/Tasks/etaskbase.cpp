@@ -76,6 +76,17 @@ void eTaskBase::cancel() {
     afterCanceled();
 }
 
+bool eTaskBase::allDependentCanceled() const {
+    if(mDependent.isEmpty() || !mDependentF.isEmpty()) return false;
+    for(const auto& dependent : mDependent) {
+        if(!dependent) continue;
+        if(dependent->getState() == eTaskState::canceled) continue;
+        if(dependent->waitingToCancel()) continue;
+        return false;
+    }
+    return true;
+}
+
 void eTaskBase::moveDependent(eTaskBase* const to) {
     for(const auto& dependent : mDependent) {
         to->mDependent << dependent;
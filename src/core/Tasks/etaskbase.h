@@ -65,6 +65,10 @@ public:
 
     bool waitingToCancel() const { return mCancel; }
     void cancel();
+
+    //! @brief True if the task only feeds tasks that were canceled,
+    //! tasks without dependent or with callbacks return false
+    bool allDependentCanceled() const;
 protected:
     eTaskState mState = eTaskState::created;
 
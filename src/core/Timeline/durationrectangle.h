@@ -211,6 +211,9 @@ public:
         mSoundCacheHandler = handler;
     }
 
+    bool drawsCache() const
+    { return mRasterCacheHandler || mSoundCacheHandler; }
+
     void setRelShift(const int shift) { setValue(shift); }
 
     int getRelShift() const { return getValue(); }
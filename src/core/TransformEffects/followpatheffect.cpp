@@ -24,6 +24,20 @@ FollowPathEffect::FollowPathEffect() :
     TargetTransformEffect("follow path", TransformEffectType::followPath) {
     targetProperty()->setValidator<PathBox>();
 
+    // follower transforms are cached, they depend on the target path too
+    connect(targetProperty(), &BoxTargetProperty::targetSet,
+            this, [this](BoundingBox* const newTarget) {
+        auto& conn = mPathConn.assign(newTarget);
+        const auto parent = getFirstAncestor<BoundingBox>();
+        if(!newTarget || !parent || newTarget == parent) return;
+        const auto parentTransform = parent->getTransformAnimator();
+        conn << connect(newTarget, &Property::prp_absFrameRangeChanged,
+                        this, [parentTransform](const FrameRange& range,
+                                                const bool clip) {
+            parentTransform->prp_afterChangedAbsRange(range, clip);
+        });
+    });
+
     mRotate = enve::make_shared<BoolProperty>("rotate");
     mLengthBased = enve::make_shared<BoolProperty>("length based");
     mComplete = enve::make_shared<QrealAnimator>(0, 0, 1, 0.01, "complete");
@@ -35,31 +49,49 @@ FollowPathEffect::FollowPathEffect() :
     ca_addChild(mInfluence);
 }
 
+bool isSimilarity(const QMatrix& transform) {
+    const bool rotation = isZero4Dec(transform.m11() - transform.m22()) &&
+                          isZero4Dec(transform.m12() + transform.m21());
+    const bool reflection = isZero4Dec(transform.m11() + transform.m22()) &&
+                            isZero4Dec(transform.m12() - transform.m21());
+    return rotation || reflection;
+}
+
 void calculateFollowRotPosChange(
-        const SkPath relPath,
+        PathBox * const target,
+        const qreal targetRelFrame,
         const QMatrix transform,
         const bool lengthBased,
         const bool rotate,
         const qreal infl,
-        qreal per,
+        const qreal per,
         qreal& rotChange,
         qreal& posXChange,
         qreal& posYChange) {
-    SkPath path;
-    relPath.transform(toSkMatrix(transform), &path);
-    const QPainterPath qpath = toQPainterPath(path);
-
-    if(lengthBased) {
-        const qreal length = qpath.length();
-        per = qpath.percentAtLength(per*length);
+    // length fractions survive rotation, translation and uniform scaling,
+    // so the table cached on target can be measured before transforming
+    stdsptr<const ArcLengthTable> table;
+    QMatrix postTransform;
+    if(isSimilarity(transform)) {
+        table = target->getArcLengthTable(targetRelFrame);
+        postTransform = transform;
+    } else {
+        SkPath path;
+        const auto relPath = target->getRelativePath(targetRelFrame);
+        relPath.transform(toSkMatrix(transform), &path);
+        table = std::make_shared<const ArcLengthTable>(path);
     }
-    const auto p1 = qpath.pointAtPercent(per);
+
+    const qreal totalLength = table->totalLength();
+    const qreal len = lengthBased ? per*totalLength :
+                                    table->lengthAtPercent(per);
+    const auto p1 = postTransform.map(table->posAtLength(len));
 
     if(rotate) {
-        qreal t2 = per + 0.0001;
-        const bool reverse = t2 > 1;
-        if(reverse) t2 = 0.9999;
-        const auto p2 = qpath.pointAtPercent(t2);
+        qreal len2 = len + 0.0001*totalLength;
+        const bool reverse = len2 > totalLength;
+        if(reverse) len2 = 0.9999*totalLength;
+        const auto p2 = postTransform.map(table->posAtLength(len2));
 
         const QLineF baseLine(QPointF(0., 0.), QPointF(100., 0.));
         QLineF l;
@@ -91,14 +123,14 @@ void FollowPathEffect::setRotScaleAfterTargetChange(
 
     qreal rot = 0.;
     if(oldTargetP) {
-        const auto relPath = oldTargetP->getRelativePath();
+        const qreal targetRelFrame = oldTargetP->anim_getCurrentRelFrame();
         const auto targetTransform = oldTargetP->getTotalTransform();
         const auto transform = targetTransform*parentTransform.inverted();
 
         qreal rotChange;
         qreal posXChange;
         qreal posYChange;
-        calculateFollowRotPosChange(relPath, transform,
+        calculateFollowRotPosChange(oldTargetP, targetRelFrame, transform,
                                     lengthBased, rotate, infl, per,
                                     rotChange, posXChange, posYChange);
 
@@ -106,14 +138,14 @@ void FollowPathEffect::setRotScaleAfterTargetChange(
     }
 
     if(newTargetP) {
-        const auto relPath = newTargetP->getRelativePath();
+        const qreal targetRelFrame = newTargetP->anim_getCurrentRelFrame();
         const auto targetTransform = newTargetP->getTotalTransform();
         const auto transform = targetTransform*parentTransform.inverted();
 
         qreal rotChange;
         qreal posXChange;
         qreal posYChange;
-        calculateFollowRotPosChange(relPath, transform,
+        calculateFollowRotPosChange(newTargetP, targetRelFrame, transform,
                                     lengthBased, rotate, infl, per,
                                     rotChange, posXChange, posYChange);
 
@@ -153,9 +185,8 @@ void FollowPathEffect::applyEffect(const qreal relFrame,
 
     const auto transform = targetTransform*parentTransform.inverted();
 
-    const auto relPath = target->getRelativePath(targetRelFrame);
     const qreal infl = mInfluence->getEffectiveValue(relFrame);
-    qreal per = mComplete->getEffectiveValue(relFrame);
+    const qreal per = mComplete->getEffectiveValue(relFrame);
     const bool rotate = mRotate->getValue();
     const bool lengthBased = mLengthBased->getValue();
 
@@ -163,7 +194,7 @@ void FollowPathEffect::applyEffect(const qreal relFrame,
     qreal posXChange;
     qreal posYChange;
 
-    calculateFollowRotPosChange(relPath, transform,
+    calculateFollowRotPosChange(target, targetRelFrame, transform,
                                 lengthBased, rotate, infl, per,
                                 rotChange, posXChange, posYChange);
 
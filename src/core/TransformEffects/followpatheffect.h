@@ -38,6 +38,8 @@ private:
                 BoundingBox* const oldTarget,
                 BoundingBox* const newTarget) override;
 
+    ConnContextQPtr<BoundingBox> mPathConn;
+
     qsptr<BoolProperty> mRotate;
     qsptr<BoolProperty> mLengthBased;
     qsptr<QrealAnimator> mComplete;
@@ -39,6 +39,9 @@
 #include "ReadWrite/evformat.h"
 #include "eevent.h"
 #include "Boxes/nullobject.h"
+#include "CacheHandlers/persistentframecache.h"
+#include <QBuffer>
+#include <QCryptographicHash>
 
 Canvas::Canvas(Document &document,
                const int canvasWidth, const int canvasHeight,
@@ -423,6 +426,13 @@ void Canvas::setOutputRendering(const bool bT) {
     mRenderingOutput = bT;
 }
 
+void Canvas::setHighBitDepth(const bool high) {
+    if(mHighBitDepth == high) return;
+    mHighBitDepth = high;
+    prp_afterWholeInfluenceRangeChanged();
+    updateAllBoxes(UpdateReason::userChange);
+}
+
 void Canvas::setSceneFrame(const int relFrame) {
     const auto cont = mSceneFramesHandler.atFrame(relFrame);
     setSceneFrame(enve::shared<SceneFrameContainer>(cont));
@@ -434,6 +444,84 @@ void Canvas::setSceneFrame(const stdsptr<SceneFrameContainer>& cont) {
     emit requestUpdate();
 }
 
+sk_sp<SkImage> Canvas::sceneFrameImage(const int relFrame) const {
+    const auto cont = mSceneFramesHandler.atFrame<SceneFrameContainer>(relFrame);
+    if(!cont || cont->fBoxState != mStateId) return nullptr;
+    if(!cont->storesDataInMemory()) return nullptr;
+    if(!isZero4Dec(cont->fResolution - mResolution)) return nullptr;
+    return cont->getImage();
+}
+
+stdsptr<BoxRenderData> Canvas::queSceneFrame(const int relFrame) {
+    const auto current = mRenderDataHandler.getItemAtRelFrame(relFrame);
+    if(current && current->fBoxStateId == mStateId)
+        return current->ref<BoxRenderData>();
+    const auto parentM = getInheritedTransformAtFrame(relFrame);
+    const auto renderData = queRender(relFrame, parentM);
+    if(const auto canvasData = enve_cast<CanvasRenderData*>(renderData.get()))
+        canvasData->fQuedForLink = true;
+    return renderData;
+}
+
+const QByteArray& Canvas::contentHash() {
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    eWriteStream dst(&buffer);
+    // rewrites only the boxes changed since the last call
+    dst << fingerprint();
+    dst << mClipToCanvasSize;
+    dst << mWidth;
+    dst << mHeight;
+    dst << mRasterEffectsVisible;
+    dst << mPathEffectsVisible;
+    buffer.close();
+    mContentHash = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    return mContentHash;
+}
+
+bool Canvas::loadPersistentFrame(const int relFrame) {
+    if(!PersistentFrameCache::sEnabled()) return false;
+    // only 8 bit frames are stored
+    if(mHighBitDepth) return false;
+    const auto cache = PersistentFrameCache::sInstance;
+    const auto range = prp_getIdenticalRelRange(relFrame);
+    const qreal resolution = mResolution;
+    const auto key = PersistentFrameCache::sKey(contentHash(), range.fMin,
+                                                resolution);
+    if(!cache->contains(key)) return false;
+    const uint stateId = mStateId;
+    const qptr<Canvas> ptr = this;
+    cache->load(key, [ptr, stateId, range, resolution](
+                const sk_sp<SkImage>& img) {
+        if(!ptr) return;
+        const bool current = range.inRange(ptr->anim_getCurrentRelFrame());
+        if(!img) {
+            if(!current) return;
+            ptr->mSceneFrameOutdated = true;
+            ptr->planUpdate(UpdateReason::frameChange);
+            return;
+        }
+        if(ptr->mStateId != stateId) return;
+        if(!isZero4Dec(ptr->mResolution - resolution)) return;
+        if(ptr->mSceneFramesHandler.atFrame(range.fMin)) return;
+        const auto cont = enve::make_shared<SceneFrameContainer>(
+                    ptr, img, stateId, resolution, range,
+                    &ptr->mSceneFramesHandler);
+        ptr->mSceneFramesHandler.add(cont);
+        if(current) ptr->setSceneFrame(cont);
+    });
+    return true;
+}
+
+void Canvas::storePersistentFrame(const SceneFrameContainer * const cont) {
+    if(!PersistentFrameCache::sEnabled()) return;
+    const auto key = PersistentFrameCache::sKey(contentHash(),
+                                                cont->getRange().fMin,
+                                                cont->fResolution);
+    PersistentFrameCache::sInstance->store(key, cont->getImage());
+}
+
 void Canvas::setLoadingSceneFrame(const stdsptr<SceneFrameContainer>& cont) {
     if(mLoadingSceneFrame == cont) return;
     mLoadingSceneFrame = cont;
@@ -460,9 +548,18 @@ void Canvas::renderDataFinished(BoxRenderData *renderData) {
     const auto cont = enve::make_shared<SceneFrameContainer>(
                 this, renderData, range,
                 currentState ? &mSceneFramesHandler : nullptr);
-    if(currentState) mSceneFramesHandler.add(cont);
+    if(currentState) {
+        mSceneFramesHandler.add(cont);
+        if(mRenderingPreview || mRenderingOutput) storePersistentFrame(cont.get());
+    }
+
+    // frames rendered for links do not replace the displayed frame,
+    // unless this scene needs the frame as well
+    const auto canvasData = enve_cast<CanvasRenderData*>(renderData);
+    const bool forLink = canvasData && canvasData->fQuedForLink &&
+                         !range.inRange(anim_getCurrentRelFrame());
 
-    if(!mPreviewing && !mRenderingOutput){
+    if(!mPreviewing && !mRenderingOutput && !forLink) {
         bool newerSate = true;
         bool closerFrame = true;
         if(mSceneFrame) {
@@ -484,6 +581,7 @@ void Canvas::renderDataFinished(BoxRenderData *renderData) {
 
 void Canvas::prp_afterChangedAbsRange(const FrameRange &range, const bool clip) {
     Property::prp_afterChangedAbsRange(range, clip);
+    mIdenticalRelRange = FrameRange::INVALID;
     mSceneFramesHandler.remove(range);
     if(!mSceneFramesHandler.atFrame(anim_getCurrentRelFrame())) {
         mSceneFrameOutdated = true;
@@ -710,6 +808,9 @@ void Canvas::anim_setAbsFrame(const int frame) {
             setLoadingSceneFrame(cont->ref<SceneFrameContainer>());
         }
         mSceneFrameOutdated = !cont->storesDataInMemory();
+    } else if(loadPersistentFrame(newRelFrame)) {
+        // rendering resumes only if loading fails
+        mSceneFrameOutdated = false;
     } else {
         mSceneFrameOutdated = true;
         planUpdate(UpdateReason::frameChange);
@@ -255,6 +255,10 @@ public:
 
     void setPreviewing(const bool bT);
     void setOutputRendering(const bool bT);
+    //! @brief Boxes without raster effects render to half float bitmaps,
+    //! used for output to pixel formats above 8 bits per component
+    void setHighBitDepth(const bool high);
+    bool highBitDepth() const { return mHighBitDepth; }
 
     bool SWT_shouldBeVisible(const SWT_RulesCollection &rules,
                              const bool parentSatisfies,
@@ -406,6 +410,16 @@ public:
     void setSceneFrame(const stdsptr<SceneFrameContainer> &cont);
     void setLoadingSceneFrame(const stdsptr<SceneFrameContainer> &cont);
 
+    //! @brief Up to date cached frame at the current resolution,
+    //! null if not rendered or not in memory
+    sk_sp<SkImage> sceneFrameImage(const int relFrame) const;
+    //! @brief Render data of the frame, queued if not already in progress,
+    //! the result is stored in the scene frames cache
+    stdsptr<BoxRenderData> queSceneFrame(const int relFrame);
+    //! @brief Hash of everything affecting rendered frames,
+    //! independent of the current frame
+    const QByteArray& contentHash();
+
     void setRenderingPreview(const bool bT);
 
     bool isPreviewingOrRendering() const {
@@ -603,6 +617,9 @@ protected:
 
     void updatePaintBox();
 
+    bool loadPersistentFrame(const int relFrame);
+    void storePersistentFrame(const SceneFrameContainer * const cont);
+
     PaintTarget mPaintTarget;
     bool mStylusDrawing = false;
 
@@ -653,11 +670,14 @@ protected:
     bool mPreviewing = false;
     bool mRenderingPreview = false;
     bool mRenderingOutput = false;
+    bool mHighBitDepth = false;
 
     bool mSceneFrameOutdated = false;
     UseSharedPointer<SceneFrameContainer> mSceneFrame;
     UseSharedPointer<SceneFrameContainer> mLoadingSceneFrame;
 
+    QByteArray mContentHash;
+
     bool mClipToCanvasSize = false;
     bool mRasterEffectsVisible = true;
     bool mPathEffectsVisible = true;
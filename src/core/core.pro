@@ -22,7 +22,7 @@
 
 # VERSION = 0.0.0
 
-QT += opengl multimedia qml xml svg
+QT += opengl multimedia qml xml svg concurrent
 LIBS += -lavutil -lavformat -lavcodec -lswscale -lswresample
 CONFIG += c++14
 TARGET = envecore
@@ -97,6 +97,7 @@ SOURCES += \
     Boxes/internallinkgroupbox.cpp \
     Boxes/layerboxrenderdata.cpp \
     Boxes/linkcanvasrenderdata.cpp \
+    Boxes/linkrasterinstances.cpp \
     Boxes/paintbox.cpp \
     Boxes/pathbox.cpp \
     Boxes/pathboxrenderdata.cpp \
@@ -114,6 +115,7 @@ SOURCES += \
     CacheHandlers/hddcachablerangecont.cpp \
     CacheHandlers/imagecachecontainer.cpp \
     CacheHandlers/imagedatahandler.cpp \
+    CacheHandlers/persistentframecache.cpp \
     CacheHandlers/samples.cpp \
     CacheHandlers/sceneframecontainer.cpp \
     CacheHandlers/soundcachecontainer.cpp \
@@ -164,6 +166,7 @@ SOURCES += \
     Paint/drawableautotiledsurface.cpp \
     Paint/externalpaintapphandler.cpp \
     Paint/onionskin.cpp \
+    Paint/paintstrokeworker.cpp \
     Paint/painttarget.cpp \
     Paint/simplebrushwrapper.cpp \
     Paint/tile.cpp \
@@ -176,6 +179,7 @@ SOURCES += \
     PathEffects/linespatheffect.cpp \
     PathEffects/patheffectcaller.cpp \
     PathEffects/patheffectcollection.cpp \
+    PathEffects/patheffectscache.cpp \
     PathEffects/patheffectstask.cpp \
     PathEffects/solidifypatheffect.cpp \
     PathEffects/spatialdisplacepatheffect.cpp \
@@ -206,6 +210,7 @@ SOURCES += \
     RasterEffects/blureffect.cpp \
     RasterEffects/brightnesscontrasteffect.cpp \
     RasterEffects/colorizeeffect.cpp \
+    RasterEffects/cpublur.cpp \
     RasterEffects/customrastereffect.cpp \
     RasterEffects/motionblureffect.cpp \
     RasterEffects/noisefadeeffect.cpp \
@@ -223,6 +228,7 @@ SOURCES += \
     ReadWrite/filefooter.cpp \
     Segments/fitcurves.cpp \
     Segments/smoothcurves.cpp \
+    ShaderEffects/shadercpuprogram.cpp \
     ShaderEffects/shadereffect.cpp \
     ShaderEffects/shadereffectcaller.cpp \
     ShaderEffects/shadereffectcreator.cpp \
@@ -236,6 +242,7 @@ SOURCES += \
     Sound/esoundobjectbase.cpp \
     Sound/esoundsettings.cpp \
     Sound/evideosound.cpp \
+    Sound/audiochunkqueue.cpp \
     Sound/soundcomposition.cpp \
     Sound/soundmerger.cpp \
     Tasks/domeletask.cpp \
@@ -272,6 +279,7 @@ SOURCES += \
     conncontext.cpp \
     cpurendertools.cpp \
     customidentifier.cpp \
+    diskcachehandler.cpp \
     drawpath.cpp \
     eevent.cpp \
     efiltersettings.cpp \
@@ -287,9 +295,11 @@ SOURCES += \
     namefixer.cpp \
     paintsettings.cpp \
     paintsettingsapplier.cpp \
+    parallelfor.cpp \
     pathoperations.cpp \
     randomgrid.cpp \
     simpletask.cpp \
+    smartPointers/epool.cpp \
     smartPointers/stdpointer.cpp \
     smartPointers/stdselfref.cpp \
     singlewidgettarget.cpp \
@@ -326,6 +336,7 @@ SOURCES += \
     Segments/conicsegment.cpp \
     Segments/cubiclist.cpp \
     Segments/cubicnode.cpp \
+    Segments/arclengthtable.cpp \
     Segments/qcubicsegment2d.cpp \
     Segments/qcubicsegment1d.cpp \
     Animators/animatort.cpp \
@@ -423,6 +434,7 @@ HEADERS += \
     Boxes/internallinkgroupbox.h \
     Boxes/layerboxrenderdata.h \
     Boxes/linkcanvasrenderdata.h \
+    Boxes/linkrasterinstances.h \
     Boxes/paintbox.h \
     Boxes/pathbox.h \
     Boxes/pathboxrenderdata.h \
@@ -440,6 +452,7 @@ HEADERS += \
     CacheHandlers/hddcachablerangecont.h \
     CacheHandlers/imagecachecontainer.h \
     CacheHandlers/imagedatahandler.h \
+    CacheHandlers/persistentframecache.h \
     CacheHandlers/samples.h \
     CacheHandlers/sceneframecontainer.h \
     CacheHandlers/soundcachecontainer.h \
@@ -492,6 +505,7 @@ HEADERS += \
     Paint/drawableautotiledsurface.h \
     Paint/externalpaintapphandler.h \
     Paint/onionskin.h \
+    Paint/paintstrokeworker.h \
     Paint/painttarget.h \
     Paint/simplebrushwrapper.h \
     Paint/tile.h \
@@ -506,6 +520,7 @@ HEADERS += \
     PathEffects/patheffectcaller.h \
     PathEffects/patheffectcollection.h \
     PathEffects/patheffectsinclude.h \
+    PathEffects/patheffectscache.h \
     PathEffects/patheffectstask.h \
     PathEffects/solidifypatheffect.h \
     PathEffects/spatialdisplacepatheffect.h \
@@ -539,6 +554,7 @@ HEADERS += \
     RasterEffects/blureffect.h \
     RasterEffects/brightnesscontrasteffect.h \
     RasterEffects/colorizeeffect.h \
+    RasterEffects/cpublur.h \
     RasterEffects/customrastereffect.h \
     RasterEffects/motionblureffect.h \
     RasterEffects/noisefadeeffect.h \
@@ -566,6 +582,7 @@ HEADERS += \
     ShaderEffects/PropertyCreators/qpointfanimatorcreator.h \
     ShaderEffects/PropertyCreators/qrealanimatorcreator.h \
     ShaderEffects/PropertyCreators/shaderpropertycreator.h \
+    ShaderEffects/shadercpuprogram.h \
     ShaderEffects/shadereffect.h \
     ShaderEffects/shadereffectcaller.h \
     ShaderEffects/shadereffectcreator.h \
@@ -579,6 +596,7 @@ HEADERS += \
     Sound/esoundobjectbase.h \
     Sound/esoundsettings.h \
     Sound/evideosound.h \
+    Sound/audiochunkqueue.h \
     Sound/soundcomposition.h \
     Sound/soundmerger.h \
     Tasks/domeletask.h \
@@ -615,6 +633,7 @@ HEADERS += \
     cpurendertools.h \
     customhandler.h \
     customidentifier.h \
+    diskcachehandler.h \
     drawpath.h \
     eevent.h \
     efiltersettings.h \
@@ -632,6 +651,7 @@ HEADERS += \
     namefixer.h \
     paintsettings.h \
     paintsettingsapplier.h \
+    parallelfor.h \
     pathoperations.h \
     randomgrid.h \
     rangemap.h \
@@ -639,6 +659,7 @@ HEADERS += \
     simpletask.h \
     smartPointers/ememory.h \
     smartPointers/eobject.h \
+    smartPointers/epool.h \
     smartPointers/stdpointer.h \
     smartPointers/selfref.h \
     smartPointers/stdselfref.h \
@@ -678,6 +699,7 @@ HEADERS += \
     Segments/conicsegment.h \
     Segments/cubiclist.h \
     Segments/cubicnode.h \
+    Segments/arclengthtable.h \
     Segments/qcubicsegment2d.h \
     Segments/qcubicsegment1d.h \
     Animators/animatort.h \
@@ -21,6 +21,8 @@
 struct CORE_EXPORT CpuRenderTools {
     const SkBitmap fSrcBtmp;
     SkBitmap fDstBtmp;
+    //! @brief Source of the first pass, valid for all passes
+    const SkBitmap fBaseBtmp;
 };
 
 #endif // CPURENDERTOOLS_H
@@ -0,0 +1,84 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "diskcachehandler.h"
+#include "CacheHandlers/hddcachablecont.h"
+#include "Private/esettings.h"
+
+#include <QDir>
+
+DiskCacheHandler *DiskCacheHandler::sInstance = nullptr;
+
+DiskCacheHandler::DiskCacheHandler() {
+    Q_ASSERT(!sInstance);
+    sInstance = this;
+}
+
+DiskCacheHandler::~DiskCacheHandler() {
+    sInstance = nullptr;
+}
+
+QString DiskCacheHandler::sTmpFileTemplate() {
+    const auto& folder = eSettings::instance().fHddCacheFolder;
+    if(folder.isEmpty()) return QString();
+    const QDir dir(folder);
+    if(!dir.exists() && !QDir().mkpath(folder)) return QString();
+    return dir.filePath("enve_cache_XXXXXX");
+}
+
+int DiskCacheHandler::indexOf(HddCachableCont * const cont) const {
+    for(int i = 0; i < mContainers.count(); i++) {
+        if(mContainers.at(i).fCont == cont) return i;
+    }
+    return -1;
+}
+
+void DiskCacheHandler::addContainer(HddCachableCont * const cont,
+                                    const qint64 bytes) {
+    removeContainer(cont);
+    mContainers.append({cont, bytes});
+    mUsedBytes += bytes;
+    applyCap();
+}
+
+void DiskCacheHandler::removeContainer(HddCachableCont * const cont) {
+    const int id = indexOf(cont);
+    if(id == -1) return;
+    mUsedBytes -= mContainers.takeAt(id).fBytes;
+}
+
+void DiskCacheHandler::containerUsed(HddCachableCont * const cont) {
+    const int id = indexOf(cont);
+    if(id == -1) return;
+    mContainers.append(mContainers.takeAt(id));
+}
+
+void DiskCacheHandler::applyCap() {
+    const qint64 capMB = eSettings::instance().fHddCacheMBCap.fValue;
+    if(capMB <= 0) return;
+    const qint64 capBytes = capMB*1024*1024;
+    // the most recently added file is last and never dropped here
+    for(int i = 0; i < mContainers.count() - 1;) {
+        if(mUsedBytes <= capBytes) return;
+        const auto cont = mContainers.at(i).fCont;
+        if(!cont->tmpFileDroppable()) {
+            i++;
+            continue;
+        }
+        // removes cont from mContainers
+        cont->dropTmpFile();
+    }
+}
@@ -0,0 +1,57 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef DISKCACHEHANDLER_H
+#define DISKCACHEHANDLER_H
+#include <QList>
+#include <QString>
+
+#include "core_global.h"
+
+class HddCachableCont;
+
+//! @brief Accounts for tmp files of HddCachableCont and keeps them
+//! within eSettings::fHddCacheMBCap, dropping the coldest ones first.
+class CORE_EXPORT DiskCacheHandler {
+public:
+    DiskCacheHandler();
+    ~DiskCacheHandler();
+
+    static DiskCacheHandler *sInstance;
+
+    //! @brief File template in eSettings::fHddCacheFolder,
+    //! empty for the system temporary folder
+    static QString sTmpFileTemplate();
+
+    void addContainer(HddCachableCont * const cont, const qint64 bytes);
+    void removeContainer(HddCachableCont * const cont);
+    void containerUsed(HddCachableCont * const cont);
+
+    qint64 usedBytes() const { return mUsedBytes; }
+private:
+    struct Entry {
+        HddCachableCont* fCont;
+        qint64 fBytes;
+    };
+
+    int indexOf(HddCachableCont * const cont) const;
+    void applyCap();
+
+    QList<Entry> mContainers;
+    qint64 mUsedBytes = 0;
+};
+
+#endif // DISKCACHEHANDLER_H
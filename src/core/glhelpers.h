@@ -65,6 +65,9 @@ struct CORE_EXPORT CpuRenderData {
     //! @brief Texture size
     uint fWidth;
     uint fHeight;
+
+    //! @brief Current pass, see RasterEffectCaller::cpuPasses
+    int fPass = 0;
 };
 
 #endif // GLHELPERS_H
@@ -34,7 +34,13 @@ public:
 
     bool isEmpty() const { return mContainers.isEmpty(); }
     CacheContainer* takeFirst();
+
+    //! @brief Whether evicted containers may keep a compressed copy
+    bool compressEvicted() const { return mCompressEvicted; }
+    void setCompressEvicted(const bool compress)
+    { mCompressEvicted = compress; }
 private:
+    bool mCompressEvicted = true;
     QList<CacheContainer*> mContainers;
 };
 
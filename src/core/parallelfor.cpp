@@ -0,0 +1,53 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "parallelfor.h"
+
+#include <QThread>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+void ParallelFor::run(const int count, const Func& func,
+                      const int minPerThread) {
+    const int nThreads = qMin(QThread::idealThreadCount(),
+                              count/qMax(1, minPerThread));
+    if(nThreads <= 1) {
+        for(int i = 0; i < count; i++) func(i);
+        return;
+    }
+    std::atomic<int> next{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    const auto worker = [&]() {
+        for(int i = next++; i < count; i = next++) {
+            try {
+                func(i);
+            } catch(...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if(!error) error = std::current_exception();
+                next = count;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int i = 1; i < nThreads; i++) threads.emplace_back(worker);
+    worker();
+    for(auto& thread : threads) thread.join();
+    if(error) std::rethrow_exception(error);
+}
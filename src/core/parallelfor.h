@@ -0,0 +1,35 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include "core_global.h"
+
+#include <functional>
+
+namespace ParallelFor {
+    using Func = std::function<void(const int i)>;
+    //! @brief Calls func for every index in [0, count) on up to
+    //! idealThreadCount threads, blocks until all are done.
+    //! Each thread gets at least minPerThread indices.
+    //! The first exception thrown by func is rethrown.
+    CORE_EXPORT
+    void run(const int count, const Func& func,
+             const int minPerThread = 1);
+}
+
+#endif // PARALLELFOR_H
@@ -16,6 +16,7 @@
 
 #include "pointhelpers.h"
 #include "exceptions.h"
+#include "Segments/arclengthtable.h"
 
 #include <QtMath>
 #include <complex>
@@ -650,8 +651,10 @@ SkPath gPathToPolyline(const SkPath& path) {
             return result;
         }
         if(!seg.isLine()) {
-            for(qreal len = 10; len < seg.length(); len += 10) {
-                result.lineTo(toSkPoint(seg.posAtLength(len)));
+            const ArcLengthTable table({seg});
+            const qreal segLen = table.totalLength();
+            for(qreal len = 10; len < segLen; len += 10) {
+                result.lineTo(toSkPoint(table.posAtLength(len)));
             }
         }
         result.lineTo(toSkPoint(seg.p3()));
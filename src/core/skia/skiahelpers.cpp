@@ -76,11 +76,13 @@ void SkiaHelpers::writeImg(const sk_sp<SkImage> &img,
             RuntimeThrow("Could not peek image pixels");
         }
     }
+    dst << static_cast<int>(pix.colorType());
     writePixmap(pix, dst);
 }
 
 sk_sp<SkImage> SkiaHelpers::readImg(eReadStream &src) {
-    auto btmp = readBitmap(src);
+    int colorType; src >> colorType;
+    auto btmp = readBitmap(src, static_cast<SkColorType>(colorType));
     return SkiaHelpers::transferDataToSkImage(btmp);
 }
 
@@ -90,19 +92,21 @@ void SkiaHelpers::writePixmap(const SkPixmap &pix,
     const int height = pix.height();
     dst << width;
     dst << height;
-    const qint64 writeBytes = width*height*4*
+    const qint64 writeBytes = width*height*pix.info().bytesPerPixel()*
             static_cast<qint64>(sizeof(uchar));
     dst.write(pix.addr(), writeBytes);
 }
 
-SkBitmap SkiaHelpers::readBitmap(eReadStream &src) {
+SkBitmap SkiaHelpers::readBitmap(eReadStream &src,
+                                 const SkColorType colorType) {
     int width, height;
     src >> width;
     src >> height;
     SkBitmap btmp;
-    const auto info = SkiaHelpers::getPremulRGBAInfo(width, height);
+    const auto info = SkiaHelpers::getPremulRGBAInfo(
+                width, height).makeColorType(colorType);
     btmp.allocPixels(info);
-    const qint64 readBytes = width*height*4*
+    const qint64 readBytes = width*height*info.bytesPerPixel()*
             static_cast<qint64>(sizeof(uchar));
     src.read(btmp.getPixels(), readBytes);
     return btmp;
@@ -46,7 +46,8 @@ namespace SkiaHelpers {
     sk_sp<SkImage> readImg(eReadStream& src);
 
     CORE_EXPORT
-    SkBitmap readBitmap(eReadStream &src);
+    SkBitmap readBitmap(eReadStream &src,
+                        const SkColorType colorType = kRGBA_8888_SkColorType);
     CORE_EXPORT
     void writeBitmap(const SkBitmap& bitmap, eWriteStream &dst);
 
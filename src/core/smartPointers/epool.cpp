@@ -0,0 +1,167 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "epool.h"
+
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#define POOL_GRANULARITY 16
+#define POOL_SIZE_CLASSES 32
+#define POOL_THREAD_CAP 256
+#define POOL_SHARED_CAP 4096
+#define POOL_BATCH 32
+
+struct FreeBlock {
+    FreeBlock* fNext;
+};
+
+struct FreeList {
+    FreeBlock* fHead = nullptr;
+    int fCount = 0;
+
+    void push(void* const ptr) {
+        const auto block = static_cast<FreeBlock*>(ptr);
+        block->fNext = fHead;
+        fHead = block;
+        fCount++;
+    }
+
+    void* pop() {
+        const auto block = fHead;
+        if(!block) return nullptr;
+        fHead = block->fNext;
+        fCount--;
+        return block;
+    }
+};
+
+struct SharedLists {
+    std::mutex fMutex;
+    FreeList fLists[POOL_SIZE_CLASSES];
+};
+
+// never destroyed, blocks can still be released during static destruction
+static SharedLists& sharedLists() {
+    static const auto lists = new SharedLists;
+    return *lists;
+}
+
+static size_t blockSize(const int sizeClass) {
+    return static_cast<size_t>((sizeClass + 1)*POOL_GRANULARITY);
+}
+
+static int sizeClass(const size_t size) {
+    if(size == 0) return 0;
+    return static_cast<int>((size - 1)/POOL_GRANULARITY);
+}
+
+static void releaseToShared(FreeList& src, const int sizeClass,
+                            const int count) {
+    auto& shared = sharedLists();
+    std::lock_guard<std::mutex> lock(shared.fMutex);
+    auto& dst = shared.fLists[sizeClass];
+    for(int i = 0; i < count; i++) {
+        const auto block = src.pop();
+        if(!block) break;
+        if(dst.fCount < POOL_SHARED_CAP) dst.push(block);
+        else std::free(block);
+    }
+}
+
+static void takeFromShared(FreeList& dst, const int sizeClass) {
+    auto& shared = sharedLists();
+    std::lock_guard<std::mutex> lock(shared.fMutex);
+    auto& src = shared.fLists[sizeClass];
+    for(int i = 0; i < POOL_BATCH; i++) {
+        const auto block = src.pop();
+        if(!block) break;
+        dst.push(block);
+    }
+}
+
+class ThreadLists;
+static thread_local ThreadLists* tThreadLists = nullptr;
+
+class ThreadLists {
+public:
+    ThreadLists() { tThreadLists = this; }
+    ~ThreadLists() {
+        tThreadLists = nullptr;
+        for(int i = 0; i < POOL_SIZE_CLASSES; i++) {
+            releaseToShared(fLists[i], i, fLists[i].fCount);
+        }
+    }
+
+    FreeList fLists[POOL_SIZE_CLASSES];
+};
+
+// null once the thread's lists are destroyed at thread exit
+static ThreadLists* threadLists() {
+    static thread_local ThreadLists lists;
+    return tThreadLists;
+}
+
+void* ePool::sAllocate(const size_t size) {
+    const int id = sizeClass(size);
+    if(id >= POOL_SIZE_CLASSES) {
+        const auto ptr = std::malloc(size);
+        if(!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+    const auto lists = threadLists();
+    if(lists) {
+        auto& list = lists->fLists[id];
+        if(!list.fHead) takeFromShared(list, id);
+        const auto ptr = list.pop();
+        if(ptr) return ptr;
+    }
+    const auto ptr = std::malloc(blockSize(id));
+    if(!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void ePool::sDeallocate(void* const ptr, const size_t size) {
+    if(!ptr) return;
+    const int id = sizeClass(size);
+    if(id >= POOL_SIZE_CLASSES) return std::free(ptr);
+    const auto lists = threadLists();
+    if(!lists) {
+        FreeList list;
+        list.push(ptr);
+        return releaseToShared(list, id, 1);
+    }
+    auto& list = lists->fLists[id];
+    list.push(ptr);
+    if(list.fCount > POOL_THREAD_CAP) {
+        releaseToShared(list, id, POOL_THREAD_CAP/2);
+    }
+}
+
+qint64 ePool::sTrim() {
+    qint64 freed = 0;
+    auto& shared = sharedLists();
+    std::lock_guard<std::mutex> lock(shared.fMutex);
+    for(int i = 0; i < POOL_SIZE_CLASSES; i++) {
+        auto& list = shared.fLists[i];
+        while(const auto block = list.pop()) {
+            std::free(block);
+            freed += blockSize(i);
+        }
+    }
+    return freed;
+}
@@ -0,0 +1,62 @@
+// enve - 2D animations software
+// Copyright (C) 2016-2020 Maurycy Liebner
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EPOOL_H
+#define EPOOL_H
+#include <cstddef>
+
+#include "../core_global.h"
+
+//! @brief Free lists of small blocks grouped by size, cached per thread.
+//! Render data and tasks are created and released every frame,
+//! the pool lets them reuse blocks instead of going through malloc.
+class CORE_EXPORT ePool {
+public:
+    static void* sAllocate(const size_t size);
+    static void sDeallocate(void* const ptr, const size_t size);
+
+    //! @brief Frees blocks kept in the shared free lists,
+    //! returns the number of bytes freed
+    static qint64 sTrim();
+};
+
+template <class T>
+class ePoolAllocator {
+public:
+    using value_type = T;
+
+    ePoolAllocator() = default;
+    template <class U>
+    ePoolAllocator(const ePoolAllocator<U>&) {}
+
+    T* allocate(const size_t n) {
+        return static_cast<T*>(ePool::sAllocate(n*sizeof(T)));
+    }
+
+    void deallocate(T* const ptr, const size_t n) {
+        ePool::sDeallocate(ptr, n*sizeof(T));
+    }
+};
+
+template <class T, class U>
+bool operator==(const ePoolAllocator<T>&, const ePoolAllocator<U>&)
+{ return true; }
+
+template <class T, class U>
+bool operator!=(const ePoolAllocator<T>&, const ePoolAllocator<U>&)
+{ return false; }
+
+#endif // EPOOL_H
@@ -20,6 +20,7 @@
 #include <memory>
 #include "../exceptions.h"
 #include "eobject.h"
+#include "epool.h"
 
 template <class T> class StdPointer;
 template <class T> using stdsptr = std::shared_ptr<T>;
@@ -31,9 +32,21 @@ class CORE_EXPORT StdSelfRef {
 public:
     virtual ~StdSelfRef();
 
+    //! @brief Both the object and its reference counts are pooled,
+    //! see ePool
     template <class T, typename... Args>
     static inline std::shared_ptr<T> sCreate(Args && ...args) {
-        return (new T(std::forward<Args>(args)...))->template iniRef<T>();
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "Over-aligned types cannot be pooled");
+        const auto mem = ePool::sAllocate(sizeof(T));
+        T* obj;
+        try {
+            obj = ::new (mem) T(std::forward<Args>(args)...);
+        } catch(...) {
+            ePool::sDeallocate(mem, sizeof(T));
+            throw;
+        }
+        return obj->template iniRef<T>();
     }
 
     template<class T>
@@ -51,10 +64,19 @@ private:
     template<class T>
     std::shared_ptr<T> iniRef() {
         if(!mThisWeak.expired()) RuntimeThrow("Shared pointer reinitialization");
-        std::shared_ptr<T> thisRef = std::shared_ptr<T>(static_cast<T*>(this));
+        std::shared_ptr<T> thisRef(static_cast<T*>(this), PoolDeleter<T>(),
+                                   ePoolAllocator<T>());
         this->mThisWeak = std::static_pointer_cast<StdSelfRef>(thisRef);
         return thisRef;
     }
+
+    template<class T>
+    struct PoolDeleter {
+        void operator()(T* const obj) const {
+            obj->~T();
+            ePool::sDeallocate(obj, sizeof(T));
+        }
+    };
 private:
     std::weak_ptr<StdSelfRef> mThisWeak;
 };
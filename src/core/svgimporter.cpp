@@ -17,8 +17,10 @@
 #include "svgimporter.h"
 
 #include <QtXml/QDomDocument>
+#include <QXmlStreamReader>
 
 #include "Boxes/containerbox.h"
+#include "parallelfor.h"
 #include "colorhelpers.h"
 #include "pointhelpers.h"
 #include "Boxes/circle.h"
@@ -37,6 +39,26 @@
 
 #define RGXS REGEX_SPACES
 
+//! @brief Tag name and attributes of the element the reader is at
+class SvgElement {
+public:
+    SvgElement(const QXmlStreamReader& reader) :
+        fTagName(reader.qualifiedName().toString()),
+        mAttributes(reader.attributes()) {}
+
+    QString attribute(const QString& name,
+                      const QString& def = QString()) const {
+        for(const auto& attr : mAttributes) {
+            if(attr.qualifiedName() == name) return attr.value().toString();
+        }
+        return def;
+    }
+
+    const QString fTagName;
+private:
+    const QXmlStreamAttributes mAttributes;
+};
+
 class TextSvgAttributes {
 public:
     TextSvgAttributes() {}
@@ -143,7 +165,7 @@ public:
     const StrokeSvgAttributes &getStrokeAttributes() const;
     const TextSvgAttributes &getTextAttributes() const;
 
-    void loadBoundingBoxAttributes(const QDomElement &element);
+    void loadBoundingBoxAttributes(const SvgElement &element);
 
     bool hasTransform() const;
 
@@ -399,64 +421,8 @@ bool parsePolylineData(const QString &dataStr,
     return true;
 }
 
-void loadElement(const QDomElement &element, ContainerBox *parentGroup,
-                 const BoxSvgAttributes &parentGroupAttributes,
-                 const GradientCreator& gradientCreator);
-
-qsptr<ContainerBox> loadBoxesGroup(const QDomElement &groupElement,
-                                   ContainerBox *parentGroup,
-                                   const BoxSvgAttributes &attributes,
-                                   const GradientCreator& gradientCreator) {
-    const QDomNodeList allRootChildNodes = groupElement.childNodes();
-    qsptr<ContainerBox> boxesGroup;
-    const bool hasTransform = attributes.hasTransform();
-    if(allRootChildNodes.count() > 1 || hasTransform || !parentGroup) {
-        boxesGroup = enve::make_shared<ContainerBox>(eBoxType::group);
-        boxesGroup->planCenterPivotPosition();
-        attributes.apply(boxesGroup.get());
-        if(parentGroup) parentGroup->addContained(boxesGroup);
-    } else {
-        boxesGroup = parentGroup->ref<ContainerBox>();
-    }
-
-    for(int i = 0; i < allRootChildNodes.count(); i++) {
-        const QDomNode iNode = allRootChildNodes.at(i);
-        if(iNode.isElement()) {
-            loadElement(iNode.toElement(), boxesGroup.get(),
-                        attributes, gradientCreator);
-        }
-    }
-    return boxesGroup;
-}
-
-void loadVectorPath(const QDomElement &pathElement,
-                    ContainerBox *parentGroup,
-                    VectorPathSvgAttributes& attributes) {
-    const QString pathStr = pathElement.attribute("d");
-    SkParsePath::FromSVGString(pathStr.toStdString().data(), &attributes.path());
-    if(attributes.isEmpty()) return;
-    const auto vectorPath = enve::make_shared<SmartVectorPath>();
-    vectorPath->planCenterPivotPosition();
-    attributes.apply(vectorPath.get());
-    parentGroup->addContained(vectorPath);
-}
-
-void loadPolyline(const QDomElement &pathElement,
-                  ContainerBox *parentGroup,
-                  VectorPathSvgAttributes &attributes,
-                  const bool isPolygon) {
-    const QString pathStr = pathElement.attribute("points");
-    parsePolylineData(pathStr, attributes, isPolygon);
-    if(attributes.isEmpty()) return;
-    const auto vectorPath = enve::make_shared<SmartVectorPath>();
-    vectorPath->planCenterPivotPosition();
-    attributes.apply(vectorPath.get());
-    parentGroup->addContained(vectorPath);
-}
-
-void loadCircle(const QDomElement &pathElement,
-                ContainerBox *parentGroup,
-                const BoxSvgAttributes &attributes) {
+qsptr<Circle> loadCircle(const SvgElement &pathElement,
+                         const BoxSvgAttributes &attributes) {
 
     const QString cXstr = pathElement.attribute("cx");
     const QString cYstr = pathElement.attribute("cy");
@@ -476,8 +442,8 @@ void loadCircle(const QDomElement &pathElement,
         const qreal rXY = rXstr.isEmpty() ? rYstr.toDouble() : rXstr.toDouble();
         rX = rXY;
         rY = rXY;
-    } else return;
-    if(isZero4Dec(rX) || isZero4Dec(rY)) return;
+    } else return nullptr;
+    if(isZero4Dec(rX) || isZero4Dec(rY)) return nullptr;
     circle = enve::make_shared<Circle>();
     circle->setHorizontalRadius(rX);
     circle->setVerticalRadius(rY);
@@ -485,12 +451,11 @@ void loadCircle(const QDomElement &pathElement,
     circle->planCenterPivotPosition();
 
     attributes.apply(circle.data());
-    parentGroup->addContained(circle);
+    return circle;
 }
 
-void loadRect(const QDomElement &pathElement,
-              ContainerBox *parentGroup,
-              const BoxSvgAttributes &attributes) {
+qsptr<RectangleBox> loadRect(const SvgElement &pathElement,
+                             const BoxSvgAttributes &attributes) {
 
     const QString xStr = pathElement.attribute("x");
     const QString yStr = pathElement.attribute("y");
@@ -517,12 +482,12 @@ void loadRect(const QDomElement &pathElement,
     }
 
     attributes.apply(rect.data());
-    parentGroup->addContained(rect);
+    return rect;
 }
 
-void loadText(const QDomElement &pathElement,
-              ContainerBox *parentGroup,
-              const BoxSvgAttributes &attributes) {
+qsptr<TextBox> loadText(const SvgElement &pathElement,
+                        const QString& text,
+                        const BoxSvgAttributes &attributes) {
 
     const QString xStr = pathElement.attribute("x");
     const QString yStr = pathElement.attribute("y");
@@ -531,12 +496,38 @@ void loadText(const QDomElement &pathElement,
     textBox->planCenterPivotPosition();
 
     textBox->moveByRel(QPointF(xStr.toDouble(), yStr.toDouble()));
-    textBox->setCurrentValue(pathElement.text());
+    textBox->setCurrentValue(text);
 
     attributes.apply(textBox.data());
-    parentGroup->addContained(textBox);
+    return textBox;
 }
 
+//! @brief Path element whose data is parsed later, in batches
+struct SvgPathJob {
+    enum class Type { path, polyline, polygon };
+
+    void parse() {
+        if(fType == Type::path) {
+            const auto data = fData.toStdString();
+            SkParsePath::FromSVGString(data.data(), &fAttributes.path());
+        } else {
+            parsePolylineData(fData, fAttributes, fType == Type::polygon);
+        }
+        fData = QString();
+    }
+
+    Type fType;
+    QString fData;
+    VectorPathSvgAttributes fAttributes;
+};
+
+//! @brief Child of a group being loaded, either a finished box
+//! or a path waiting for its data to be parsed
+struct SvgItem {
+    qsptr<eBoxOrSound> fBox;
+    stdsptr<SvgPathJob> fPath;
+};
+
 bool extractTranslation(const QString& str, QMatrix& target) {
     const QRegExp rx1(RGXS "translate\\(" REGEX_SINGLE_FLOAT "\\)" RGXS,
                       Qt::CaseInsensitive);
@@ -636,161 +627,292 @@ QMatrix getMatrixFromString(const QString &str) {
 static QMap<QString, SvgGradient> gGradients;
 //            to       from
 static QMap<QString, QStringList> gUnresolvedGradientLinks;
-void loadElement(const QDomElement &element, ContainerBox *parentGroup,
-                 const BoxSvgAttributes &parentGroupAttributes,
-                 const GradientCreator& gradientCreator) {
-    const QString tagName = element.tagName();
-    if(tagName == "defs") {
-        const QDomNodeList allRootChildNodes = element.childNodes();
-        for(int i = 0; i < allRootChildNodes.count(); i++) {
-            const QDomNode iNode = allRootChildNodes.at(i);
-            if(iNode.isElement()) {
-                loadElement(iNode.toElement(), parentGroup,
-                            parentGroupAttributes, gradientCreator);
-            }
-        }
-        return;
-    } else if(tagName == "linearGradient" || tagName == "radialGradient") {
-        GradientType type;
-        if(tagName == "linearGradient") {
-            type = GradientType::LINEAR;
-        } else { //if(tagName == "radialGradient") {
-            type = GradientType::RADIAL;
-        }
-        const QString id = element.attribute("id");
-        QString linkId = element.attribute("xlink:href");
-        Gradient* gradient = nullptr;
-        if(linkId.isEmpty()) {
-            gradient = gradientCreator();
-            const QDomNodeList allRootChildNodes = element.childNodes();
-            for(int i = 0; i < allRootChildNodes.count(); i++) {
-                const QDomNode iNode = allRootChildNodes.at(i);
-                if(!iNode.isElement()) continue;
-                const QDomElement elem = iNode.toElement();
-                if(elem.tagName() != "stop") continue;
-                QString stopColorS;
-                QString stopOpacityS;
-                const QString stopStyle = elem.attribute("style");
-                QList<SvgAttribute> attributesList;
-                extractSvgAttributes(stopStyle, &attributesList);
-                for(const auto& attr : attributesList) {
-                    if(attr.fName == "stop-color") {
-                        stopColorS = attr.fValue;
-
-                    } else if(attr.fName == "stop-opacity") {
-                        stopOpacityS = attr.fValue;
-                    }
-                }
-                if(stopColorS.isEmpty()) {
-                    stopColorS = elem.attribute("stop-color");
-                }
-                if(stopOpacityS.isEmpty()) {
-                    stopOpacityS = elem.attribute("stop-opacity");
-                }
-
-                QColor stopColor;
-                toColor(stopColorS, stopColor);
-                if(!stopOpacityS.isEmpty()) {
-                    stopColor.setAlphaF(toDouble(stopOpacityS));
+void loadGradient(const SvgElement &element, QXmlStreamReader& reader,
+                  const GradientCreator& gradientCreator) {
+    const QString tagName = element.fTagName;
+    GradientType type;
+    if(tagName == "linearGradient") {
+        type = GradientType::LINEAR;
+    } else { //if(tagName == "radialGradient") {
+        type = GradientType::RADIAL;
+    }
+    const QString id = element.attribute("id");
+    QString linkId = element.attribute("xlink:href");
+    Gradient* gradient = nullptr;
+    if(linkId.isEmpty()) {
+        gradient = gradientCreator();
+        while(reader.readNextStartElement()) {
+            const SvgElement elem(reader);
+            reader.skipCurrentElement();
+            if(elem.fTagName != "stop") continue;
+            QString stopColorS;
+            QString stopOpacityS;
+            const QString stopStyle = elem.attribute("style");
+            QList<SvgAttribute> attributesList;
+            extractSvgAttributes(stopStyle, &attributesList);
+            for(const auto& attr : attributesList) {
+                if(attr.fName == "stop-color") {
+                    stopColorS = attr.fValue;
+
+                } else if(attr.fName == "stop-opacity") {
+                    stopOpacityS = attr.fValue;
                 }
-
-                gradient->addColor(stopColor);
             }
-        } else {
-            if(linkId.at(0) == "#") linkId.remove(0, 1);
-            const auto it = gGradients.find(linkId);
-            if(it == gGradients.end()) {
-                gUnresolvedGradientLinks[linkId].append(id);
-                gradient = nullptr;
-            } else {
-                gradient = it.value().fGradient;
+            if(stopColorS.isEmpty()) {
+                stopColorS = elem.attribute("stop-color");
             }
-        }
-        const auto it = gUnresolvedGradientLinks.find(id);
-        if(it != gUnresolvedGradientLinks.end()) {
-            if(gradient) {
-                for(const auto& linking : it.value()) {
-                    auto& grad = gGradients[linking];
-                    grad.fGradient = gradient;
-                    grad.fType = type;
-                }
-            } else {
-                gUnresolvedGradientLinks[linkId] = it.value();
+            if(stopOpacityS.isEmpty()) {
+                stopOpacityS = elem.attribute("stop-opacity");
             }
-        }
 
-        double x1;
-        double x2;
-        double y1;
-        double y2;
-        switch(type) {
-        case GradientType::LINEAR:
-        {
-            const QString x1s = element.attribute("x1");
-            const QString y1s = element.attribute("y1");
-            const QString x2s = element.attribute("x2");
-            const QString y2s = element.attribute("y2");
-
-            x1 = toDouble(x1s);
-            y1 = toDouble(y1s),
-            x2 = toDouble(x2s);
-            y2 = toDouble(y2s);
-            break;
+            QColor stopColor;
+            toColor(stopColorS, stopColor);
+            if(!stopOpacityS.isEmpty()) {
+                stopColor.setAlphaF(toDouble(stopOpacityS));
+            }
+
+            gradient->addColor(stopColor);
         }
-        case GradientType::RADIAL:
-        {
-            const QString cxs = element.attribute("cx");
-            const QString cys = element.attribute("cy");
-            const QString rs = element.attribute("r");
-
-            const double cx = toDouble(cxs);
-            const double cy = toDouble(cys);
-            const double r = toDouble(rs);
-
-            x1 = cx;
-            y1 = cy;
-            x2 = cx + r;
-            y2 = cy + r;
-            break;
+    } else {
+        reader.skipCurrentElement();
+        if(linkId.at(0) == "#") linkId.remove(0, 1);
+        const auto it = gGradients.find(linkId);
+        if(it == gGradients.end()) {
+            gUnresolvedGradientLinks[linkId].append(id);
+            gradient = nullptr;
+        } else {
+            gradient = it.value().fGradient;
         }
+    }
+    const auto it = gUnresolvedGradientLinks.find(id);
+    if(it != gUnresolvedGradientLinks.end()) {
+        if(gradient) {
+            for(const auto& linking : it.value()) {
+                auto& grad = gGradients[linking];
+                grad.fGradient = gradient;
+                grad.fType = type;
+            }
+        } else {
+            gUnresolvedGradientLinks[linkId] = it.value();
         }
+    }
 
-        const QString gradTrans = element.attribute("gradientTransform");
-        const QMatrix trans = getMatrixFromString(gradTrans);
-        gGradients.insert(id, {gradient,
-                               x1, y1,
-                               x2, y2,
-                               trans, type});
+    double x1;
+    double x2;
+    double y1;
+    double y2;
+    switch(type) {
+    case GradientType::LINEAR:
+    {
+        const QString x1s = element.attribute("x1");
+        const QString y1s = element.attribute("y1");
+        const QString x2s = element.attribute("x2");
+        const QString y2s = element.attribute("y2");
+
+        x1 = toDouble(x1s);
+        y1 = toDouble(y1s),
+        x2 = toDouble(x2s);
+        y2 = toDouble(y2s);
+        break;
+    }
+    case GradientType::RADIAL:
+    {
+        const QString cxs = element.attribute("cx");
+        const QString cys = element.attribute("cy");
+        const QString rs = element.attribute("r");
+
+        const double cx = toDouble(cxs);
+        const double cy = toDouble(cys);
+        const double r = toDouble(rs);
+
+        x1 = cx;
+        y1 = cy;
+        x2 = cx + r;
+        y2 = cy + r;
+        break;
+    }
+    }
+
+    const QString gradTrans = element.attribute("gradientTransform");
+    const QMatrix trans = getMatrixFromString(gradTrans);
+    gGradients.insert(id, {gradient,
+                           x1, y1,
+                           x2, y2,
+                           trans, type});
+}
+
+//! @brief Builds boxes while reading the file with QXmlStreamReader.
+//! Path data is collected and parsed in batches on worker threads.
+class SvgStreamLoader {
+public:
+    SvgStreamLoader(QXmlStreamReader& reader,
+                    QIODevice* const device,
+                    const qint64 totalSize,
+                    const GradientCreator& gradientCreator,
+                    const SvgImportProgress& progress) :
+        mReader(reader), mDevice(device), mTotalSize(totalSize),
+        mGradientCreator(gradientCreator), mProgress(progress) {}
+
+    //! @brief Loads the contents of the svg element the reader is at,
+    //! returns nullptr if canceled
+    qsptr<ContainerBox> loadRoot();
+private:
+    int loadChildren(QList<SvgItem>& items,
+                     const BoxSvgAttributes& attributes);
+    void loadElement(QList<SvgItem>& items,
+                     const BoxSvgAttributes& parentAttributes);
+    void loadGroup(QList<SvgItem>& items,
+                   const BoxSvgAttributes& attributes);
+    void queuePath(QList<SvgItem>& items,
+                   const stdsptr<SvgPathJob>& job);
+    void parsePending();
+    void addItems(ContainerBox* const group,
+                  const QList<SvgItem>& items);
+    void reportProgress();
+
+    //! @brief Paths parsed at once, bounds the memory used by path data
+    static const int sBatchSize = 4096;
+    //! @brief Smaller batches are parsed on the calling thread
+    static const int sMinPerThread = 64;
+
+    QXmlStreamReader& mReader;
+    QIODevice* const mDevice;
+    const qint64 mTotalSize;
+    const GradientCreator& mGradientCreator;
+    const SvgImportProgress& mProgress;
+
+    bool mCanceled = false;
+    int mElementCount = 0;
+    QList<stdsptr<SvgPathJob>> mPending;
+};
+
+qsptr<ContainerBox> SvgStreamLoader::loadRoot() {
+    BoxSvgAttributes attributes;
+    QList<SvgItem> items;
+    loadChildren(items, attributes);
+    if(mCanceled) return nullptr;
+    const auto root = enve::make_shared<ContainerBox>(eBoxType::group);
+    root->planCenterPivotPosition();
+    attributes.apply(root.get());
+    addItems(root.get(), items);
+    return root;
+}
+
+int SvgStreamLoader::loadChildren(QList<SvgItem>& items,
+                                  const BoxSvgAttributes& attributes) {
+    int count = 0;
+    while(!mCanceled && mReader.readNextStartElement()) {
+        count++;
+        loadElement(items, attributes);
+    }
+    return count;
+}
+
+void SvgStreamLoader::loadGroup(QList<SvgItem>& items,
+                                const BoxSvgAttributes& attributes) {
+    QList<SvgItem> groupItems;
+    const int nChildren = loadChildren(groupItems, attributes);
+    if(nChildren <= 1 && !attributes.hasTransform()) {
+        // a group is not needed for a single child
+        items.append(groupItems);
+        return;
+    }
+    const auto group = enve::make_shared<ContainerBox>(eBoxType::group);
+    group->planCenterPivotPosition();
+    attributes.apply(group.get());
+    addItems(group.get(), groupItems);
+    if(group->getContainedBoxesCount() == 0) return;
+    items.append({group, nullptr});
+}
+
+void SvgStreamLoader::loadElement(QList<SvgItem>& items,
+                                  const BoxSvgAttributes& parentAttributes) {
+    if(++mElementCount % 256 == 0) reportProgress();
+    const SvgElement element(mReader);
+    const QString& tagName = element.fTagName;
+    if(tagName == "defs") {
+        loadChildren(items, parentAttributes);
+    } else if(tagName == "linearGradient" || tagName == "radialGradient") {
+        loadGradient(element, mReader, mGradientCreator);
     } else if(tagName == "path" || tagName == "polyline" || tagName == "polygon") {
-        VectorPathSvgAttributes attributes;
-        attributes.setParent(parentGroupAttributes);
-        attributes.loadBoundingBoxAttributes(element);
+        const auto job = std::make_shared<SvgPathJob>();
+        job->fAttributes.setParent(parentAttributes);
+        job->fAttributes.loadBoundingBoxAttributes(element);
         if(tagName == "path") {
-            loadVectorPath(element, parentGroup, attributes);
-        } else if(tagName == "polyline") {
-            loadPolyline(element, parentGroup, attributes, false);
-        } else if(tagName == "polygon") {
-            loadPolyline(element, parentGroup, attributes, true);
+            job->fType = SvgPathJob::Type::path;
+            job->fData = element.attribute("d");
+        } else {
+            job->fType = tagName == "polygon" ? SvgPathJob::Type::polygon :
+                                                SvgPathJob::Type::polyline;
+            job->fData = element.attribute("points");
         }
+        mReader.skipCurrentElement();
+        queuePath(items, job);
     } else if(tagName == "g" || tagName == "text" ||
               tagName == "circle" || tagName == "ellipse" ||
               tagName == "rect" || tagName == "tspan") {
         BoxSvgAttributes attributes;
-        attributes.setParent(parentGroupAttributes);
+        attributes.setParent(parentAttributes);
         attributes.loadBoundingBoxAttributes(element);
         if(tagName == "g" || tagName == "text") {
-            const auto group = loadBoxesGroup(element, parentGroup,
-                                              attributes, gradientCreator);
-            if(group->getContainedBoxesCount() == 0)
-                group->removeFromParent_k();
-        } else if(tagName == "circle" || tagName == "ellipse") {
-            loadCircle(element, parentGroup, attributes);
+            loadGroup(items, attributes);
+            return;
+        }
+        qsptr<BoundingBox> box;
+        if(tagName == "circle" || tagName == "ellipse") {
+            box = loadCircle(element, attributes);
         } else if(tagName == "rect") {
-            loadRect(element, parentGroup, attributes);
-        } else if(tagName == "tspan") {
-            loadText(element, parentGroup, attributes);
+            box = loadRect(element, attributes);
         }
-    } else qDebug() << "Unrecognized tagName \"" + tagName + "\"";
+        if(tagName == "tspan") {
+            const auto text = mReader.readElementText(
+                        QXmlStreamReader::IncludeChildElements);
+            box = loadText(element, text, attributes);
+        } else mReader.skipCurrentElement();
+        if(box) items.append({box, nullptr});
+    } else {
+        qDebug() << "Unrecognized tagName \"" + tagName + "\"";
+        mReader.skipCurrentElement();
+    }
+}
+
+void SvgStreamLoader::queuePath(QList<SvgItem>& items,
+                                const stdsptr<SvgPathJob>& job) {
+    items.append({nullptr, job});
+    mPending << job;
+    if(mPending.count() >= sBatchSize) parsePending();
+}
+
+void SvgStreamLoader::parsePending() {
+    const auto& pending = mPending;
+    ParallelFor::run(pending.count(), [&pending](const int i) {
+        pending.at(i)->parse();
+    }, sMinPerThread);
+    mPending.clear();
+}
+
+void SvgStreamLoader::addItems(ContainerBox* const group,
+                               const QList<SvgItem>& items) {
+    if(!mPending.isEmpty()) parsePending();
+    for(const auto& item : items) {
+        if(item.fBox) {
+            group->addContained(item.fBox);
+            continue;
+        }
+        auto& attributes = item.fPath->fAttributes;
+        if(attributes.isEmpty()) continue;
+        const auto vectorPath = enve::make_shared<SmartVectorPath>();
+        vectorPath->planCenterPivotPosition();
+        attributes.apply(vectorPath.get());
+        group->addContained(vectorPath);
+    }
+}
+
+void SvgStreamLoader::reportProgress() {
+    if(!mProgress || mTotalSize <= 0) return;
+    const qint64 pos = mDevice ? mDevice->pos() : mReader.characterOffset();
+    const qreal progress = qBound(0., qreal(pos)/mTotalSize, 1.);
+    if(!mProgress(progress)) mCanceled = true;
 }
 
 bool getUrlId(const QString &urlStr, QString *id) {
@@ -831,14 +953,16 @@ bool getFlatColorFromString(const QString &colorStr, FillSvgAttributes *target)
     return true;
 }
 
-qsptr<BoundingBox> ImportSVG::loadSVGFile(
-        const QDomDocument& src,
-        const GradientCreator& gradientCreator) {
-    const QDomElement rootElement = src.firstChildElement("svg");
-    if(rootElement.isNull()) RuntimeThrow("File does not have svg root element");
-    BoxSvgAttributes attributes;
-    const auto result = loadBoxesGroup(rootElement, nullptr,
-                                       attributes, gradientCreator);
+qsptr<BoundingBox> loadSVGStream(QXmlStreamReader& reader,
+                                 QIODevice* const device,
+                                 const qint64 totalSize,
+                                 const GradientCreator& gradientCreator,
+                                 const SvgImportProgress& progress) {
+    if(!reader.readNextStartElement() || reader.name() != "svg")
+        RuntimeThrow("File does not have svg root element");
+    SvgStreamLoader loader(reader, device, totalSize,
+                           gradientCreator, progress);
+    const auto result = loader.loadRoot();
     gGradients.clear();
     auto it = gUnresolvedGradientLinks.begin();
     while(it != gUnresolvedGradientLinks.end()) {
@@ -847,6 +971,8 @@ qsptr<BoundingBox> ImportSVG::loadSVGFile(
         it++;
     }
     gUnresolvedGradientLinks.clear();
+    if(reader.hasError()) RuntimeThrow(reader.errorString());
+    if(!result) return nullptr;
     if(result->getContainedBoxesCount() == 1) {
         return qSharedPointerCast<BoundingBox>(
                     result->takeContained_k(0));
@@ -857,30 +983,38 @@ qsptr<BoundingBox> ImportSVG::loadSVGFile(
 }
 
 qsptr<BoundingBox> ImportSVG::loadSVGFile(
-        const QByteArray& src,
+        const QDomDocument& src,
         const GradientCreator& gradientCreator) {
-    QDomDocument document;
-    if(!document.setContent(src))
-        RuntimeThrow("Cannot set file as QDomDocument content");
-    return loadSVGFile(document, gradientCreator);
+    return loadSVGFile(src.toByteArray(), gradientCreator);
+}
+
+qsptr<BoundingBox> ImportSVG::loadSVGFile(
+        const QByteArray& src,
+        const GradientCreator& gradientCreator,
+        const SvgImportProgress& progress) {
+    QXmlStreamReader reader(src);
+    return loadSVGStream(reader, nullptr, src.size(),
+                         gradientCreator, progress);
 }
 
 qsptr<BoundingBox> ImportSVG::loadSVGFile(
         QIODevice* const src,
-        const GradientCreator& gradientCreator) {
-    QDomDocument document;
-    if(!document.setContent(src))
-        RuntimeThrow("Cannot set file as QDomDocument content");
-    return loadSVGFile(document, gradientCreator);
+        const GradientCreator& gradientCreator,
+        const SvgImportProgress& progress) {
+    QXmlStreamReader reader(src);
+    const qint64 totalSize = src->isSequential() ? 0 : src->size();
+    return loadSVGStream(reader, src, totalSize,
+                         gradientCreator, progress);
 }
 
 qsptr<BoundingBox> ImportSVG::loadSVGFile(
         const QString &filename,
-        const GradientCreator& gradientCreator) {
+        const GradientCreator& gradientCreator,
+        const SvgImportProgress& progress) {
     QFile file(filename);
     if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
         RuntimeThrow("Cannot open file " + filename);
-    return loadSVGFile(&file, gradientCreator);
+    return loadSVGFile(&file, gradientCreator, progress);
 }
 
 void BoxSvgAttributes::setParent(const BoxSvgAttributes &parent) {
@@ -938,7 +1072,7 @@ QString stripPx(const QString& val) {
     return result;
 }
 
-void BoxSvgAttributes::loadBoundingBoxAttributes(const QDomElement &element) {
+void BoxSvgAttributes::loadBoundingBoxAttributes(const SvgElement &element) {
     QList<SvgAttribute> styleAttributes;
     const QString styleAttributesStr = element.attribute("style");
     extractSvgAttributes(styleAttributesStr, &styleAttributes);
@@ -25,6 +25,8 @@ class Canvas;
 class QDomDocument;
 
 using GradientCreator = std::function<Gradient*()>;
+//! @brief Receives import progress in [0, 1], returning false cancels
+using SvgImportProgress = std::function<bool(const qreal progress)>;
 
 namespace ImportSVG {
     CORE_EXPORT
@@ -32,13 +34,16 @@ namespace ImportSVG {
                                    const GradientCreator& gradientCreator);
     CORE_EXPORT
     qsptr<BoundingBox> loadSVGFile(const QByteArray& src,
-                                   const GradientCreator& gradientCreator);
+                                   const GradientCreator& gradientCreator,
+                                   const SvgImportProgress& progress = nullptr);
     CORE_EXPORT
     qsptr<BoundingBox> loadSVGFile(QIODevice* const src,
-                                   const GradientCreator& gradientCreator);
+                                   const GradientCreator& gradientCreator,
+                                   const SvgImportProgress& progress = nullptr);
     CORE_EXPORT
     qsptr<BoundingBox> loadSVGFile(const QString &filename,
-                                   const GradientCreator& gradientCreator);
+                                   const GradientCreator& gradientCreator,
+                                   const SvgImportProgress& progress = nullptr);
 }
 
 #endif // SVGIMPORTER_H